@@ -5,9 +5,13 @@
 #include <vector>
 
 #include <boost/hana/ext/boost/mpl/vector.hpp>
+#include <boost/hana/integral_constant.hpp>
+#include <boost/hana/not_equal.hpp>
 #include <boost/hana/pair.hpp>
 #include <boost/hana/prepend.hpp>
 #include <boost/hana/second.hpp>
+#include <boost/hana/size.hpp>
+#include <boost/hana/take_while.hpp>
 #include <boost/hana/transform.hpp>
 #include <boost/hana/tuple.hpp>
 #include <boost/hana/zip.hpp>
@@ -70,6 +74,17 @@ static constexpr auto data_types = detail::data_types;
 
 using AllTypeVariant = detail::AllTypeVariant;
 
+namespace detail {
+
+// Returns the index of type T in an Iterable
+template <typename Sequence, typename T>
+constexpr auto index_of(Sequence const& sequence, T const& element) {
+  constexpr auto size = decltype(hana::size(hana::take_while(sequence, hana::not_equal.to(element)))){};
+  return static_cast<size_t>(decltype(size)::value);
+}
+
+}  // namespace detail
+
 /**
  * @defgroup Macros for explicitly instantiating template classes
  *
@@ -0,0 +1,122 @@
+#include "transaction_context.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "storage/mvcc_data.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "transaction_manager.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+TransactionContext::TransactionContext(const TransactionID transaction_id, const CommitID snapshot_commit_id)
+    : _transaction_id(transaction_id), _snapshot_commit_id(snapshot_commit_id) {}
+
+TransactionContext::~TransactionContext() {
+  if (_phase == TransactionPhase::Active || _phase == TransactionPhase::Conflicted) rollback();
+  TransactionManager::get()._end_snapshot(_snapshot_commit_id);
+}
+
+TransactionID TransactionContext::transaction_id() const { return _transaction_id; }
+
+CommitID TransactionContext::snapshot_commit_id() const { return _snapshot_commit_id; }
+
+TransactionPhase TransactionContext::phase() const { return _phase; }
+
+void TransactionContext::insert(const std::shared_ptr<Table>& table, const std::vector<ColumnSpan>& columns) {
+  Assert(_phase == TransactionPhase::Active, "Only active transactions can insert rows");
+  const auto row_ranges = table->append_columns(columns, _transaction_id);
+  _inserted_rows.insert(_inserted_rows.end(), row_ranges.begin(), row_ranges.end());
+}
+
+bool TransactionContext::delete_rows(const std::shared_ptr<const Table>& reference_table) {
+  Assert(_phase == TransactionPhase::Active, "Only active transactions can delete rows");
+  for (auto chunk_id = ChunkID{0}; chunk_id < reference_table->chunk_count(); ++chunk_id) {
+    const auto chunk = reference_table->pin_chunk(chunk_id);
+    if (chunk->size() == 0) continue;
+
+    const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{0}));
+    Assert(reference_segment, "Rows to delete have to be given as a table of ReferenceSegments");
+    const auto& referenced_table = *reference_segment->referenced_table();
+    Assert(referenced_table.uses_mvcc() == UseMvcc::Yes, "Transactions can only delete from tables that use MVCC");
+
+    for (const auto& row_id : *reference_segment->pos_list()) {
+      const auto mvcc_data = referenced_table.pin_chunk(row_id.chunk_id)->mvcc_data();
+      Assert(mvcc_data, "Rows without MVCC columns cannot be deleted");
+      const auto chunk_offset = row_id.chunk_offset;
+
+      auto row_transaction_id = INVALID_TRANSACTION_ID;
+      if (!mvcc_data->tids[chunk_offset].compare_exchange_strong(row_transaction_id, _transaction_id)) {
+        if (row_transaction_id == _transaction_id) {
+          // The row is deleted twice, e.g., because it is referenced twice
+          Assert(mvcc_data->begin_cids[chunk_offset] != MAX_COMMIT_ID, "Transactions cannot delete their own inserts");
+          continue;
+        }
+        _phase = TransactionPhase::Conflicted;
+        return false;
+      }
+
+      // The row is locked now, but it may have been inserted or deleted by a transaction that committed after the
+      // snapshot
+      if (mvcc_data->begin_cids[chunk_offset] > _snapshot_commit_id ||
+          mvcc_data->end_cids[chunk_offset] != MAX_COMMIT_ID) {
+        mvcc_data->tids[chunk_offset] = INVALID_TRANSACTION_ID;
+        _phase = TransactionPhase::Conflicted;
+        return false;
+      }
+      _add_row(_deleted_rows, mvcc_data, chunk_offset);
+    }
+  }
+  return true;
+}
+
+void TransactionContext::commit() {
+  Assert(_phase == TransactionPhase::Active, "Only active transactions can be committed");
+  TransactionManager::get()._commit([&](const CommitID commit_id) {
+    for (const auto& [mvcc_data, begin, end] : _inserted_rows) {
+      for (auto chunk_offset = begin; chunk_offset < end; ++chunk_offset) {
+        mvcc_data->begin_cids[chunk_offset].store(commit_id, std::memory_order_relaxed);
+        // Whoever locks the row afterwards (see ChunkCompactor) sees the begin commit ID
+        mvcc_data->tids[chunk_offset].store(INVALID_TRANSACTION_ID, std::memory_order_release);
+      }
+    }
+    for (const auto& [mvcc_data, begin, end] : _deleted_rows) {
+      for (auto chunk_offset = begin; chunk_offset < end; ++chunk_offset) {
+        mvcc_data->end_cids[chunk_offset].store(commit_id, std::memory_order_relaxed);
+      }
+      mvcc_data->invalid_row_count += end - begin;
+    }
+  });
+  _phase = TransactionPhase::Committed;
+}
+
+void TransactionContext::rollback() {
+  Assert(_phase == TransactionPhase::Active || _phase == TransactionPhase::Conflicted,
+         "Only active transactions can be rolled back");
+  // Inserted rows keep MAX_COMMIT_ID as begin commit ID, so they are not visible to any transaction
+  for (const auto& [mvcc_data, begin, end] : _inserted_rows) {
+    for (auto chunk_offset = begin; chunk_offset < end; ++chunk_offset) {
+      mvcc_data->tids[chunk_offset].store(INVALID_TRANSACTION_ID, std::memory_order_relaxed);
+    }
+    mvcc_data->invalid_row_count += end - begin;
+  }
+  for (const auto& [mvcc_data, begin, end] : _deleted_rows) {
+    for (auto chunk_offset = begin; chunk_offset < end; ++chunk_offset) {
+      mvcc_data->tids[chunk_offset].store(INVALID_TRANSACTION_ID, std::memory_order_release);
+    }
+  }
+  _phase = TransactionPhase::RolledBack;
+}
+
+void TransactionContext::_add_row(std::vector<MvccRowRange>& row_ranges, const std::shared_ptr<MvccData>& mvcc_data,
+                                  const ChunkOffset chunk_offset) {
+  if (!row_ranges.empty() && row_ranges.back().mvcc_data == mvcc_data && row_ranges.back().end == chunk_offset) {
+    ++row_ranges.back().end;
+    return;
+  }
+  row_ranges.push_back({mvcc_data, chunk_offset, chunk_offset + 1});
+}
+
+}  // namespace opossum
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "storage/column_span.hpp"
+#include "storage/mvcc_data.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+enum class TransactionPhase { Active, Conflicted, Committed, RolledBack };
+
+/**
+ * A transaction with snapshot isolation on tables that use MVCC (see MvccData), created by the TransactionManager. It
+ * reads the tables as of the last commit before it began (see Validate), plus its own changes. Its inserts and
+ * deletes are invisible to other transactions until it commits, and then become visible to later snapshots at once.
+ *
+ * Deleting a row locks it by setting its transaction ID. If another transaction holds the lock, or deleted the row
+ * after the snapshot, or the row was moved to another chunk by compaction, the delete fails with a write-write
+ * conflict and the transaction has to be rolled back.
+ * Transactions that are neither committed nor rolled back are rolled back when they are destroyed.
+ */
+class TransactionContext : private Noncopyable {
+ public:
+  TransactionContext(const TransactionID transaction_id, const CommitID snapshot_commit_id);
+
+  ~TransactionContext();
+
+  TransactionID transaction_id() const;
+
+  CommitID snapshot_commit_id() const;
+
+  TransactionPhase phase() const;
+
+  // Inserts the rows given as one ColumnSpan per column (see Table::append_columns) into a table that uses MVCC
+  void insert(const std::shared_ptr<Table>& table, const std::vector<ColumnSpan>& columns);
+
+  // Deletes the rows of a table that uses MVCC that are referenced by a table of ReferenceSegments, e.g., the output
+  // of a TableScan on a Validate. Returns false if there was a write-write conflict, in which case the transaction is
+  // Conflicted and has to be rolled back. Rows that the transaction inserted itself cannot be deleted.
+  [[nodiscard]] bool delete_rows(const std::shared_ptr<const Table>& reference_table);
+
+  // Makes the changes visible to transactions that begin afterwards
+  void commit();
+
+  // Undoes the changes, i.e., the inserted rows are never visible and the deleted rows are unlocked
+  void rollback();
+
+ protected:
+  static void _add_row(std::vector<MvccRowRange>& row_ranges, const std::shared_ptr<MvccData>& mvcc_data,
+                       const ChunkOffset chunk_offset);
+
+  const TransactionID _transaction_id;
+  const CommitID _snapshot_commit_id;
+  TransactionPhase _phase = TransactionPhase::Active;
+
+  std::vector<MvccRowRange> _inserted_rows;
+  std::vector<MvccRowRange> _deleted_rows;
+};
+
+}  // namespace opossum
@@ -0,0 +1,46 @@
+#include "transaction_manager.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <mutex>
+
+#include "transaction_context.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+TransactionManager& TransactionManager::get() {
+  static auto instance = TransactionManager{};
+  return instance;
+}
+
+std::shared_ptr<TransactionContext> TransactionManager::new_transaction_context() {
+  // The snapshot is registered before oldest_snapshot_commit_id() can return a newer commit ID
+  const auto lock = std::lock_guard{_snapshot_mutex};
+  const auto snapshot_commit_id = last_commit_id();
+  _snapshot_commit_ids.insert(snapshot_commit_id);
+  return std::make_shared<TransactionContext>(_next_transaction_id++, snapshot_commit_id);
+}
+
+CommitID TransactionManager::last_commit_id() const { return _last_commit_id.load(std::memory_order_acquire); }
+
+CommitID TransactionManager::oldest_snapshot_commit_id() const {
+  const auto lock = std::lock_guard{_snapshot_mutex};
+  const auto last_commit_id = this->last_commit_id();
+  return _snapshot_commit_ids.empty() ? last_commit_id : std::min(*_snapshot_commit_ids.begin(), last_commit_id);
+}
+
+void TransactionManager::_commit(const std::function<void(CommitID)>& apply) {
+  const auto lock = std::lock_guard{_commit_mutex};
+  const auto commit_id = _last_commit_id.load(std::memory_order_relaxed) + 1;
+  Assert(commit_id != MAX_COMMIT_ID, "Commit IDs are exhausted");
+  apply(commit_id);
+  _last_commit_id.store(commit_id, std::memory_order_release);
+}
+
+void TransactionManager::_end_snapshot(const CommitID snapshot_commit_id) {
+  const auto lock = std::lock_guard{_snapshot_mutex};
+  _snapshot_commit_ids.erase(_snapshot_commit_ids.find(snapshot_commit_id));
+}
+
+}  // namespace opossum
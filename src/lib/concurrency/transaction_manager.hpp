@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <set>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class TransactionContext;
+
+// The TransactionManager is a singleton that hands out transaction IDs and commit IDs.
+//
+// A transaction reads the snapshot of the last commit ID when it begins. Commits are serialized: each one gets the
+// next commit ID, stamps it into the MVCC columns of the rows it inserted and deleted, and only then publishes it as
+// the last commit ID. So a snapshot either contains all changes of a transaction or none of them. Inserting and
+// deleting rows happens before the commit and does not block other transactions.
+class TransactionManager : private Noncopyable {
+ public:
+  static TransactionManager& get();
+
+  std::shared_ptr<TransactionContext> new_transaction_context();
+
+  // The commit ID of the last committed transaction, which is the snapshot of transactions that begin now
+  CommitID last_commit_id() const;
+
+  // The oldest snapshot that a running or future transaction can read. Rows deleted up to this commit ID are invisible
+  // to all transactions, so they can be removed (see ChunkCompactor).
+  CommitID oldest_snapshot_commit_id() const;
+
+  TransactionManager(TransactionManager&&) = delete;
+
+ protected:
+  friend class TransactionContext;
+
+  TransactionManager() = default;
+
+  // Calls apply with the next commit ID and publishes the commit ID afterwards
+  void _commit(const std::function<void(CommitID)>& apply);
+
+  // Called when a transaction with the given snapshot is destroyed
+  void _end_snapshot(const CommitID snapshot_commit_id);
+
+  std::atomic<TransactionID> _next_transaction_id{INVALID_TRANSACTION_ID + 1};
+  std::atomic<CommitID> _last_commit_id{0};
+  std::mutex _commit_mutex;
+  // The snapshots of the transactions that have not been destroyed yet
+  mutable std::mutex _snapshot_mutex;
+  std::multiset<CommitID> _snapshot_commit_ids;
+};
+
+}  // namespace opossum
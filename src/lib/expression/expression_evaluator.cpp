@@ -0,0 +1,270 @@
+#include "expression_evaluator.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+template <typename Functor>
+void with_arithmetic_functor(const ArithmeticOperator arithmetic_operator, const Functor& func) {
+  switch (arithmetic_operator) {
+    case ArithmeticOperator::Addition:
+      return func(std::plus<>{});
+    case ArithmeticOperator::Subtraction:
+      return func(std::minus<>{});
+    case ArithmeticOperator::Multiplication:
+      return func(std::multiplies<>{});
+    case ArithmeticOperator::Division:
+      return func(std::divides<>{});
+  }
+  Fail("Unknown arithmetic operator");
+}
+
+template <typename Functor>
+void with_comparator(const ScanType scan_type, const Functor& func) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return func(std::equal_to<>{});
+    case ScanType::OpNotEquals:
+      return func(std::not_equal_to<>{});
+    case ScanType::OpLessThan:
+      return func(std::less<>{});
+    case ScanType::OpLessThanEquals:
+      return func(std::less_equal<>{});
+    case ScanType::OpGreaterThan:
+      return func(std::greater<>{});
+    case ScanType::OpGreaterThanEquals:
+      return func(std::greater_equal<>{});
+    case ScanType::OpBetween:
+    case ScanType::OpIn:
+    case ScanType::OpLike:
+    case ScanType::OpJoinFilter:
+      break;
+  }
+  Fail("Unsupported scan type");
+}
+
+// A compiled child expression together with the buffer that it writes its batches to, which is allocated once
+template <typename T>
+struct CompiledChild {
+  using Type = T;
+
+  const T* operator()(const ChunkOffset begin, const ChunkOffset end, const uint8_t* selected_rows) const {
+    return function(begin, end, selected_rows, buffer->data());
+  }
+
+  std::function<const T*(const ChunkOffset, const ChunkOffset, const uint8_t*, T*)> function;
+  std::shared_ptr<std::vector<T>> buffer = std::make_shared<std::vector<T>>(ExpressionEvaluator::BATCH_SIZE);
+};
+
+// Divides two integers. The quotient of the smallest number and -1 does not fit into T and wraps around to the smallest
+// number, as in two's complement arithmetic.
+template <typename T>
+T divide(const T dividend, const T divisor) {
+  using Unsigned = std::make_unsigned_t<T>;
+  if (divisor == -1) return static_cast<T>(Unsigned{0} - static_cast<Unsigned>(dividend));
+  return dividend / divisor;
+}
+
+}  // namespace
+
+ExpressionEvaluator::ExpressionEvaluator(const std::shared_ptr<const Table>& table, const ChunkID chunk_id)
+    : _table(table),
+      _chunk_id(chunk_id),
+      _chunk_size(table->pin_chunk(chunk_id)->size()),
+      _column_segments(table->column_count()) {}
+
+std::shared_ptr<BaseSegment> ExpressionEvaluator::evaluate_to_segment(const AbstractExpression& expression) {
+  auto segment = std::shared_ptr<BaseSegment>{};
+  resolve_data_type(expression.data_type(*_table), [&](auto type) {
+    using Type = typename decltype(type)::type;
+    const auto evaluate_batch = _compile<Type>(expression);
+    auto values = std::vector<Type>(_chunk_size);
+    for (auto begin = ChunkOffset{0}; begin < _chunk_size; begin += std::min(BATCH_SIZE, _chunk_size - begin)) {
+      const auto end = std::min(_chunk_size, begin + BATCH_SIZE);
+      const auto batch = values.data() + begin;
+      const auto result = evaluate_batch(begin, end, nullptr, batch);
+      if (result != batch) std::copy(result, result + (end - begin), batch);
+    }
+    segment = std::make_shared<ValueSegment<Type>>(std::move(values));
+  });
+  return segment;
+}
+
+template <typename T>
+ExpressionEvaluator::BatchFunction<T> ExpressionEvaluator::_compile(const AbstractExpression& expression) {
+  if (const auto column_expression = dynamic_cast<const ColumnExpression*>(&expression)) {
+    const auto values = _column_values<T>(column_expression->column_id);
+    return [values](const ChunkOffset begin, const ChunkOffset /*end*/, const uint8_t* /*selected_rows*/,
+                    T* /*buffer*/) -> const T* { return values.data() + begin; };
+  }
+
+  if (const auto value_expression = dynamic_cast<const ValueExpression*>(&expression)) {
+    const auto values = std::make_shared<std::vector<T>>(BATCH_SIZE, boost::get<T>(value_expression->value));
+    return [values](const ChunkOffset /*begin*/, const ChunkOffset /*end*/, const uint8_t* /*selected_rows*/,
+                    T* /*buffer*/) -> const T* { return values->data(); };
+  }
+
+  auto batch_function = BatchFunction<T>{};
+
+  // Compiles both children with their own types and calls func(left, right) with them
+  const auto with_children = [&](const AbstractExpression& left, const AbstractExpression& right, const auto& func) {
+    resolve_data_type(left.data_type(*_table), [&](auto left_type) {
+      using LeftType = typename decltype(left_type)::type;
+      resolve_data_type(right.data_type(*_table), [&](auto right_type) {
+        using RightType = typename decltype(right_type)::type;
+        func(CompiledChild<LeftType>{_compile<LeftType>(left)}, CompiledChild<RightType>{_compile<RightType>(right)});
+      });
+    });
+  };
+
+  if (const auto arithmetic_expression = dynamic_cast<const ArithmeticExpression*>(&expression)) {
+    with_children(*arithmetic_expression->left, *arithmetic_expression->right, [&](const auto left, const auto right) {
+      using LeftType = typename decltype(left)::Type;
+      using RightType = typename decltype(right)::Type;
+      if constexpr (std::is_arithmetic_v<T> && std::is_arithmetic_v<LeftType> && std::is_arithmetic_v<RightType>) {
+        const auto arithmetic_operator = arithmetic_expression->arithmetic_operator;
+        if constexpr (std::is_integral_v<T>) {
+          if (arithmetic_operator == ArithmeticOperator::Division) {
+            batch_function = [=](const ChunkOffset begin, const ChunkOffset end, const uint8_t* selected_rows,
+                                 T* buffer) -> const T* {
+              const auto left_values = left(begin, end, selected_rows);
+              const auto right_values = right(begin, end, selected_rows);
+              auto division_by_zero = false;
+              for (auto index = ChunkOffset{0}; index < end - begin; ++index) {
+                const auto divisor = static_cast<T>(right_values[index]);
+                const auto selected = !selected_rows || selected_rows[index];
+                division_by_zero |= selected && divisor == 0;
+                // Rows that are not selected are divided by 1 instead, so that their divisors cannot be zero
+                buffer[index] = divide(static_cast<T>(left_values[index]), selected && divisor != 0 ? divisor : T{1});
+              }
+              Assert(!division_by_zero, "Division by zero");
+              return buffer;
+            };
+            return;
+          }
+        }
+        with_arithmetic_functor(arithmetic_operator, [&](const auto functor) {
+          batch_function = [=](const ChunkOffset begin, const ChunkOffset end, const uint8_t* selected_rows,
+                               T* buffer) -> const T* {
+            const auto left_values = left(begin, end, selected_rows);
+            const auto right_values = right(begin, end, selected_rows);
+            for (auto index = ChunkOffset{0}; index < end - begin; ++index) {
+              buffer[index] = functor(static_cast<T>(left_values[index]), static_cast<T>(right_values[index]));
+            }
+            return buffer;
+          };
+        });
+      } else {
+        Fail("Arithmetic is only supported on numbers");
+      }
+    });
+    return batch_function;
+  }
+
+  if (const auto comparison_expression = dynamic_cast<const ComparisonExpression*>(&expression)) {
+    with_children(*comparison_expression->left, *comparison_expression->right, [&](const auto left, const auto right) {
+      using LeftType = typename decltype(left)::Type;
+      using RightType = typename decltype(right)::Type;
+      constexpr auto both_arithmetic = std::is_arithmetic_v<LeftType> && std::is_arithmetic_v<RightType>;
+      if constexpr (std::is_same_v<T, int32_t> && (both_arithmetic || std::is_same_v<LeftType, RightType>)) {
+        with_comparator(comparison_expression->scan_type, [&](const auto comparator) {
+          batch_function = [=](const ChunkOffset begin, const ChunkOffset end, const uint8_t* selected_rows,
+                               T* buffer) -> const T* {
+            const auto left_values = left(begin, end, selected_rows);
+            const auto right_values = right(begin, end, selected_rows);
+            for (auto index = ChunkOffset{0}; index < end - begin; ++index) {
+              buffer[index] = comparator(left_values[index], right_values[index]);
+            }
+            return buffer;
+          };
+        });
+      } else {
+        Fail("Numbers can only be compared to numbers and strings to strings");
+      }
+    });
+    return batch_function;
+  }
+
+  if (const auto case_expression = dynamic_cast<const CaseExpression*>(&expression)) {
+    resolve_data_type(case_expression->condition->data_type(*_table), [&](auto condition_type) {
+      using ConditionType = typename decltype(condition_type)::type;
+      if constexpr (std::is_arithmetic_v<ConditionType>) {
+        const auto condition = CompiledChild<ConditionType>{_compile<ConditionType>(*case_expression->condition)};
+        // Both branches are computed for all rows, so that the selection is a branch-free loop. Each branch is told
+        // which rows it is taken for, so that the rows of the other branch cannot make it fail (e.g., in
+        // CASE WHEN b <> 0 THEN a / b ELSE 0 END).
+        const auto then_rows = std::make_shared<std::vector<uint8_t>>(BATCH_SIZE);
+        const auto else_rows = std::make_shared<std::vector<uint8_t>>(BATCH_SIZE);
+        with_children(*case_expression->then_expression, *case_expression->else_expression,
+                      [&](const auto then_branch, const auto else_branch) {
+                        using ThenType = typename decltype(then_branch)::Type;
+                        using ElseType = typename decltype(else_branch)::Type;
+                        if constexpr (std::is_convertible_v<ThenType, T> && std::is_convertible_v<ElseType, T>) {
+                          batch_function = [=](const ChunkOffset begin, const ChunkOffset end,
+                                               const uint8_t* selected_rows, T* buffer) -> const T* {
+                            const auto condition_values = condition(begin, end, selected_rows);
+                            for (auto index = ChunkOffset{0}; index < end - begin; ++index) {
+                              const auto selected = !selected_rows || selected_rows[index];
+                              (*then_rows)[index] = selected && condition_values[index];
+                              (*else_rows)[index] = selected && !condition_values[index];
+                            }
+                            const auto then_values = then_branch(begin, end, then_rows->data());
+                            const auto else_values = else_branch(begin, end, else_rows->data());
+                            for (auto index = ChunkOffset{0}; index < end - begin; ++index) {
+                              buffer[index] = condition_values[index] ? static_cast<T>(then_values[index])
+                                                                      : static_cast<T>(else_values[index]);
+                            }
+                            return buffer;
+                          };
+                        } else {
+                          Fail("THEN and ELSE have to be both numbers or both strings");
+                        }
+                      });
+      } else {
+        Fail("CASE conditions have to be numbers");
+      }
+    });
+    return batch_function;
+  }
+
+  Fail("Unknown expression type");
+}
+
+template <typename T>
+std::span<const T> ExpressionEvaluator::_column_values(const ColumnID column_id) {
+  auto& column_segment = _column_segments[column_id];
+  if (!column_segment) {
+    const auto segment = _table->pin_chunk(_chunk_id)->get_segment(column_id);
+    if (std::dynamic_pointer_cast<const ValueSegment<T>>(segment)) {
+      column_segment = segment;
+    } else if (const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(segment)) {
+      auto values = std::vector<T>(_chunk_size);
+      reference_segment->gather(values.data());
+      column_segment = std::make_shared<ValueSegment<T>>(std::move(values));
+    } else {
+      auto values = std::vector<T>(_chunk_size);
+      segment_iterate<T>(*segment, _chunk_size,
+                         [&](const auto& value, const auto chunk_offset) { values[chunk_offset] = value; });
+      column_segment = std::make_shared<ValueSegment<T>>(std::move(values));
+    }
+  }
+  // The ValueSegments of a mutable chunk can hold rows that were appended after _chunk_size was read
+  return static_cast<const ValueSegment<T>&>(*column_segment).values().first(_chunk_size);
+}
+
+}  // namespace opossum
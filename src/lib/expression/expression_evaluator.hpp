@@ -0,0 +1,58 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "expressions.hpp"
+#include "storage/base_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+/**
+ * Computes expressions for all rows of one chunk of a table.
+ *
+ * The expression tree is compiled once per chunk into one batch function per node: data types are resolved, columns
+ * that are not stored in ValueSegments are decoded, and the buffers of the children are allocated then. The rows are
+ * then processed in batches of BATCH_SIZE, for which each node only fills its typed buffer with a simple loop over its
+ * children's buffers, which the compiler can vectorize.
+ */
+class ExpressionEvaluator {
+ public:
+  ExpressionEvaluator(const std::shared_ptr<const Table>& table, const ChunkID chunk_id);
+
+  // Returns a ValueSegment with the value of the expression for every row of the chunk
+  std::shared_ptr<BaseSegment> evaluate_to_segment(const AbstractExpression& expression);
+
+  // Small enough for the buffers of a few expression nodes to stay in the L1/L2 cache
+  static constexpr auto BATCH_SIZE = ChunkOffset{1024};
+
+ protected:
+  // Computes the values of an expression for the rows [begin, end) of a batch. The values are written to buffer, which
+  // has room for end - begin values, unless they are stored somewhere already. The returned pointer points to the
+  // values. selected_rows is nullptr if the values of all rows are needed. Otherwise, only the rows with a non-zero
+  // entry are (e.g., the rows a CASE branch is taken for): the values of the others are arbitrary, and they must not
+  // make the evaluation fail.
+  template <typename T>
+  using BatchFunction =
+      std::function<const T*(const ChunkOffset begin, const ChunkOffset end, const uint8_t* selected_rows, T* buffer)>;
+
+  template <typename T>
+  BatchFunction<T> _compile(const AbstractExpression& expression);
+
+  template <typename T>
+  std::span<const T> _column_values(const ColumnID column_id);
+
+  const std::shared_ptr<const Table> _table;
+  const ChunkID _chunk_id;
+  const ChunkOffset _chunk_size;
+
+  // ValueSegments with the values of the columns used so far, indexed by column id
+  std::vector<std::shared_ptr<const BaseSegment>> _column_segments;
+};
+
+}  // namespace opossum
@@ -0,0 +1,149 @@
+#include "expressions.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include "resolve_type.hpp"
+#include "storage/table.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Returns the type string of values combined from values of the two given types, or an empty string if values of these
+// types cannot be combined
+std::string combined_data_type(const std::string& left_type_string, const std::string& right_type_string) {
+  auto combined_type_string = std::string{};
+  resolve_data_type(left_type_string, [&](auto left_type) {
+    using LeftType = typename decltype(left_type)::type;
+    resolve_data_type(right_type_string, [&](auto right_type) {
+      using RightType = typename decltype(right_type)::type;
+      if constexpr (std::is_arithmetic_v<LeftType> && std::is_arithmetic_v<RightType>) {
+        combined_type_string = data_type_name<decltype(LeftType{} + RightType{})>();
+      } else if constexpr (std::is_same_v<LeftType, RightType>) {
+        combined_type_string = data_type_name<LeftType>();
+      }
+    });
+  });
+  return combined_type_string;
+}
+
+std::string arithmetic_operator_to_string(const ArithmeticOperator arithmetic_operator) {
+  switch (arithmetic_operator) {
+    case ArithmeticOperator::Addition:
+      return "+";
+    case ArithmeticOperator::Subtraction:
+      return "-";
+    case ArithmeticOperator::Multiplication:
+      return "*";
+    case ArithmeticOperator::Division:
+      return "/";
+  }
+  Fail("Unknown arithmetic operator");
+}
+
+std::string scan_type_to_string(const ScanType scan_type) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return "=";
+    case ScanType::OpNotEquals:
+      return "!=";
+    case ScanType::OpLessThan:
+      return "<";
+    case ScanType::OpLessThanEquals:
+      return "<=";
+    case ScanType::OpGreaterThan:
+      return ">";
+    case ScanType::OpGreaterThanEquals:
+      return ">=";
+    case ScanType::OpBetween:
+    case ScanType::OpIn:
+    case ScanType::OpLike:
+    case ScanType::OpJoinFilter:
+      break;
+  }
+  Fail("Unsupported scan type");
+}
+
+}  // namespace
+
+std::string AbstractExpression::_child_description(const AbstractExpression& child, const Table& table) {
+  if (dynamic_cast<const ColumnExpression*>(&child) || dynamic_cast<const ValueExpression*>(&child)) {
+    return child.description(table);
+  }
+  return "(" + child.description(table) + ")";
+}
+
+ColumnExpression::ColumnExpression(const ColumnID column_id) : column_id(column_id) {}
+
+std::string ColumnExpression::data_type(const Table& table) const {
+  Assert(column_id < table.column_count(), "Column ID out of range");
+  return table.column_type(column_id);
+}
+
+std::string ColumnExpression::description(const Table& table) const { return table.column_name(column_id); }
+
+ValueExpression::ValueExpression(const AllTypeVariant& value) : value(value) {}
+
+std::string ValueExpression::data_type(const Table& /*table*/) const { return data_type_of(value); }
+
+std::string ValueExpression::description(const Table& /*table*/) const {
+  if (value.type() == typeid(std::string)) return "'" + get<std::string>(value) + "'";
+  return type_cast<std::string>(value);
+}
+
+ArithmeticExpression::ArithmeticExpression(const ArithmeticOperator arithmetic_operator,
+                                           const std::shared_ptr<AbstractExpression>& left,
+                                           const std::shared_ptr<AbstractExpression>& right)
+    : arithmetic_operator(arithmetic_operator), left(left), right(right) {}
+
+std::string ArithmeticExpression::data_type(const Table& table) const {
+  const auto type_string = combined_data_type(left->data_type(table), right->data_type(table));
+  Assert(!type_string.empty() && type_string != "string", "Arithmetic is only supported on numbers");
+  return type_string;
+}
+
+std::string ArithmeticExpression::description(const Table& table) const {
+  return _child_description(*left, table) + " " + arithmetic_operator_to_string(arithmetic_operator) + " " +
+         _child_description(*right, table);
+}
+
+ComparisonExpression::ComparisonExpression(const ScanType scan_type, const std::shared_ptr<AbstractExpression>& left,
+                                           const std::shared_ptr<AbstractExpression>& right)
+    : scan_type(scan_type), left(left), right(right) {}
+
+std::string ComparisonExpression::data_type(const Table& table) const {
+  Assert(scan_type != ScanType::OpBetween && scan_type != ScanType::OpIn && scan_type != ScanType::OpLike &&
+             scan_type != ScanType::OpJoinFilter,
+         "Only binary comparisons are supported");
+  Assert(!combined_data_type(left->data_type(table), right->data_type(table)).empty(),
+         "Numbers can only be compared to numbers and strings to strings");
+  return "int";
+}
+
+std::string ComparisonExpression::description(const Table& table) const {
+  return _child_description(*left, table) + " " + scan_type_to_string(scan_type) + " " +
+         _child_description(*right, table);
+}
+
+CaseExpression::CaseExpression(const std::shared_ptr<AbstractExpression>& condition,
+                               const std::shared_ptr<AbstractExpression>& then_expression,
+                               const std::shared_ptr<AbstractExpression>& else_expression)
+    : condition(condition), then_expression(then_expression), else_expression(else_expression) {}
+
+std::string CaseExpression::data_type(const Table& table) const {
+  Assert(condition->data_type(table) != "string", "CASE conditions have to be numbers");
+  const auto type_string = combined_data_type(then_expression->data_type(table), else_expression->data_type(table));
+  Assert(!type_string.empty(), "THEN and ELSE have to be both numbers or both strings");
+  return type_string;
+}
+
+std::string CaseExpression::description(const Table& table) const {
+  return "CASE WHEN " + condition->description(table) + " THEN " + then_expression->description(table) + " ELSE " +
+         else_expression->description(table) + " END";
+}
+
+}  // namespace opossum
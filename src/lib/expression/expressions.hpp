@@ -0,0 +1,101 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+enum class ArithmeticOperator { Addition, Subtraction, Multiplication, Division };
+
+/**
+ * Expressions describe values that are computed for every row of a table, e.g., price * (1 - discount). They only
+ * describe the computation, the ExpressionEvaluator computes them on the chunks of a table.
+ *
+ * Data types follow C++: Arithmetic on two ints yields an int, on an int and a double a double, and so on. Comparisons
+ * yield ints that are 1 for true and 0 for false. Strings can be compared, but not be used in arithmetic.
+ */
+class AbstractExpression {
+ public:
+  virtual ~AbstractExpression() = default;
+
+  // Returns the type string of the computed values, failing if the expression is not valid for the table
+  virtual std::string data_type(const Table& table) const = 0;
+
+  // Returns a human-readable representation of the expression, which is also used as its column name
+  virtual std::string description(const Table& table) const = 0;
+
+ protected:
+  // Returns the description of a child, put into parentheses if the child is composed of other expressions
+  static std::string _child_description(const AbstractExpression& child, const Table& table);
+};
+
+// References a column of the table that the expression is evaluated on
+class ColumnExpression : public AbstractExpression {
+ public:
+  explicit ColumnExpression(const ColumnID column_id);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  const ColumnID column_id;
+};
+
+// A literal that has the same value for all rows
+class ValueExpression : public AbstractExpression {
+ public:
+  explicit ValueExpression(const AllTypeVariant& value);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  const AllTypeVariant value;
+};
+
+class ArithmeticExpression : public AbstractExpression {
+ public:
+  ArithmeticExpression(const ArithmeticOperator arithmetic_operator, const std::shared_ptr<AbstractExpression>& left,
+                       const std::shared_ptr<AbstractExpression>& right);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  const ArithmeticOperator arithmetic_operator;
+  const std::shared_ptr<AbstractExpression> left;
+  const std::shared_ptr<AbstractExpression> right;
+};
+
+class ComparisonExpression : public AbstractExpression {
+ public:
+  ComparisonExpression(const ScanType scan_type, const std::shared_ptr<AbstractExpression>& left,
+                       const std::shared_ptr<AbstractExpression>& right);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  const ScanType scan_type;
+  const std::shared_ptr<AbstractExpression> left;
+  const std::shared_ptr<AbstractExpression> right;
+};
+
+// CASE WHEN condition THEN then_expression ELSE else_expression END. A condition holds for non-zero values. Multiple
+// WHEN clauses are expressed by nesting another CaseExpression as else_expression.
+class CaseExpression : public AbstractExpression {
+ public:
+  CaseExpression(const std::shared_ptr<AbstractExpression>& condition,
+                 const std::shared_ptr<AbstractExpression>& then_expression,
+                 const std::shared_ptr<AbstractExpression>& else_expression);
+
+  std::string data_type(const Table& table) const override;
+  std::string description(const Table& table) const override;
+
+  const std::shared_ptr<AbstractExpression> condition;
+  const std::shared_ptr<AbstractExpression> then_expression;
+  const std::shared_ptr<AbstractExpression> else_expression;
+};
+
+}  // namespace opossum
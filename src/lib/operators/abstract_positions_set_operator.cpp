@@ -0,0 +1,130 @@
+#include "abstract_positions_set_operator.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+// The positions of an input, grouped by the chunk of the referenced table
+struct ReferencedPositions {
+  std::shared_ptr<const Table> referenced_table;
+  std::vector<ColumnID> referenced_column_ids;
+  std::vector<std::vector<ChunkOffset>> chunk_offsets;
+};
+
+ReferencedPositions collect_referenced_positions(const Table& table) {
+  auto referenced_positions = ReferencedPositions{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    const auto chunk = table.pin_chunk(chunk_id);
+    if (chunk->column_count() == 0) continue;
+
+    auto pos_list = std::shared_ptr<const PosList>{};
+    for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+      const auto segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(column_id));
+      Assert(segment, "Inputs of set operators have to consist of ReferenceSegments");
+
+      if (!referenced_positions.referenced_table) {
+        referenced_positions.referenced_table = segment->referenced_table();
+        referenced_positions.chunk_offsets.resize(segment->referenced_table()->chunk_count());
+      }
+      if (referenced_positions.referenced_column_ids.size() < chunk->column_count()) {
+        referenced_positions.referenced_column_ids.push_back(segment->referenced_column_id());
+      }
+      Assert(segment->referenced_table() == referenced_positions.referenced_table &&
+                 segment->referenced_column_id() == referenced_positions.referenced_column_ids[column_id],
+             "All chunks of an input have to reference the same columns of the same table");
+
+      if (!pos_list) pos_list = segment->pos_list();
+      Assert(segment->pos_list() == pos_list || *segment->pos_list() == *pos_list,
+             "All columns of a chunk have to reference the same positions");
+    }
+
+    for (const auto& row_id : *pos_list) {
+      referenced_positions.chunk_offsets[row_id.chunk_id].push_back(row_id.chunk_offset);
+    }
+  }
+  return referenced_positions;
+}
+
+}  // namespace
+
+AbstractPositionsSetOperator::AbstractPositionsSetOperator(const std::shared_ptr<const AbstractOperator>& left,
+                                                           const std::shared_ptr<const AbstractOperator>& right)
+    : AbstractOperator(left, right) {}
+
+std::shared_ptr<const Table> AbstractPositionsSetOperator::_on_execute() {
+  const auto left_table = _left_input_table();
+  const auto right_table = _right_input_table();
+  Assert(left_table->column_count() == right_table->column_count(), "Inputs have to have the same columns");
+
+  auto output_table = std::make_shared<Table>(left_table->target_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < left_table->column_count(); ++column_id) {
+    output_table->add_column_definition(left_table->column_name(column_id), left_table->column_type(column_id));
+  }
+
+  auto left_positions = collect_referenced_positions(*left_table);
+  auto right_positions = collect_referenced_positions(*right_table);
+  Assert(left_positions.referenced_table == right_positions.referenced_table &&
+             left_positions.referenced_column_ids == right_positions.referenced_column_ids,
+         "Inputs have to reference the same columns of the same table");
+
+  const auto& referenced_table = left_positions.referenced_table;
+  const auto& referenced_column_ids = left_positions.referenced_column_ids;
+  // The inputs can see different chunk counts if chunks were added to the referenced table between their executions
+  const auto referenced_chunk_count =
+      std::max(left_positions.chunk_offsets.size(), right_positions.chunk_offsets.size());
+  left_positions.chunk_offsets.resize(referenced_chunk_count);
+  right_positions.chunk_offsets.resize(referenced_chunk_count);
+
+  auto pos_lists = std::vector<std::shared_ptr<PosList>>(referenced_chunk_count);
+  parallel_for(referenced_chunk_count, [&](const size_t chunk_index) {
+    auto& left_chunk_offsets = left_positions.chunk_offsets[chunk_index];
+    auto& right_chunk_offsets = right_positions.chunk_offsets[chunk_index];
+    if (left_chunk_offsets.empty() && right_chunk_offsets.empty()) return;
+
+    // TableScans emit positions in ascending order, so sorting is usually skipped
+    for (auto* chunk_offsets : {&left_chunk_offsets, &right_chunk_offsets}) {
+      if (!std::is_sorted(chunk_offsets->cbegin(), chunk_offsets->cend())) {
+        std::sort(chunk_offsets->begin(), chunk_offsets->end());
+      }
+    }
+
+    auto result = std::vector<ChunkOffset>{};
+    _merge(left_chunk_offsets, right_chunk_offsets, result);
+    if (result.empty()) return;
+
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+    auto pos_list = std::make_shared<PosList>();
+    pos_list->reserve(result.size());
+    for (const auto chunk_offset : result) pos_list->push_back(RowID{chunk_id, chunk_offset});
+    pos_lists[chunk_index] = std::move(pos_list);
+  });
+
+  const auto emplace_reference_chunk = [&](const std::shared_ptr<const PosList>& pos_list) {
+    auto chunk = Chunk{};
+    for (const auto referenced_column_id : referenced_column_ids) {
+      chunk.add_segment(std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, pos_list));
+    }
+    output_table->emplace_chunk(std::move(chunk));
+  };
+
+  for (const auto& pos_list : pos_lists) {
+    if (pos_list) emplace_reference_chunk(pos_list);
+  }
+
+  // Consumers expect every chunk to hold one segment per column, even if no row qualified
+  if (output_table->row_count() == 0 && referenced_table) emplace_reference_chunk(std::make_shared<PosList>());
+
+  return output_table;
+}
+
+}  // namespace opossum
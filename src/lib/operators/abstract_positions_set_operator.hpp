@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Base class for operators that combine the rows of two inputs as sets of positions, e.g., to evaluate disjunctions
+ * of TableScans. Both inputs have to consist of ReferenceSegments that reference the same columns of the same table,
+ * with all columns of a chunk referencing the same positions. This is the case for outputs of TableScans on the same
+ * input, even after Projections.
+ *
+ * The positions of both inputs are grouped by referenced chunk. Per referenced chunk, the chunk offsets are sorted
+ * (unless they already are) and merged, which runs in parallel. The output references the same table with one chunk
+ * per referenced chunk, no values are materialized.
+ */
+class AbstractPositionsSetOperator : public AbstractOperator {
+ public:
+  AbstractPositionsSetOperator(const std::shared_ptr<const AbstractOperator>& left,
+                               const std::shared_ptr<const AbstractOperator>& right);
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  // Writes the combination of two sorted lists of chunk offsets to result. The result has to be sorted and must not
+  // contain duplicates, while the inputs may.
+  virtual void _merge(const std::vector<ChunkOffset>& left, const std::vector<ChunkOffset>& right,
+                      std::vector<ChunkOffset>& result) const = 0;
+};
+
+}  // namespace opossum
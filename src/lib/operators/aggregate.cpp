@@ -0,0 +1,356 @@
+#include "aggregate.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/container_hash/hash.hpp>
+#include <boost/variant/detail/hash_variant.hpp>
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/fixed_size_attribute_vector.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+using GroupID = uint32_t;
+constexpr auto INVALID_GROUP_ID = std::numeric_limits<GroupID>::max();
+
+using GroupKey = std::vector<AllTypeVariant>;
+
+// Maps the values of the group-by columns to a table-wide group id
+class GroupRegistry {
+ public:
+  GroupID get_or_add(GroupKey&& key) {
+    const auto [it, inserted] = _group_ids.try_emplace(key, static_cast<GroupID>(_keys.size()));
+    if (inserted) _keys.push_back(std::move(key));
+    return it->second;
+  }
+
+  size_t size() const { return _keys.size(); }
+
+  const std::vector<GroupKey>& keys() const { return _keys; }
+
+ protected:
+  std::unordered_map<GroupKey, GroupID, boost::hash<GroupKey>> _group_ids;
+  std::vector<GroupKey> _keys;
+};
+
+std::string aggregate_function_name(const AggregateFunction function) {
+  switch (function) {
+    case AggregateFunction::Min:
+      return "MIN";
+    case AggregateFunction::Max:
+      return "MAX";
+    case AggregateFunction::Sum:
+      return "SUM";
+    case AggregateFunction::Avg:
+      return "AVG";
+    case AggregateFunction::Count:
+      return "COUNT";
+  }
+  Fail("Unknown AggregateFunction");
+}
+
+class BaseAggregateAccumulator {
+ public:
+  virtual ~BaseAggregateAccumulator() = default;
+
+  // updates the aggregates of the groups with the values of the segment, group_ids holds the group of each row
+  virtual void aggregate(const BaseSegment& segment, const std::vector<GroupID>& group_ids) = 0;
+
+  virtual void resize(const size_t group_count) = 0;
+
+  virtual std::string result_type() const = 0;
+
+  virtual std::shared_ptr<BaseSegment> result_segment() const = 0;
+};
+
+template <typename T>
+class AggregateAccumulator : public BaseAggregateAccumulator {
+ public:
+  // Integral values are summed up as long, floating point values as double
+  using SumType = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+
+  AggregateAccumulator(const AggregateFunction function, const std::string& column_type)
+      : _function(function), _column_type(column_type) {
+    if constexpr (!std::is_arithmetic_v<T>) {
+      Assert(function != AggregateFunction::Sum && function != AggregateFunction::Avg,
+             "SUM and AVG are only supported for numerical columns");
+    }
+  }
+
+  void aggregate(const BaseSegment& segment, const std::vector<GroupID>& group_ids) final {
+    const auto chunk_size = static_cast<ChunkOffset>(group_ids.size());
+    switch (_function) {
+      case AggregateFunction::Min:
+      case AggregateFunction::Max: {
+        const auto is_min = _function == AggregateFunction::Min;
+        segment_iterate<T>(segment, chunk_size, [&](const auto& value, const auto chunk_offset) {
+          const auto group_id = group_ids[chunk_offset];
+          if (!_has_value[group_id] || (is_min ? value < _values[group_id] : _values[group_id] < value)) {
+            _values[group_id] = value;
+            _has_value[group_id] = true;
+          }
+        });
+      } break;
+      case AggregateFunction::Sum:
+      case AggregateFunction::Avg:
+        if constexpr (std::is_arithmetic_v<T>) {
+          segment_iterate<T>(segment, chunk_size, [&](const auto& value, const auto chunk_offset) {
+            _sums[group_ids[chunk_offset]] += value;
+          });
+        }
+        [[fallthrough]];
+      case AggregateFunction::Count:
+        for (const auto group_id : group_ids) ++_counts[group_id];
+        break;
+    }
+  }
+
+  void resize(const size_t group_count) final {
+    _values.resize(group_count);
+    _has_value.resize(group_count);
+    _sums.resize(group_count);
+    _counts.resize(group_count);
+  }
+
+  std::string result_type() const final {
+    switch (_function) {
+      case AggregateFunction::Min:
+      case AggregateFunction::Max:
+        return _column_type;
+      case AggregateFunction::Sum:
+        return std::is_integral_v<T> ? "long" : "double";
+      case AggregateFunction::Avg:
+        return "double";
+      case AggregateFunction::Count:
+        return "long";
+    }
+    Fail("Unknown AggregateFunction");
+  }
+
+  std::shared_ptr<BaseSegment> result_segment() const final {
+    switch (_function) {
+      case AggregateFunction::Min:
+      case AggregateFunction::Max:
+        return std::make_shared<ValueSegment<T>>(std::vector<T>(_values));
+      case AggregateFunction::Sum:
+        return std::make_shared<ValueSegment<SumType>>(std::vector<SumType>(_sums));
+      case AggregateFunction::Avg: {
+        auto averages = std::vector<double>(_sums.size());
+        for (auto group_id = size_t{0}; group_id < averages.size(); ++group_id) {
+          averages[group_id] = static_cast<double>(_sums[group_id]) / static_cast<double>(_counts[group_id]);
+        }
+        return std::make_shared<ValueSegment<double>>(std::move(averages));
+      }
+      case AggregateFunction::Count:
+        return std::make_shared<ValueSegment<int64_t>>(std::vector<int64_t>(_counts));
+    }
+    Fail("Unknown AggregateFunction");
+  }
+
+ protected:
+  const AggregateFunction _function;
+  const std::string _column_type;
+  std::vector<T> _values;
+  std::vector<bool> _has_value;
+  std::vector<SumType> _sums;
+  std::vector<int64_t> _counts;
+};
+
+// Maps the packed keys of the last chunk that was grouped on value ids to table-wide group ids. Chunks whose group-by
+// columns share their dictionaries with that chunk (see Table::use_global_dictionary) reuse the mapping, so that each
+// group is decoded and looked up in the registry once per table instead of once per chunk. The array is allocated
+// once per execution: for chunks with other dictionaries, only the keys that were used are reset, so that the work per
+// chunk depends on the chunk size and not on the key space. The dictionaries are held, so that a dictionary that was
+// freed meanwhile (e.g., by Table::use_global_dictionary) cannot be mistaken for one that is allocated at its address.
+struct DenseGroupIDs {
+  std::vector<std::shared_ptr<const void>> dictionaries;
+  std::vector<GroupID> group_ids_by_key;
+  std::vector<uint32_t> used_keys;
+};
+
+// Groups a chunk on the value ids of its dictionary-encoded group-by columns. The value ids are packed into one key
+// (mixed radix, with the dictionary sizes as radices), which is used as an index into a flat array that maps the keys
+// to table-wide group ids. Returns false if the chunk is not eligible, i.e., if a group-by column is not
+// dictionary-encoded or the key space is too large for a flat array.
+bool group_by_value_ids(const Table& table, const Chunk& chunk, const std::vector<ColumnID>& group_by_column_ids,
+                        GroupRegistry& groups, DenseGroupIDs& dense_group_ids, std::vector<GroupID>& group_ids) {
+  const auto chunk_size = static_cast<ChunkOffset>(group_ids.size());
+
+  // Per group-by column: the attribute vector, the dictionary size and a function that decodes a value id
+  auto attribute_vectors = std::vector<std::shared_ptr<const BaseAttributeVector>>{};
+  auto radices = std::vector<uint32_t>{};
+  auto decoders = std::vector<std::function<AllTypeVariant(ValueID)>>{};
+  auto dictionaries = std::vector<std::shared_ptr<const void>>{};
+  auto key_space = size_t{1};
+
+  for (const auto column_id : group_by_column_ids) {
+    const auto segment = chunk.get_segment(column_id);
+    auto is_dictionary_encoded = false;
+    resolve_data_type(table.column_type(column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<Type>>(segment);
+      if (!dictionary_segment) return;
+
+      attribute_vectors.push_back(dictionary_segment->attribute_vector());
+      radices.push_back(static_cast<uint32_t>(dictionary_segment->unique_values_count()));
+      decoders.emplace_back([dictionary_segment](const ValueID value_id) {
+        return AllTypeVariant{dictionary_segment->value_by_value_id(value_id)};
+      });
+      dictionaries.push_back(dictionary_segment->dictionary());
+      is_dictionary_encoded = true;
+    });
+
+    if (!is_dictionary_encoded) return false;
+    key_space *= radices.back();
+    if (key_space > Aggregate::MAX_DENSE_KEY_SPACE) return false;
+  }
+
+  // Build the packed keys column by column so that each pass is a tight loop over one attribute vector
+  auto packed_keys = std::vector<uint32_t>(chunk_size);
+  auto place_value = uint32_t{1};
+  for (auto column_index = size_t{0}; column_index < attribute_vectors.size(); ++column_index) {
+    resolve_attribute_vector(*attribute_vectors[column_index], [&](const auto& value_ids) {
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        packed_keys[chunk_offset] += value_ids[chunk_offset] * place_value;
+      }
+    });
+    place_value *= radices[column_index];
+  }
+
+  // Only keys that occur in the chunk and were not seen in a chunk with the same dictionaries before are decoded and
+  // looked up in the table-wide group registry
+  auto& group_ids_by_key = dense_group_ids.group_ids_by_key;
+  auto& used_keys = dense_group_ids.used_keys;
+  if (dictionaries != dense_group_ids.dictionaries) {
+    dense_group_ids.dictionaries = std::move(dictionaries);
+    for (const auto used_key : used_keys) group_ids_by_key[used_key] = INVALID_GROUP_ID;
+    used_keys.clear();
+  }
+  if (group_ids_by_key.size() < key_space) group_ids_by_key.resize(key_space, INVALID_GROUP_ID);
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    auto& group_id = group_ids_by_key[packed_keys[chunk_offset]];
+    if (group_id == INVALID_GROUP_ID) {
+      used_keys.push_back(packed_keys[chunk_offset]);
+      auto key = GroupKey{};
+      key.reserve(decoders.size());
+      auto remaining_key = packed_keys[chunk_offset];
+      for (auto column_index = size_t{0}; column_index < decoders.size(); ++column_index) {
+        key.push_back(decoders[column_index](ValueID{remaining_key % radices[column_index]}));
+        remaining_key /= radices[column_index];
+      }
+      group_id = groups.get_or_add(std::move(key));
+    }
+    group_ids[chunk_offset] = group_id;
+  }
+
+  return true;
+}
+
+// Fallback for chunks that cannot be grouped on value ids
+void group_by_values(const Chunk& chunk, const std::vector<ColumnID>& group_by_column_ids, GroupRegistry& groups,
+                     std::vector<GroupID>& group_ids) {
+  auto segments = std::vector<std::shared_ptr<BaseSegment>>{};
+  for (const auto column_id : group_by_column_ids) segments.push_back(chunk.get_segment(column_id));
+
+  const auto chunk_size = static_cast<ChunkOffset>(group_ids.size());
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    auto key = GroupKey{};
+    key.reserve(segments.size());
+    for (const auto& segment : segments) key.push_back((*segment)[chunk_offset]);
+    group_ids[chunk_offset] = groups.get_or_add(std::move(key));
+  }
+}
+
+}  // namespace
+
+Aggregate::Aggregate(const std::shared_ptr<const AbstractOperator>& in,
+                     const std::vector<ColumnID>& group_by_column_ids,
+                     const std::vector<AggregateColumnDefinition>& aggregates)
+    : AbstractOperator(in), _group_by_column_ids(group_by_column_ids), _aggregates(aggregates) {}
+
+const std::vector<ColumnID>& Aggregate::group_by_column_ids() const { return _group_by_column_ids; }
+
+const std::vector<AggregateColumnDefinition>& Aggregate::aggregates() const { return _aggregates; }
+
+std::shared_ptr<const Table> Aggregate::_on_execute() {
+  const auto input_table = _left_input_table();
+
+  auto accumulators = std::vector<std::unique_ptr<BaseAggregateAccumulator>>{};
+  for (const auto& aggregate : _aggregates) {
+    resolve_data_type(input_table->column_type(aggregate.column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      accumulators.emplace_back(std::make_unique<AggregateAccumulator<Type>>(
+          aggregate.function, input_table->column_type(aggregate.column_id)));
+    });
+  }
+
+  auto groups = GroupRegistry{};
+  auto dense_group_ids = DenseGroupIDs{};
+  auto group_ids = std::vector<GroupID>{};
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < input_table->chunk_count(); ++chunk_id) {
+    const auto chunk = input_table->pin_chunk(chunk_id);
+    const auto chunk_size = chunk->size();
+    if (chunk_size == 0) continue;
+
+    // group_ids holds the size of the chunk for all steps below, as rows can still be appended to it
+    group_ids.resize(chunk_size);
+    if (!group_by_value_ids(*input_table, *chunk, _group_by_column_ids, groups, dense_group_ids, group_ids)) {
+      group_by_values(*chunk, _group_by_column_ids, groups, group_ids);
+    }
+
+    for (auto aggregate_index = size_t{0}; aggregate_index < _aggregates.size(); ++aggregate_index) {
+      auto& accumulator = *accumulators[aggregate_index];
+      accumulator.resize(groups.size());
+      accumulator.aggregate(*chunk->get_segment(_aggregates[aggregate_index].column_id), group_ids);
+    }
+  }
+
+  // Create the output table. It consists of a single chunk that holds one row per group.
+  auto output_table = std::make_shared<Table>();
+  auto output_chunk = Chunk{};
+
+  for (auto group_column_index = size_t{0}; group_column_index < _group_by_column_ids.size(); ++group_column_index) {
+    const auto column_id = _group_by_column_ids[group_column_index];
+    const auto& column_type = input_table->column_type(column_id);
+    output_table->add_column_definition(input_table->column_name(column_id), column_type);
+
+    resolve_data_type(column_type, [&](auto type) {
+      using Type = typename decltype(type)::type;
+      auto values = std::vector<Type>{};
+      values.reserve(groups.size());
+      for (const auto& key : groups.keys()) values.push_back(type_cast<Type>(key[group_column_index]));
+      output_chunk.add_segment(std::make_shared<ValueSegment<Type>>(std::move(values)));
+    });
+  }
+
+  for (auto aggregate_index = size_t{0}; aggregate_index < _aggregates.size(); ++aggregate_index) {
+    const auto& aggregate = _aggregates[aggregate_index];
+    output_table->add_column_definition(
+        aggregate_function_name(aggregate.function) + "(" + input_table->column_name(aggregate.column_id) + ")",
+        accumulators[aggregate_index]->result_type());
+    output_chunk.add_segment(accumulators[aggregate_index]->result_segment());
+  }
+
+  output_table->emplace_chunk(std::move(output_chunk));
+  return output_table;
+}
+
+}  // namespace opossum
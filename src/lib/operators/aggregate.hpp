@@ -0,0 +1,46 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+enum class AggregateFunction { Min, Max, Sum, Avg, Count };
+
+struct AggregateColumnDefinition {
+  ColumnID column_id;
+  AggregateFunction function;
+};
+
+// Groups the input table by the given columns and computes the requested aggregates for each group. The output table
+// holds the group-by columns followed by one column per aggregate, e.g., "SUM(b)".
+//
+// If all group-by columns of a chunk are DictionarySegments, the chunk is grouped on its value ids: the value ids of
+// the group-by columns are packed into a single dense key, which indexes a flat array instead of a hash table. Only
+// the groups that actually occur in the chunk are decoded via value_by_value_id and merged with the other chunks.
+// Consecutive chunks that share their dictionaries (see Table::use_global_dictionary) also share the mapping from keys
+// to groups, so that the grouping runs on value ids across chunks. All other chunks fall back to hashing the group
+// values.
+class Aggregate : public AbstractOperator {
+ public:
+  Aggregate(const std::shared_ptr<const AbstractOperator>& in, const std::vector<ColumnID>& group_by_column_ids,
+            const std::vector<AggregateColumnDefinition>& aggregates);
+
+  const std::vector<ColumnID>& group_by_column_ids() const;
+  const std::vector<AggregateColumnDefinition>& aggregates() const;
+
+  // The largest packed key space (i.e., the product of the dictionary sizes) for which a chunk is grouped on value ids
+  static constexpr auto MAX_DENSE_KEY_SPACE = size_t{1} << 20;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<ColumnID> _group_by_column_ids;
+  const std::vector<AggregateColumnDefinition> _aggregates;
+};
+
+}  // namespace opossum
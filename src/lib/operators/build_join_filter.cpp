@@ -0,0 +1,24 @@
+#include "build_join_filter.hpp"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/table.hpp"
+
+namespace opossum {
+
+BuildJoinFilter::BuildJoinFilter(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id)
+    : AbstractOperator(in), _column_id(column_id), _join_filter(std::make_shared<JoinFilter>()) {}
+
+ColumnID BuildJoinFilter::column_id() const { return _column_id; }
+
+std::shared_ptr<const JoinFilter> BuildJoinFilter::join_filter() const { return _join_filter; }
+
+std::shared_ptr<const Table> BuildJoinFilter::_on_execute() {
+  const auto input_table = _left_input_table();
+  _join_filter->build(*input_table, _column_id);
+  return input_table;
+}
+
+}  // namespace opossum
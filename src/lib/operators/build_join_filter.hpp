@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "join_filter.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Builds a JoinFilter over the join keys of the (usually filtered) build side of a join and forwards its input
+ * unchanged. The filter exists from construction on, so that it can be passed to the TableScans of the probe side
+ * when the plan is built, and is filled when this operator executes. Thus, it has to execute before these scans.
+ *
+ * Example (a star schema query that keeps the orders of European customers):
+ *
+ *   auto customers = std::make_shared<TableScan>(get_customers, region_column_id, ScanType::OpEquals, "EUROPE");
+ *   auto build_join_filter = std::make_shared<BuildJoinFilter>(customers, customer_key_column_id);
+ *   auto orders = std::make_shared<TableScan>(get_orders, std::vector<ScanPredicate>{
+ *       {customer_foreign_key_column_id, ScanType::OpJoinFilter, {}, {}, {}, {}, build_join_filter->join_filter()}});
+ */
+class BuildJoinFilter : public AbstractOperator {
+ public:
+  BuildJoinFilter(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id);
+
+  ColumnID column_id() const;
+
+  std::shared_ptr<const JoinFilter> join_filter() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const ColumnID _column_id;
+  const std::shared_ptr<JoinFilter> _join_filter;
+};
+
+}  // namespace opossum
@@ -0,0 +1,16 @@
+#include "intersect_positions.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace opossum {
+
+void IntersectPositions::_merge(const std::vector<ChunkOffset>& left, const std::vector<ChunkOffset>& right,
+                                std::vector<ChunkOffset>& result) const {
+  result.reserve(std::min(left.size(), right.size()));
+  std::set_intersection(left.cbegin(), left.cend(), right.cbegin(), right.cend(), std::back_inserter(result));
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+}  // namespace opossum
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_positions_set_operator.hpp"
+
+namespace opossum {
+
+// Returns the rows that are part of both inputs, each row once
+class IntersectPositions : public AbstractPositionsSetOperator {
+ public:
+  using AbstractPositionsSetOperator::AbstractPositionsSetOperator;
+
+ protected:
+  void _merge(const std::vector<ChunkOffset>& left, const std::vector<ChunkOffset>& right,
+              std::vector<ChunkOffset>& result) const override;
+};
+
+}  // namespace opossum
@@ -0,0 +1,84 @@
+#include "join_filter.hpp"
+
+#include <algorithm>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+void JoinFilter::build(const Table& table, const ColumnID column_id) {
+  Assert(!_is_built, "JoinFilter is already built");
+  Assert(column_id < table.column_count(), "Column ID out of range");
+
+  // The hashes are collected first, so that the size of the Bloom filter can be derived from the number of keys
+  auto hashes = std::vector<uint64_t>{};
+  resolve_data_type(table.column_type(column_id), [&](auto type) {
+    using Type = typename decltype(type)::type;
+    _is_string_filter = std::is_same_v<Type, std::string>;
+
+    const auto add_key = [&](const Type& value) {
+      if constexpr (std::is_arithmetic_v<Type>) {
+        const auto number = static_cast<double>(value);
+        _min_number = hashes.empty() ? number : std::min(_min_number, number);
+        _max_number = hashes.empty() ? number : std::max(_max_number, number);
+      } else {
+        if (hashes.empty() || value < _min_string) _min_string = value;
+        if (hashes.empty() || value > _max_string) _max_string = value;
+      }
+      hashes.push_back(_hash(value));
+    };
+
+    // A dictionary that is shared by consecutive chunks (see Table::use_global_dictionary) is added only once
+    auto previous_dictionary = std::shared_ptr<const std::vector<Type>>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto chunk = table.pin_chunk(chunk_id);
+      const auto chunk_size = chunk->size();
+      if (chunk_size == 0) continue;
+
+      const auto& segment = *chunk->get_segment(column_id);
+      if (const auto dictionary_segment = dynamic_cast<const DictionarySegment<Type>*>(&segment)) {
+        if (dictionary_segment->dictionary() == previous_dictionary) continue;
+        previous_dictionary = dictionary_segment->dictionary();
+        const auto& dictionary = *previous_dictionary;
+        for (const auto& value : dictionary) add_key(value);
+      } else {
+        segment_iterate<Type>(segment, chunk_size, [&](const auto& value, const auto) { add_key(value); });
+      }
+    }
+  });
+
+  std::sort(hashes.begin(), hashes.end());
+  hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+  _key_count = hashes.size();
+
+  auto bit_count = uint64_t{64};
+  while (bit_count < _key_count * BITS_PER_KEY) bit_count *= 2;
+  _bloom_filter.assign(bit_count / 64, 0);
+  _bit_mask = bit_count - 1;
+  for (const auto hash : hashes) _bloom_filter_insert(hash);
+
+  _is_built = true;
+}
+
+bool JoinFilter::is_built() const { return _is_built; }
+
+bool JoinFilter::is_string_filter() const { return _is_string_filter; }
+
+size_t JoinFilter::key_count() const { return _key_count; }
+
+void JoinFilter::_bloom_filter_insert(const uint64_t hash) {
+  const auto step = (hash >> 32) | 1;
+  for (auto index = uint64_t{0}; index < HASH_FUNCTION_COUNT; ++index) {
+    const auto bit = (hash + index * step) & _bit_mask;
+    _bloom_filter[bit / 64] |= uint64_t{1} << (bit % 64);
+  }
+}
+
+}  // namespace opossum
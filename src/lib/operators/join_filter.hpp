@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+/**
+ * Compact summary of the join keys of a join's build side: the range of the keys and a Bloom filter over them. Scans of
+ * the probe side use it to drop rows without a join partner early (see ScanType::OpJoinFilter). may_contain never
+ * misses a key, but may report keys that are not there (about 1% of them with BITS_PER_KEY bits per key).
+ *
+ * Numbers are hashed by their value rather than their type, so that, e.g., an int column can be probed with the keys of
+ * a long column.
+ */
+class JoinFilter {
+ public:
+  // Adds the values of a column of the table. DictionarySegments contribute their dictionaries only.
+  void build(const Table& table, const ColumnID column_id);
+
+  bool is_built() const;
+
+  // Whether the build column holds strings, in which case only strings can be probed
+  bool is_string_filter() const;
+
+  size_t key_count() const;
+
+  template <typename T>
+  bool may_contain(const T& value) const {
+    if (_key_count == 0) return false;
+    if constexpr (std::is_arithmetic_v<T>) {
+      const auto number = static_cast<double>(value);
+      if (number < _min_number || number > _max_number) return false;
+    } else {
+      if (value < _min_string || value > _max_string) return false;
+    }
+    return _bloom_filter_contains(_hash(value));
+  }
+
+  static constexpr auto BITS_PER_KEY = size_t{10};
+  static constexpr auto HASH_FUNCTION_COUNT = uint64_t{4};
+
+ protected:
+  template <typename T>
+  static uint64_t _hash(const T& value) {
+    auto key = uint64_t{0};
+    if constexpr (std::is_integral_v<T>) {
+      key = static_cast<uint64_t>(static_cast<int64_t>(value));
+    } else if constexpr (std::is_floating_point_v<T>) {
+      // Whole numbers are hashed like integers, so that 5.0 finds 5
+      const auto number = static_cast<double>(value);
+      if (number == std::trunc(number) && std::abs(number) < 9e18) {
+        key = static_cast<uint64_t>(static_cast<int64_t>(number));
+      } else {
+        std::memcpy(&key, &number, sizeof(key));
+      }
+    } else {
+      key = std::hash<T>{}(value);
+    }
+
+    // Finalizer of MurmurHash3, so that every input bit affects all bits of the hash
+    key ^= key >> 33;
+    key *= 0xff51afd7ed558ccdULL;
+    key ^= key >> 33;
+    key *= 0xc4ceb9fe1a85ec53ULL;
+    key ^= key >> 33;
+    return key;
+  }
+
+  // The bits of a key are derived from its hash by double hashing
+  bool _bloom_filter_contains(const uint64_t hash) const {
+    const auto step = (hash >> 32) | 1;
+    for (auto index = uint64_t{0}; index < HASH_FUNCTION_COUNT; ++index) {
+      const auto bit = (hash + index * step) & _bit_mask;
+      if (!((_bloom_filter[bit / 64] >> (bit % 64)) & 1)) return false;
+    }
+    return true;
+  }
+
+  void _bloom_filter_insert(const uint64_t hash);
+
+  bool _is_built = false;
+  bool _is_string_filter = false;
+  size_t _key_count = 0;
+
+  double _min_number = 0.0;
+  double _max_number = 0.0;
+  std::string _min_string;
+  std::string _max_string;
+
+  // The number of bits is a power of two, so that bit positions are found by masking
+  std::vector<uint64_t> _bloom_filter;
+  uint64_t _bit_mask = 0;
+};
+
+}  // namespace opossum
@@ -0,0 +1,58 @@
+#include "limit.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+Limit::Limit(const std::shared_ptr<const AbstractOperator>& in, const uint64_t row_count)
+    : AbstractOperator(in), _row_count(row_count) {}
+
+uint64_t Limit::row_count() const { return _row_count; }
+
+std::shared_ptr<const Table> Limit::_on_execute() {
+  const auto input_table = _left_input_table();
+  auto output_table = std::make_shared<Table>(input_table->target_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  auto remaining_row_count = _row_count;
+  for (auto chunk_id = ChunkID{0}; chunk_id < input_table->chunk_count() && remaining_row_count > 0; ++chunk_id) {
+    const auto input_chunk = input_table->pin_chunk(chunk_id);
+    const auto chunk_size = input_chunk->size();
+    if (chunk_size == 0) continue;
+
+    // Whole chunks of ReferenceSegments are forwarded, chunks of values are referenced, so that the output only
+    // references one table (see make_reference_chunk) and does not grow when rows are appended to the input
+    const auto output_row_count = static_cast<ChunkOffset>(std::min(uint64_t{chunk_size}, remaining_row_count));
+    remaining_row_count -= output_row_count;
+    if (output_row_count == chunk_size &&
+        std::dynamic_pointer_cast<const ReferenceSegment>(input_chunk->get_segment(ColumnID{0}))) {
+      auto output_chunk = Chunk{};
+      for (auto column_id = ColumnID{0}; column_id < input_chunk->column_count(); ++column_id) {
+        output_chunk.add_segment(input_chunk->get_segment(column_id));
+      }
+      output_table->emplace_chunk(std::move(output_chunk));
+      continue;
+    }
+
+    auto positions = PosList{};
+    positions.reserve(output_row_count);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < output_row_count; ++chunk_offset) {
+      positions.push_back(RowID{chunk_id, chunk_offset});
+    }
+    output_table->emplace_chunk(make_reference_chunk(input_table, positions));
+  }
+
+  if (output_table->row_count() == 0) output_table->emplace_chunk(make_reference_chunk(input_table, PosList{}));
+
+  return output_table;
+}
+
+}  // namespace opossum
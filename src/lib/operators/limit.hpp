@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Forwards the first row_count rows of the input table as ReferenceSegments. Whole chunks of ReferenceSegments are
+// forwarded by sharing their segments, other chunks and the last chunk are referenced. Chunks after the limit is
+// reached are never looked at.
+class Limit : public AbstractOperator {
+ public:
+  Limit(const std::shared_ptr<const AbstractOperator>& in, const uint64_t row_count);
+
+  uint64_t row_count() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const uint64_t _row_count;
+};
+
+}  // namespace opossum
@@ -0,0 +1,71 @@
+#include "materialize.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+template <typename T>
+std::shared_ptr<BaseSegment> materialize_segment(const ReferenceSegment& segment) {
+  auto values = std::vector<T>(segment.size());
+  segment.gather(values.data());
+  return std::make_shared<ValueSegment<T>>(std::move(values));
+}
+
+}  // namespace
+
+Materialize::Materialize(const std::shared_ptr<const AbstractOperator>& in) : AbstractOperator(in) {}
+
+Materialize::Materialize(const std::shared_ptr<const AbstractOperator>& in, const std::vector<ColumnID>& column_ids)
+    : AbstractOperator(in), _column_ids(column_ids) {}
+
+const std::optional<std::vector<ColumnID>>& Materialize::column_ids() const { return _column_ids; }
+
+std::shared_ptr<const Table> Materialize::_on_execute() {
+  const auto input_table = _left_input_table();
+  auto output_table = std::make_shared<Table>(input_table->target_chunk_size());
+  auto materialize_column = std::vector<bool>(input_table->column_count(), !_column_ids);
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+  if (_column_ids) {
+    for (const auto column_id : *_column_ids) {
+      Assert(column_id < input_table->column_count(), "Column ID out of range");
+      materialize_column[column_id] = true;
+    }
+  }
+
+  auto output_chunks = std::vector<Chunk>(input_table->chunk_count());
+  parallel_for(output_chunks.size(), [&](const size_t chunk_index) {
+    const auto input_chunk = input_table->pin_chunk(ChunkID{static_cast<ChunkID::base_type>(chunk_index)});
+    for (auto column_id = ColumnID{0}; column_id < input_chunk->column_count(); ++column_id) {
+      const auto segment = input_chunk->get_segment(column_id);
+      const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(segment);
+      if (!reference_segment || !materialize_column[column_id]) {
+        output_chunks[chunk_index].add_segment(segment);
+        continue;
+      }
+
+      resolve_data_type(input_table->column_type(column_id), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        output_chunks[chunk_index].add_segment(materialize_segment<Type>(*reference_segment));
+      });
+    }
+  });
+  for (auto& chunk : output_chunks) output_table->emplace_chunk(std::move(chunk));
+
+  return output_table;
+}
+
+}  // namespace opossum
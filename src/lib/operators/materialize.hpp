@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Copies the values of ReferenceSegments into ValueSegments. Operators that read a column many times (e.g., the build
+// side of a join or repeated scans) then access the values sequentially instead of going through a PosList and the
+// referenced chunks for every value. ValueSegments and DictionarySegments of the input are forwarded unchanged.
+// The values are copied by ReferenceSegment::gather, which resolves referenced segments once per chunk and prefetches.
+class Materialize : public AbstractOperator {
+ public:
+  // Materializes all columns
+  explicit Materialize(const std::shared_ptr<const AbstractOperator>& in);
+
+  // Materializes the given columns only, the other columns keep their ReferenceSegments
+  Materialize(const std::shared_ptr<const AbstractOperator>& in, const std::vector<ColumnID>& column_ids);
+
+  const std::optional<std::vector<ColumnID>>& column_ids() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::optional<std::vector<ColumnID>> _column_ids;
+};
+
+}  // namespace opossum
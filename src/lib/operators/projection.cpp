@@ -0,0 +1,55 @@
+#include "projection.hpp"
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expression/expression_evaluator.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+Projection::Projection(const std::shared_ptr<const AbstractOperator>& in, const std::vector<ColumnID>& column_ids)
+    : AbstractOperator(in) {
+  _expressions.reserve(column_ids.size());
+  for (const auto column_id : column_ids) _expressions.push_back(std::make_shared<ColumnExpression>(column_id));
+}
+
+Projection::Projection(const std::shared_ptr<const AbstractOperator>& in,
+                       const std::vector<std::shared_ptr<AbstractExpression>>& expressions)
+    : AbstractOperator(in), _expressions(expressions) {}
+
+const std::vector<std::shared_ptr<AbstractExpression>>& Projection::expressions() const { return _expressions; }
+
+std::shared_ptr<const Table> Projection::_on_execute() {
+  const auto input_table = _left_input_table();
+  auto output_table = std::make_shared<Table>(input_table->target_chunk_size());
+  for (const auto& expression : _expressions) {
+    output_table->add_column_definition(expression->description(*input_table), expression->data_type(*input_table));
+  }
+
+  auto output_chunks = std::vector<Chunk>(input_table->chunk_count());
+  parallel_for(output_chunks.size(), [&](const size_t chunk_index) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+    const auto input_chunk = input_table->pin_chunk(chunk_id);
+    auto evaluator = ExpressionEvaluator{input_table, chunk_id};
+    for (const auto& expression : _expressions) {
+      // The segments of mutable chunks keep growing, so their columns are copied up to the chunk size that the
+      // evaluator read, like the computed columns of the chunk
+      const auto column_expression = std::dynamic_pointer_cast<ColumnExpression>(expression);
+      if (column_expression && !input_chunk->is_mutable()) {
+        output_chunks[chunk_index].add_segment(input_chunk->get_segment(column_expression->column_id));
+      } else {
+        output_chunks[chunk_index].add_segment(evaluator.evaluate_to_segment(*expression));
+      }
+    }
+  });
+  for (auto& chunk : output_chunks) output_table->emplace_chunk(std::move(chunk));
+
+  return output_table;
+}
+
+}  // namespace opossum
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "expression/expressions.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Computes one output column per expression. Columns that are only referenced (i.e., ColumnExpressions) share the
+// segments of the input chunks (including ReferenceSegments), so no values are copied for them, except for mutable
+// chunks, whose rows are copied so that the output does not grow. All other expressions are computed into new
+// ValueSegments by the ExpressionEvaluator.
+class Projection : public AbstractOperator {
+ public:
+  // Selects a subset of the input columns, possibly reordered or repeated
+  Projection(const std::shared_ptr<const AbstractOperator>& in, const std::vector<ColumnID>& column_ids);
+
+  Projection(const std::shared_ptr<const AbstractOperator>& in,
+             const std::vector<std::shared_ptr<AbstractExpression>>& expressions);
+
+  const std::vector<std::shared_ptr<AbstractExpression>>& expressions() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  std::vector<std::shared_ptr<AbstractExpression>> _expressions;
+};
+
+}  // namespace opossum
@@ -0,0 +1,391 @@
+#include "sort.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <queue>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/fixed_size_attribute_vector.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Strings are represented by their rank among all strings of the column
+using StringRank = uint32_t;
+
+template <typename T>
+constexpr size_t normalized_key_width() {
+  return std::is_same_v<T, std::string> ? sizeof(StringRank) : sizeof(T);
+}
+
+// Maps a number to an unsigned integer of the same width whose (unsigned) order is the order of the numbers
+template <typename T>
+auto normalize(const T value) {
+  if constexpr (std::is_integral_v<T>) {
+    using Unsigned = std::make_unsigned_t<T>;
+    return static_cast<Unsigned>(static_cast<Unsigned>(value) ^ (Unsigned{1} << (sizeof(T) * 8 - 1)));
+  } else {
+    using Unsigned = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    auto bits = Unsigned{};
+    std::memcpy(&bits, &value, sizeof(T));
+    // Negative numbers have the sign bit set and are ordered inversely, so all of their bits are flipped
+    const auto sign_bit = Unsigned{1} << (sizeof(T) * 8 - 1);
+    return static_cast<Unsigned>((bits & sign_bit) ? ~bits : bits ^ sign_bit);
+  }
+}
+
+// Writes the normalized value in big-endian byte order, so that memcmp compares the most significant byte first
+template <typename Unsigned>
+void write_key(uint8_t* key, Unsigned value, const OrderByMode order_by_mode) {
+  if (order_by_mode == OrderByMode::Descending) value = static_cast<Unsigned>(~value);
+  for (auto byte_index = sizeof(Unsigned); byte_index > 0; --byte_index) {
+    key[byte_index - 1] = static_cast<uint8_t>(value);
+    value = static_cast<Unsigned>(value >> 8);
+  }
+}
+
+// The records that are sorted. Each record holds the normalized key of a row followed by the row's RowID.
+struct KeyLayout {
+  size_t key_width;
+  size_t record_size;
+
+  const uint8_t* record(const uint8_t* records, const size_t index) const { return records + index * record_size; }
+
+  RowID row_id(const uint8_t* record) const {
+    auto row_id = RowID{};
+    std::memcpy(&row_id, record + key_width, sizeof(RowID));
+    return row_id;
+  }
+
+  bool less(const uint8_t* lhs, const uint8_t* rhs) const { return std::memcmp(lhs, rhs, key_width) < 0; }
+};
+
+// Returns the number of rows of a chunk when the sort started, which bounds all reads of the chunk, as rows can still
+// be appended to the last chunk while the table is sorted
+ChunkOffset snapshot_chunk_size(const std::vector<size_t>& first_row_of_chunk, const size_t chunk_index) {
+  return static_cast<ChunkOffset>(first_row_of_chunk[chunk_index + 1] - first_row_of_chunk[chunk_index]);
+}
+
+// The chunks of the input table, pinned once per execution. All passes over a column read the same chunks, so a chunk
+// that is replaced in between (e.g., by a DeltaMerger or use_global_dictionary) cannot bring in values that the
+// earlier passes did not see.
+using PinnedChunks = std::vector<std::shared_ptr<const Chunk>>;
+
+// Returns, per chunk, a table that maps the value ids of a DictionarySegment<std::string> to the rank of the value in
+// the column. Chunks that are not dictionary-encoded get an empty table. The sorted dictionaries are merged with the
+// sorted list of all strings of the column, so no string has to be compared more than once per chunk.
+std::vector<std::vector<StringRank>> string_ranks_by_value_id(const PinnedChunks& chunks, const ColumnID column_id,
+                                                              const std::vector<size_t>& first_row_of_chunk,
+                                                              std::vector<std::string>& all_strings) {
+  const auto chunk_count = chunks.size();
+
+  // A dictionary that is shared by consecutive chunks (see Table::use_global_dictionary) is added only once
+  auto previous_dictionary = std::shared_ptr<const std::vector<std::string>>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk_size = snapshot_chunk_size(first_row_of_chunk, chunk_id);
+    if (chunk_size == 0) continue;
+
+    const auto& segment = *chunks[chunk_id]->get_segment(column_id);
+    if (const auto dictionary_segment = dynamic_cast<const DictionarySegment<std::string>*>(&segment)) {
+      // Holding the dictionary keeps a freed dictionary from being mistaken for one allocated at the same address
+      if (dictionary_segment->dictionary() == previous_dictionary) continue;
+      previous_dictionary = dictionary_segment->dictionary();
+      const auto& dictionary = *previous_dictionary;
+      all_strings.insert(all_strings.end(), dictionary.cbegin(), dictionary.cend());
+    } else {
+      segment_iterate<std::string>(segment, chunk_size,
+                                   [&](const auto& value, const auto) { all_strings.push_back(value); });
+    }
+  }
+  std::sort(all_strings.begin(), all_strings.end());
+  all_strings.erase(std::unique(all_strings.begin(), all_strings.end()), all_strings.end());
+
+  auto ranks = std::vector<std::vector<StringRank>>(chunk_count);
+  parallel_for(chunk_count, [&](const size_t chunk_index) {
+    if (snapshot_chunk_size(first_row_of_chunk, chunk_index) == 0) return;
+
+    const auto& segment = *chunks[chunk_index]->get_segment(column_id);
+    const auto dictionary_segment = dynamic_cast<const DictionarySegment<std::string>*>(&segment);
+    if (!dictionary_segment) return;
+
+    const auto& dictionary = *dictionary_segment->dictionary();
+    auto& chunk_ranks = ranks[chunk_index];
+    chunk_ranks.reserve(dictionary.size());
+    auto rank = StringRank{0};
+    for (const auto& value : dictionary) {
+      while (all_strings[rank] != value) ++rank;
+      chunk_ranks.push_back(rank);
+    }
+  });
+
+  return ranks;
+}
+
+// Writes the normalized keys of one sort column into the records, starting at key_offset within each record
+template <typename T>
+void encode_column(const PinnedChunks& chunks, const ColumnID column_id, const OrderByMode order_by_mode,
+                   const size_t key_offset, const KeyLayout& layout, const std::vector<size_t>& first_row_of_chunk,
+                   uint8_t* records) {
+  auto all_strings = std::vector<std::string>{};
+  auto ranks = std::vector<std::vector<StringRank>>{};
+  if constexpr (std::is_same_v<T, std::string>) {
+    ranks = string_ranks_by_value_id(chunks, column_id, first_row_of_chunk, all_strings);
+  }
+
+  parallel_for(chunks.size(), [&](const size_t chunk_index) {
+    const auto chunk_size = snapshot_chunk_size(first_row_of_chunk, chunk_index);
+    if (chunk_size == 0) return;
+
+    const auto& segment = *chunks[chunk_index]->get_segment(column_id);
+    auto* chunk_records = records + first_row_of_chunk[chunk_index] * layout.record_size + key_offset;
+
+    if constexpr (std::is_same_v<T, std::string>) {
+      if (const auto dictionary_segment = dynamic_cast<const DictionarySegment<std::string>*>(&segment)) {
+        // Sort on value ids: their order is the order of the values, we only need to align them across chunks
+        const auto& chunk_ranks = ranks[chunk_index];
+        resolve_attribute_vector(*dictionary_segment->attribute_vector(), [&](const auto& value_ids) {
+          for (auto chunk_offset = size_t{0}; chunk_offset < chunk_size; ++chunk_offset) {
+            write_key(chunk_records + chunk_offset * layout.record_size, chunk_ranks[value_ids[chunk_offset]],
+                      order_by_mode);
+          }
+        });
+        return;
+      }
+
+      segment_iterate<std::string>(segment, chunk_size, [&](const auto& value, const auto chunk_offset) {
+        const auto rank = std::lower_bound(all_strings.cbegin(), all_strings.cend(), value) - all_strings.cbegin();
+        write_key(chunk_records + chunk_offset * layout.record_size, static_cast<StringRank>(rank), order_by_mode);
+      });
+    } else {
+      segment_iterate<T>(segment, chunk_size, [&](const auto value, const auto chunk_offset) {
+        write_key(chunk_records + chunk_offset * layout.record_size, normalize(value), order_by_mode);
+      });
+    }
+  });
+}
+
+// Sorts a run of records by their keys using a stable LSD radix sort with one pass per key byte. Passes in which all
+// records have the same byte (e.g., the high bytes of small integers) are skipped.
+void radix_sort_run(uint8_t* records, uint8_t* scratch, const size_t record_count, const KeyLayout& layout) {
+  auto* source = records;
+  auto* target = scratch;
+
+  for (auto byte_index = layout.key_width; byte_index > 0; --byte_index) {
+    auto bucket_offsets = std::array<size_t, 256>{};
+    for (auto record_index = size_t{0}; record_index < record_count; ++record_index) {
+      ++bucket_offsets[source[record_index * layout.record_size + byte_index - 1]];
+    }
+    if (std::find(bucket_offsets.cbegin(), bucket_offsets.cend(), record_count) != bucket_offsets.cend()) continue;
+
+    auto offset = size_t{0};
+    for (auto& bucket_offset : bucket_offsets) {
+      const auto bucket_size = bucket_offset;
+      bucket_offset = offset;
+      offset += bucket_size;
+    }
+
+    for (auto record_index = size_t{0}; record_index < record_count; ++record_index) {
+      const auto* record = source + record_index * layout.record_size;
+      const auto target_index = bucket_offsets[record[byte_index - 1]]++;
+      std::memcpy(target + target_index * layout.record_size, record, layout.record_size);
+    }
+    std::swap(source, target);
+  }
+
+  if (source != records) std::memcpy(records, source, record_count * layout.record_size);
+}
+
+// Merges the sorted runs into the output positions. The key space is split into one range per thread by splitters
+// that are sampled from the runs, and each thread k-way merges its range of all runs with a heap. Records with equal
+// keys are taken from earlier runs first, so the merge is stable, too.
+void merge_runs(const uint8_t* records, const std::vector<size_t>& run_begins, const KeyLayout& layout,
+                PosList& positions) {
+  const auto run_count = run_begins.size() - 1;
+
+  // Take run_count evenly spaced samples from each run and pick every run_count-th of the sorted samples as splitter
+  auto samples = std::vector<const uint8_t*>{};
+  for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+    const auto run_size = run_begins[run_index + 1] - run_begins[run_index];
+    for (auto sample_index = size_t{0}; sample_index < run_count; ++sample_index) {
+      samples.push_back(layout.record(records, run_begins[run_index] + sample_index * run_size / run_count));
+    }
+  }
+  std::sort(samples.begin(), samples.end(), [&](const auto lhs, const auto rhs) { return layout.less(lhs, rhs); });
+
+  const auto partition_count = run_count;
+  auto splitters = std::vector<const uint8_t*>{};
+  for (auto partition_index = size_t{1}; partition_index < partition_count; ++partition_index) {
+    splitters.push_back(samples[partition_index * run_count]);
+  }
+
+  // partition_bounds[run_index][partition_index] is the first record of the run that belongs to the partition
+  auto partition_bounds = std::vector<std::vector<size_t>>(run_count);
+  for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+    auto& bounds = partition_bounds[run_index];
+    bounds.push_back(run_begins[run_index]);
+    for (const auto splitter : splitters) {
+      auto low = bounds.back();
+      auto high = run_begins[run_index + 1];
+      while (low < high) {
+        const auto middle = low + (high - low) / 2;
+        if (layout.less(layout.record(records, middle), splitter)) {
+          low = middle + 1;
+        } else {
+          high = middle;
+        }
+      }
+      bounds.push_back(low);
+    }
+    bounds.push_back(run_begins[run_index + 1]);
+  }
+
+  auto partition_output_offsets = std::vector<size_t>(partition_count + 1);
+  for (auto partition_index = size_t{0}; partition_index < partition_count; ++partition_index) {
+    auto partition_size = size_t{0};
+    for (const auto& bounds : partition_bounds) partition_size += bounds[partition_index + 1] - bounds[partition_index];
+    partition_output_offsets[partition_index + 1] = partition_output_offsets[partition_index] + partition_size;
+  }
+
+  parallel_for(partition_count, [&](const size_t partition_index) {
+    // The heap holds the next record index of each run. It is a min-heap ordered by key and, for stability, run index.
+    using HeapEntry = std::pair<size_t, size_t>;
+    const auto greater = [&](const HeapEntry& lhs, const HeapEntry& rhs) {
+      const auto comparison = std::memcmp(layout.record(records, lhs.first), layout.record(records, rhs.first),
+                                          layout.key_width);
+      return comparison > 0 || (comparison == 0 && lhs.second > rhs.second);
+    };
+    auto heap = std::priority_queue<HeapEntry, std::vector<HeapEntry>, decltype(greater)>{greater};
+
+    for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+      const auto& bounds = partition_bounds[run_index];
+      if (bounds[partition_index] < bounds[partition_index + 1]) heap.emplace(bounds[partition_index], run_index);
+    }
+
+    auto output_index = partition_output_offsets[partition_index];
+    while (!heap.empty()) {
+      const auto [record_index, run_index] = heap.top();
+      heap.pop();
+      positions[output_index++] = layout.row_id(layout.record(records, record_index));
+      if (record_index + 1 < partition_bounds[run_index][partition_index + 1]) {
+        heap.emplace(record_index + 1, run_index);
+      }
+    }
+  });
+}
+
+}  // namespace
+
+Sort::Sort(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions)
+    : AbstractOperator(in), _sort_definitions(sort_definitions) {
+  Assert(!_sort_definitions.empty(), "Sort requires at least one sort column");
+}
+
+const std::vector<SortColumnDefinition>& Sort::sort_definitions() const { return _sort_definitions; }
+
+std::shared_ptr<const Table> Sort::_on_execute() {
+  const auto input_table = _left_input_table();
+  const auto chunk_count = input_table->chunk_count();
+
+  auto output_table = std::make_shared<Table>(input_table->target_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  // Enumerate the rows chunk by chunk: row i of the table is record i. The chunks are pinned and their sizes are read
+  // only here, all later reads of a chunk go to the pinned chunk and are bounded by its size (see snapshot_chunk_size).
+  auto chunks = PinnedChunks(chunk_count);
+  auto first_row_of_chunk = std::vector<size_t>(chunk_count + 1);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    chunks[chunk_id] = input_table->pin_chunk(chunk_id);
+    first_row_of_chunk[chunk_id + 1] = first_row_of_chunk[chunk_id] + chunks[chunk_id]->size();
+  }
+  const auto row_count = first_row_of_chunk.back();
+  if (row_count == 0) {
+    output_table->emplace_chunk(make_reference_chunk(input_table, PosList{}));
+    return output_table;
+  }
+
+  auto layout = KeyLayout{0, 0};
+  for (const auto& sort_definition : _sort_definitions) {
+    resolve_data_type(input_table->column_type(sort_definition.column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      layout.key_width += normalized_key_width<Type>();
+    });
+  }
+  layout.record_size = layout.key_width + sizeof(RowID);
+
+  auto records = std::vector<uint8_t>(row_count * layout.record_size);
+  parallel_for(chunk_count, [&](const size_t chunk_index) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+    const auto chunk_size = snapshot_chunk_size(first_row_of_chunk, chunk_index);
+    auto* chunk_records = records.data() + first_row_of_chunk[chunk_index] * layout.record_size;
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      const auto row_id = RowID{chunk_id, chunk_offset};
+      std::memcpy(chunk_records + chunk_offset * layout.record_size + layout.key_width, &row_id, sizeof(RowID));
+    }
+  });
+
+  auto key_offset = size_t{0};
+  for (const auto& sort_definition : _sort_definitions) {
+    resolve_data_type(input_table->column_type(sort_definition.column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      encode_column<Type>(chunks, sort_definition.column_id, sort_definition.order_by_mode, key_offset, layout,
+                          first_row_of_chunk, records.data());
+      key_offset += normalized_key_width<Type>();
+    });
+  }
+
+  // Split the records into runs of (almost) equal size, sort each run in its own thread and merge the runs
+  const auto run_count = std::clamp(row_count / MIN_ROWS_PER_RUN, size_t{1}, worker_count());
+  auto run_begins = std::vector<size_t>(run_count + 1);
+  for (auto run_index = size_t{0}; run_index <= run_count; ++run_index) {
+    run_begins[run_index] = run_index * row_count / run_count;
+  }
+
+  auto scratch = std::vector<uint8_t>(records.size());
+  parallel_for(run_count, [&](const size_t run_index) {
+    const auto offset = run_begins[run_index] * layout.record_size;
+    radix_sort_run(records.data() + offset, scratch.data() + offset, run_begins[run_index + 1] - run_begins[run_index],
+                   layout);
+  });
+  scratch = std::vector<uint8_t>{};
+
+  auto positions = PosList(row_count);
+  if (run_count == 1) {
+    for (auto row_index = size_t{0}; row_index < row_count; ++row_index) {
+      positions[row_index] = layout.row_id(layout.record(records.data(), row_index));
+    }
+  } else {
+    merge_runs(records.data(), run_begins, layout, positions);
+  }
+  records = std::vector<uint8_t>{};
+
+  // Cut the sorted positions into output chunks of the input's target chunk size
+  const auto output_chunk_size = std::max(size_t{1}, static_cast<size_t>(input_table->target_chunk_size()));
+  const auto output_chunk_count = (row_count + output_chunk_size - 1) / output_chunk_size;
+  auto output_chunks = std::vector<Chunk>(output_chunk_count);
+  parallel_for(output_chunk_count, [&](const size_t output_chunk_index) {
+    const auto begin = positions.cbegin() + static_cast<ptrdiff_t>(output_chunk_index * output_chunk_size);
+    const auto end = positions.cbegin() + static_cast<ptrdiff_t>(std::min(row_count, (output_chunk_index + 1) *
+                                                                                          output_chunk_size));
+    output_chunks[output_chunk_index] = make_reference_chunk(input_table, PosList(begin, end));
+  });
+  for (auto& chunk : output_chunks) output_table->emplace_chunk(std::move(chunk));
+
+  return output_table;
+}
+
+}  // namespace opossum
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+struct SortColumnDefinition {
+  ColumnID column_id;
+  OrderByMode order_by_mode = OrderByMode::Ascending;
+};
+
+// Sorts the input table by one or more columns. The sort is stable, i.e., rows with equal keys keep their input order.
+//
+// The sort columns of each row are encoded into a normalized key, a byte string whose memcmp order is the requested
+// order (big-endian integers with flipped sign bits, IEEE floats with flipped bits, ranks for strings). The keys are
+// sorted in runs of roughly equal size by LSD radix sort, one run per thread, and the runs are then merged by a
+// parallel k-way merge, where each thread produces one key range of the output. For strings, the rank is derived from
+// the sorted dictionaries of DictionarySegments (i.e., from value ids) wherever possible.
+//
+// The output consists of ReferenceSegments, so no values are copied.
+class Sort : public AbstractOperator {
+ public:
+  Sort(const std::shared_ptr<const AbstractOperator>& in, const std::vector<SortColumnDefinition>& sort_definitions);
+
+  const std::vector<SortColumnDefinition>& sort_definitions() const;
+
+  // Inputs with fewer rows per thread are sorted in fewer runs, since merging would not pay off
+  static constexpr auto MIN_ROWS_PER_RUN = size_t{1} << 14;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<SortColumnDefinition> _sort_definitions;
+};
+
+}  // namespace opossum
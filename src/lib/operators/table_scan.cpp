@@ -0,0 +1,616 @@
+#include "table_scan.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <regex>
+#include <string>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "join_filter.hpp"
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/fixed_size_attribute_vector.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Passes the std comparison functor that belongs to a ScanType on to a generic lambda, so that the comparison is
+// resolved once per segment instead of once per value
+template <typename Functor>
+void with_comparator(const ScanType scan_type, const Functor& func) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return func(std::equal_to<>{});
+    case ScanType::OpNotEquals:
+      return func(std::not_equal_to<>{});
+    case ScanType::OpLessThan:
+      return func(std::less<>{});
+    case ScanType::OpLessThanEquals:
+      return func(std::less_equal<>{});
+    case ScanType::OpGreaterThan:
+      return func(std::greater<>{});
+    case ScanType::OpGreaterThanEquals:
+      return func(std::greater_equal<>{});
+    case ScanType::OpBetween:
+    case ScanType::OpIn:
+    case ScanType::OpLike:
+    case ScanType::OpJoinFilter:
+      break;
+  }
+  Fail("Unsupported ScanType");
+}
+
+// Rough share of qualifying rows, used to order predicates on segments without a dictionary to look at
+float default_selectivity(const ScanType scan_type) {
+  switch (scan_type) {
+    case ScanType::OpEquals:
+      return 0.05f;
+    case ScanType::OpNotEquals:
+      return 0.95f;
+    case ScanType::OpBetween:
+      return 0.25f;
+    case ScanType::OpIn:
+    case ScanType::OpLike:
+    case ScanType::OpJoinFilter:
+      return 0.1f;
+    default:
+      return 0.5f;
+  }
+}
+
+// IN-lists up to this length are checked by comparing with every list value, longer ones through a hash set
+constexpr auto MAX_LINEAR_IN_VALUES = size_t{16};
+
+// Matches strings against SQL LIKE patterns, where % stands for any sequence of characters and _ for any single
+// character. Patterns that only have % at their ends (e.g., 'prefix%' or '%infix%') are matched without std::regex.
+class LikeMatcher {
+ public:
+  explicit LikeMatcher(const std::string& pattern) {
+    const auto inner_begin = pattern.find_first_not_of('%');
+    const auto inner_end = pattern.find_last_not_of('%');
+    const auto inner = inner_begin == std::string::npos ? std::string{}
+                                                        : pattern.substr(inner_begin, inner_end - inner_begin + 1);
+    const auto leading_wildcard = !pattern.empty() && inner_begin != 0;
+    const auto trailing_wildcard =
+        !pattern.empty() && (inner_begin == std::string::npos || inner_end != pattern.size() - 1);
+
+    if (inner.find_first_of("%_") == std::string::npos) {
+      _literal = inner;
+      _kind = leading_wildcard ? (trailing_wildcard ? Kind::Contains : Kind::EndsWith)
+                               : (trailing_wildcard ? Kind::StartsWith : Kind::Equals);
+      return;
+    }
+
+    _kind = Kind::Regex;
+    auto regex_string = std::string{};
+    for (const auto character : pattern) {
+      if (character == '%') {
+        regex_string += "[\\s\\S]*";
+      } else if (character == '_') {
+        regex_string += "[\\s\\S]";
+      } else {
+        if (std::string{"\\^$.|?*+()[]{}"}.find(character) != std::string::npos) regex_string += '\\';
+        regex_string += character;
+      }
+    }
+    _regex = std::regex{regex_string};
+  }
+
+  // Returns the fixed prefix of patterns of the form 'prefix%', whose matches form a range in a sorted dictionary
+  std::optional<std::string> prefix() const {
+    return _kind == Kind::StartsWith ? std::optional<std::string>{_literal} : std::nullopt;
+  }
+
+  bool matches(const std::string& value) const {
+    switch (_kind) {
+      case Kind::Equals:
+        return value == _literal;
+      case Kind::StartsWith:
+        return value.compare(0, _literal.size(), _literal) == 0;
+      case Kind::EndsWith:
+        return value.size() >= _literal.size() &&
+               value.compare(value.size() - _literal.size(), _literal.size(), _literal) == 0;
+      case Kind::Contains:
+        return value.find(_literal) != std::string::npos;
+      case Kind::Regex:
+        return std::regex_match(value, _regex);
+    }
+    Fail("Unknown kind of LIKE pattern");
+  }
+
+ protected:
+  enum class Kind { Equals, StartsWith, EndsWith, Contains, Regex };
+
+  Kind _kind;
+  std::string _literal;
+  std::regex _regex;
+};
+
+// The value ids that satisfy a predicate on a DictionarySegment. Because the dictionary is sorted, they form the range
+// [begin, end) for comparisons, BETWEEN and prefix LIKEs, which is inverted for OpNotEquals.
+struct ValueIDRange {
+  ValueID::base_type begin;
+  ValueID::base_type end;
+  bool inverted;
+
+  // Value ids below begin wrap around to large numbers, so a single comparison checks both bounds
+  bool matches(const ValueID::base_type value_id) const { return (value_id - begin < end - begin) != inverted; }
+};
+
+}  // namespace
+
+// Evaluates one predicate on the chunks of a table. Instances are created once per scan, so that the search values
+// are converted to the data type of the column only once.
+class BaseTableScanImpl {
+ public:
+  virtual ~BaseTableScanImpl() = default;
+
+  // Returns the estimated share of rows of the chunk that satisfy the predicate
+  virtual float estimate_selectivity(const Chunk& chunk) const = 0;
+
+  // Appends the chunk offsets of all rows of the chunk that satisfy the predicate to matches. chunk_size is the size of
+  // the chunk when the scan started, rows appended after that are not visited.
+  virtual void scan(const Chunk& chunk, const ChunkOffset chunk_size, std::vector<ChunkOffset>& matches) const = 0;
+
+  // Removes the chunk offsets of rows that do not satisfy the predicate from matches
+  virtual void filter(const Chunk& chunk, const ChunkOffset chunk_size, std::vector<ChunkOffset>& matches) const = 0;
+};
+
+namespace {
+
+template <typename T>
+class TableScanImpl : public BaseTableScanImpl {
+ public:
+  explicit TableScanImpl(const ScanPredicate& predicate)
+      : _column_id(predicate.column_id),
+        _scan_type(predicate.scan_type),
+        _search_value(predicate.scan_type == ScanType::OpIn || predicate.scan_type == ScanType::OpJoinFilter
+                          ? T{}
+                          : type_cast<T>(predicate.search_value)),
+        _upper_value(predicate.scan_type == ScanType::OpBetween ? type_cast<T>(predicate.upper_value) : T{}),
+        _join_filter(predicate.join_filter) {
+    if (_scan_type == ScanType::OpJoinFilter) {
+      Assert(_join_filter && _join_filter->is_built(), "JoinFilter has to be built before the scan executes");
+      constexpr auto is_string_column = std::is_same_v<T, std::string>;
+      Assert(_join_filter->is_string_filter() == is_string_column,
+             "Numbers can only be probed with numbers and strings with strings");
+    }
+    if (_scan_type == ScanType::OpIn) {
+      for (const auto& value : predicate.in_values) _in_values.push_back(type_cast<T>(value));
+      std::sort(_in_values.begin(), _in_values.end());
+      _in_values.erase(std::unique(_in_values.begin(), _in_values.end()), _in_values.end());
+      if (_in_values.size() > MAX_LINEAR_IN_VALUES) _in_value_set.insert(_in_values.cbegin(), _in_values.cend());
+    }
+    if constexpr (std::is_same_v<T, std::string>) {
+      if (_scan_type == ScanType::OpLike) _like_matcher.emplace(_search_value);
+    }
+  }
+
+  float estimate_selectivity(const Chunk& chunk) const override {
+    const auto dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(chunk.get_segment(_column_id).get());
+    if (!dictionary_segment) return default_selectivity(_scan_type);
+
+    // Assumes that all values of the dictionary occur equally often
+    const auto unique_values_count = dictionary_segment->unique_values_count();
+    if (unique_values_count == 0) return 0.0f;
+    if (_uses_value_id_bitset()) {
+      // Building the bitset may be as expensive as the scan itself, so IN-lists are assumed to be found and all other
+      // predicates fall back to the default
+      if (_scan_type != ScanType::OpIn) return default_selectivity(_scan_type);
+      return std::min(1.0f, static_cast<float>(_in_values.size()) / static_cast<float>(unique_values_count));
+    }
+
+    const auto range = _value_id_range(*dictionary_segment);
+    const auto begin = std::min(size_t{range.begin}, unique_values_count);
+    const auto end = std::max(begin, std::min(size_t{range.end}, unique_values_count));
+    const auto share = static_cast<float>(end - begin) / static_cast<float>(unique_values_count);
+    return range.inverted ? 1.0f - share : share;
+  }
+
+  void scan(const Chunk& chunk, const ChunkOffset chunk_size, std::vector<ChunkOffset>& matches) const override {
+    const auto& segment = *chunk.get_segment(_column_id);
+    if (const auto dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment)) {
+      _with_value_id_matcher(*dictionary_segment, [&](const auto& matcher) {
+        resolve_attribute_vector(*dictionary_segment->attribute_vector(), [&](const auto& value_ids) {
+          for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+            if (matcher(value_ids[chunk_offset])) matches.push_back(chunk_offset);
+          }
+        });
+      });
+      return;
+    }
+
+    _with_matcher([&](const auto& matcher) {
+      segment_iterate<T>(segment, chunk_size, [&](const auto& value, const auto chunk_offset) {
+        if (matcher(value)) matches.push_back(chunk_offset);
+      });
+    });
+  }
+
+  void filter(const Chunk& chunk, const ChunkOffset chunk_size, std::vector<ChunkOffset>& matches) const override {
+    const auto& segment = *chunk.get_segment(_column_id);
+    // Compacts matches in place, the write position never overtakes the read position
+    auto match_count = size_t{0};
+    if (const auto dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment)) {
+      _with_value_id_matcher(*dictionary_segment, [&](const auto& matcher) {
+        resolve_attribute_vector(*dictionary_segment->attribute_vector(), [&](const auto& value_ids) {
+          for (const auto chunk_offset : matches) {
+            if (matcher(value_ids[chunk_offset])) matches[match_count++] = chunk_offset;
+          }
+        });
+      });
+    } else {
+      _with_matcher([&](const auto& matcher) {
+        segment_iterate<T>(segment, matches, [&](const auto& value, const auto chunk_offset) {
+          if (matcher(value)) matches[match_count++] = chunk_offset;
+        });
+      });
+    }
+    matches.resize(match_count);
+  }
+
+ protected:
+  // IN-lists, join filters and LIKE patterns other than prefix searches do not match a contiguous range of value ids
+  bool _uses_value_id_bitset() const {
+    return _scan_type == ScanType::OpIn || _scan_type == ScanType::OpJoinFilter ||
+           (_scan_type == ScanType::OpLike && !_like_matcher->prefix());
+  }
+
+  // Passes a lambda that checks a single value id on to func. The predicate is evaluated on the dictionary once, so
+  // that the attribute vector is scanned by looking up value ids in a range or a bitset only.
+  template <typename Functor>
+  void _with_value_id_matcher(const DictionarySegment<T>& segment, const Functor& func) const {
+    if (!_uses_value_id_bitset()) {
+      const auto range = _value_id_range(segment);
+      func([&](const ValueID::base_type value_id) { return range.matches(value_id); });
+      return;
+    }
+
+    const auto& dictionary = *segment.dictionary();
+    auto bitset = std::vector<bool>(dictionary.size());
+    if (_scan_type == ScanType::OpIn) {
+      for (const auto& value : _in_values) {
+        const auto value_id = segment.lower_bound(value);
+        if (value_id != INVALID_VALUE_ID && dictionary[value_id] == value) bitset[value_id] = true;
+      }
+    } else if (_scan_type == ScanType::OpJoinFilter) {
+      for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+        bitset[value_id] = _join_filter->may_contain(dictionary[value_id]);
+      }
+    } else if constexpr (std::is_same_v<T, std::string>) {
+      for (auto value_id = size_t{0}; value_id < dictionary.size(); ++value_id) {
+        bitset[value_id] = _like_matcher->matches(dictionary[value_id]);
+      }
+    }
+    func([&](const ValueID::base_type value_id) { return bitset[value_id]; });
+  }
+
+  // Translates the search values into value ids once per segment. Since INVALID_VALUE_ID is the largest possible
+  // ValueID, search values outside of the dictionary need no special handling.
+  ValueIDRange _value_id_range(const DictionarySegment<T>& segment) const {
+    const auto lower_bound = segment.lower_bound(_search_value).t;
+    const auto upper_bound = segment.upper_bound(_search_value).t;
+    const auto value_found =
+        lower_bound != INVALID_VALUE_ID && segment.value_by_value_id(ValueID{lower_bound}) == _search_value;
+
+    switch (_scan_type) {
+      case ScanType::OpEquals:
+        return value_found ? ValueIDRange{lower_bound, lower_bound + 1, false} : ValueIDRange{0, 0, false};
+      case ScanType::OpNotEquals:
+        return value_found ? ValueIDRange{lower_bound, lower_bound + 1, true} : ValueIDRange{0, 0, true};
+      case ScanType::OpLessThan:
+        return ValueIDRange{0, lower_bound, false};
+      case ScanType::OpLessThanEquals:
+        return ValueIDRange{0, upper_bound, false};
+      case ScanType::OpGreaterThan:
+        return ValueIDRange{upper_bound, INVALID_VALUE_ID, false};
+      case ScanType::OpGreaterThanEquals:
+        return ValueIDRange{lower_bound, INVALID_VALUE_ID, false};
+      case ScanType::OpBetween:
+        return ValueIDRange{lower_bound, std::max(lower_bound, segment.upper_bound(_upper_value).t), false};
+      case ScanType::OpLike:
+        if constexpr (std::is_same_v<T, std::string>) {
+          // All values with the prefix directly follow the first value that is not smaller than the prefix
+          const auto& dictionary = *segment.dictionary();
+          const auto& prefix = *_like_matcher->prefix();
+          const auto begin = std::lower_bound(dictionary.cbegin(), dictionary.cend(), prefix);
+          const auto end = std::partition_point(begin, dictionary.cend(), [&](const auto& value) {
+            return value.compare(0, prefix.size(), prefix) == 0;
+          });
+          return ValueIDRange{static_cast<ValueID::base_type>(begin - dictionary.cbegin()),
+                              static_cast<ValueID::base_type>(end - dictionary.cbegin()), false};
+        }
+        break;
+      case ScanType::OpIn:
+      case ScanType::OpJoinFilter:
+        break;
+    }
+    Fail("Unsupported ScanType");
+  }
+
+  // Passes a lambda that checks a single value on to func, so that the scan type is resolved once per segment
+  template <typename Functor>
+  void _with_matcher(const Functor& func) const {
+    switch (_scan_type) {
+      case ScanType::OpBetween:
+        return func([&](const T& value) { return _search_value <= value && value <= _upper_value; });
+      case ScanType::OpIn:
+        if (_in_values.size() > MAX_LINEAR_IN_VALUES) {
+          return func([&](const T& value) { return _in_value_set.count(value) > 0; });
+        }
+        // Compares with all list values without an early exit, which the compiler can vectorize for numbers
+        return func([&](const T& value) {
+          auto found = false;
+          for (const auto& in_value : _in_values) found |= in_value == value;
+          return found;
+        });
+      case ScanType::OpLike:
+        if constexpr (std::is_same_v<T, std::string>) {
+          return func([&](const T& value) { return _like_matcher->matches(value); });
+        }
+        Fail("LIKE is only supported on strings");
+      case ScanType::OpJoinFilter:
+        return func([&](const T& value) { return _join_filter->may_contain(value); });
+      default:
+        with_comparator(_scan_type, [&](const auto& comparator) {
+          func([&](const T& value) { return comparator(value, _search_value); });
+        });
+    }
+  }
+
+  const ColumnID _column_id;
+  const ScanType _scan_type;
+  const T _search_value;
+  const T _upper_value;
+  std::vector<T> _in_values;
+  std::unordered_set<T> _in_value_set;
+  std::optional<LikeMatcher> _like_matcher;
+  const std::shared_ptr<const JoinFilter> _join_filter;
+};
+
+// Passes a lambda that returns the value at a chunk offset of the segment on to func. ValueSegments and
+// DictionarySegments are read in place, with the attribute vector width resolved once. Other segments are decoded
+// first, up to chunk_size.
+template <typename T, typename Functor>
+void with_value_accessor(const BaseSegment& segment, const ChunkOffset chunk_size, const Functor& func) {
+  if (const auto value_segment = dynamic_cast<const ValueSegment<T>*>(&segment)) {
+    const auto values = value_segment->values();
+    func([&](const ChunkOffset chunk_offset) -> const T& { return values[chunk_offset]; });
+  } else if (const auto dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment)) {
+    const auto& dictionary = *dictionary_segment->dictionary();
+    resolve_attribute_vector(*dictionary_segment->attribute_vector(), [&](const auto& value_ids) {
+      func([&](const ChunkOffset chunk_offset) -> const T& { return dictionary[value_ids[chunk_offset]]; });
+    });
+  } else {
+    auto values = std::vector<T>(chunk_size);
+    segment_iterate<T>(segment, chunk_size,
+                       [&](const auto& value, const auto chunk_offset) { values[chunk_offset] = value; });
+    func([&](const ChunkOffset chunk_offset) -> const T& { return values[chunk_offset]; });
+  }
+}
+
+// Assigns ranks to the values of two sorted dictionaries, so that equal values get the same rank and comparing ranks
+// is the same as comparing values. This is a single merge of both dictionaries.
+template <typename T>
+std::pair<std::vector<ValueID::base_type>, std::vector<ValueID::base_type>> merged_dictionary_ranks(
+    const std::vector<T>& left_dictionary, const std::vector<T>& right_dictionary) {
+  auto left_ranks = std::vector<ValueID::base_type>(left_dictionary.size());
+  auto right_ranks = std::vector<ValueID::base_type>(right_dictionary.size());
+  auto left_index = size_t{0};
+  auto right_index = size_t{0};
+  auto rank = ValueID::base_type{0};
+  while (left_index < left_dictionary.size() || right_index < right_dictionary.size()) {
+    const auto left_done = left_index == left_dictionary.size();
+    const auto right_done = right_index == right_dictionary.size();
+    if (right_done || (!left_done && left_dictionary[left_index] < right_dictionary[right_index])) {
+      left_ranks[left_index++] = rank++;
+    } else if (left_done || right_dictionary[right_index] < left_dictionary[left_index]) {
+      right_ranks[right_index++] = rank++;
+    } else {
+      left_ranks[left_index++] = rank;
+      right_ranks[right_index++] = rank++;
+    }
+  }
+  return {std::move(left_ranks), std::move(right_ranks)};
+}
+
+// Compares two columns of the same table row by row, e.g., shipdate > commitdate
+template <typename LeftType, typename RightType>
+class ColumnComparisonTableScanImpl : public BaseTableScanImpl {
+ public:
+  explicit ColumnComparisonTableScanImpl(const ScanPredicate& predicate)
+      : _left_column_id(predicate.column_id),
+        _right_column_id(*predicate.right_column_id),
+        _scan_type(predicate.scan_type) {}
+
+  float estimate_selectivity(const Chunk& /*chunk*/) const override { return default_selectivity(_scan_type); }
+
+  void scan(const Chunk& chunk, const ChunkOffset chunk_size, std::vector<ChunkOffset>& matches) const override {
+    const auto previous_match_count = matches.size();
+    matches.resize(previous_match_count + chunk_size);
+    auto match_count = previous_match_count;
+    _with_row_matcher(chunk, chunk_size, [&](const auto& matcher) {
+      // Writes every offset and only advances if it matches, so that the loop has no branches
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        matches[match_count] = chunk_offset;
+        match_count += matcher(chunk_offset);
+      }
+    });
+    matches.resize(match_count);
+  }
+
+  void filter(const Chunk& chunk, const ChunkOffset chunk_size, std::vector<ChunkOffset>& matches) const override {
+    auto match_count = size_t{0};
+    _with_row_matcher(chunk, chunk_size, [&](const auto& matcher) {
+      for (const auto chunk_offset : matches) {
+        matches[match_count] = chunk_offset;
+        match_count += matcher(chunk_offset);
+      }
+    });
+    matches.resize(match_count);
+  }
+
+ protected:
+  // Passes a lambda that checks the row at a chunk offset on to func. A separate loop is instantiated for every
+  // combination of segment types and attribute vector widths.
+  template <typename Functor>
+  void _with_row_matcher(const Chunk& chunk, const ChunkOffset chunk_size, const Functor& func) const {
+    const auto& left_segment = *chunk.get_segment(_left_column_id);
+    const auto& right_segment = *chunk.get_segment(_right_column_id);
+
+    with_comparator(_scan_type, [&](const auto& comparator) {
+      if constexpr (std::is_same_v<LeftType, RightType>) {
+        // Two dictionaries are compared through the ranks of their value ids in the merged dictionary, so that no
+        // values have to be decoded
+        const auto left_dictionary_segment = dynamic_cast<const DictionarySegment<LeftType>*>(&left_segment);
+        const auto right_dictionary_segment = dynamic_cast<const DictionarySegment<RightType>*>(&right_segment);
+        if (left_dictionary_segment && right_dictionary_segment) {
+          const auto ranks = merged_dictionary_ranks(*left_dictionary_segment->dictionary(),
+                                                     *right_dictionary_segment->dictionary());
+          const auto& left_ranks = ranks.first;
+          const auto& right_ranks = ranks.second;
+          resolve_attribute_vector(*left_dictionary_segment->attribute_vector(), [&](const auto& left_value_ids) {
+            resolve_attribute_vector(*right_dictionary_segment->attribute_vector(), [&](const auto& right_value_ids) {
+              func([&](const ChunkOffset chunk_offset) {
+                return comparator(left_ranks[left_value_ids[chunk_offset]],
+                                  right_ranks[right_value_ids[chunk_offset]]);
+              });
+            });
+          });
+          return;
+        }
+      }
+
+      with_value_accessor<LeftType>(left_segment, chunk_size, [&](const auto& left_value_at) {
+        with_value_accessor<RightType>(right_segment, chunk_size, [&](const auto& right_value_at) {
+          func([&](const ChunkOffset chunk_offset) {
+            return comparator(left_value_at(chunk_offset), right_value_at(chunk_offset));
+          });
+        });
+      });
+    });
+  }
+
+  const ColumnID _left_column_id;
+  const ColumnID _right_column_id;
+  const ScanType _scan_type;
+};
+
+}  // namespace
+
+TableScan::TableScan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id,
+                     const ScanType scan_type, const AllTypeVariant search_value)
+    : TableScan(in, std::vector<ScanPredicate>{{column_id, scan_type, search_value}}) {}
+
+TableScan::TableScan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id,
+                     const ScanType scan_type, const TypedValue search_value)
+    : TableScan(in, column_id, scan_type, search_value.to_variant()) {}
+
+TableScan::TableScan(const std::shared_ptr<const AbstractOperator>& in, const std::vector<ScanPredicate>& predicates)
+    : AbstractOperator(in), _predicates(predicates) {
+  Assert(!_predicates.empty(), "TableScan needs at least one predicate");
+}
+
+ColumnID TableScan::column_id() const { return _predicates.front().column_id; }
+
+ScanType TableScan::scan_type() const { return _predicates.front().scan_type; }
+
+const AllTypeVariant& TableScan::search_value() const { return _predicates.front().search_value; }
+
+const std::vector<ScanPredicate>& TableScan::predicates() const { return _predicates; }
+
+std::shared_ptr<const Table> TableScan::_on_execute() {
+  const auto input_table = _left_input_table();
+  auto output_table = std::make_shared<Table>(input_table->target_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  auto impls = std::vector<std::unique_ptr<BaseTableScanImpl>>{};
+  for (const auto& predicate : _predicates) {
+    Assert(predicate.column_id < input_table->column_count(), "Column ID out of range");
+    Assert(predicate.scan_type != ScanType::OpLike || input_table->column_type(predicate.column_id) == "string",
+           "LIKE is only supported on strings");
+    if (!predicate.right_column_id) {
+      resolve_data_type(input_table->column_type(predicate.column_id), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        impls.push_back(std::make_unique<TableScanImpl<Type>>(predicate));
+      });
+      continue;
+    }
+
+    Assert(*predicate.right_column_id < input_table->column_count(), "Column ID out of range");
+    Assert(predicate.scan_type != ScanType::OpBetween && predicate.scan_type != ScanType::OpIn &&
+               predicate.scan_type != ScanType::OpLike && predicate.scan_type != ScanType::OpJoinFilter,
+           "Columns can only be compared with each other");
+    resolve_data_type(input_table->column_type(predicate.column_id), [&](auto left_type) {
+      using LeftType = typename decltype(left_type)::type;
+      resolve_data_type(input_table->column_type(*predicate.right_column_id), [&](auto right_type) {
+        using RightType = typename decltype(right_type)::type;
+        if constexpr ((std::is_arithmetic_v<LeftType> && std::is_arithmetic_v<RightType>) ||
+                      std::is_same_v<LeftType, RightType>) {
+          impls.push_back(std::make_unique<ColumnComparisonTableScanImpl<LeftType, RightType>>(predicate));
+        } else {
+          Fail("Numbers can only be compared to numbers and strings to strings");
+        }
+      });
+    });
+  }
+
+  auto chunk_positions = std::vector<PosList>(input_table->chunk_count());
+  parallel_for(chunk_positions.size(), [&](const size_t chunk_index) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+    const auto chunk = input_table->pin_chunk(chunk_id);
+    const auto chunk_size = chunk->size();
+    if (chunk_size == 0) return;
+
+    auto scan_order = std::vector<size_t>(impls.size());
+    std::iota(scan_order.begin(), scan_order.end(), size_t{0});
+    if (impls.size() > 1) {
+      auto selectivities = std::vector<float>(impls.size());
+      for (auto index = size_t{0}; index < impls.size(); ++index) {
+        selectivities[index] = impls[index]->estimate_selectivity(*chunk);
+      }
+      std::stable_sort(scan_order.begin(), scan_order.end(),
+                       [&](const auto lhs, const auto rhs) { return selectivities[lhs] < selectivities[rhs]; });
+    }
+
+    auto matches = std::vector<ChunkOffset>{};
+    for (auto index = size_t{0}; index < scan_order.size(); ++index) {
+      if (index == 0) {
+        impls[scan_order[index]]->scan(*chunk, chunk_size, matches);
+      } else {
+        impls[scan_order[index]]->filter(*chunk, chunk_size, matches);
+      }
+      if (matches.empty()) return;
+    }
+
+    auto& positions = chunk_positions[chunk_index];
+    positions.reserve(matches.size());
+    for (const auto chunk_offset : matches) positions.push_back(RowID{chunk_id, chunk_offset});
+  });
+
+  for (const auto& positions : chunk_positions) {
+    if (!positions.empty()) output_table->emplace_chunk(make_reference_chunk(input_table, positions));
+  }
+
+  // Consumers expect every chunk to hold one segment per column, even if no row qualified
+  if (output_table->row_count() == 0) output_table->emplace_chunk(make_reference_chunk(input_table, PosList{}));
+
+  return output_table;
+}
+
+}  // namespace opossum
@@ -7,25 +7,58 @@
 
 #include "abstract_operator.hpp"
 #include "all_type_variant.hpp"
+#include "typed_value.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
 
 class BaseTableScanImpl;
+class JoinFilter;
 class Table;
 
+// A predicate on a single column, e.g., a >= 10. For OpBetween, the column value has to lie within [search_value,
+// upper_value]. For OpIn, it has to be one of in_values, and search_value is ignored. For OpLike, search_value is the
+// pattern. For OpJoinFilter, only values that join_filter may contain qualify, and search_value is ignored as well.
+// If right_column_id is set, the column is compared with that column of the same row instead of search_value, e.g.,
+// shipdate > commitdate, which is supported for OpEquals to OpGreaterThanEquals.
+struct ScanPredicate {
+  ColumnID column_id;
+  ScanType scan_type;
+  AllTypeVariant search_value;
+  AllTypeVariant upper_value{};
+  std::vector<AllTypeVariant> in_values{};
+  std::optional<ColumnID> right_column_id{};
+  std::shared_ptr<const JoinFilter> join_filter{};
+};
+
+// Selects the rows that satisfy all given predicates (i.e., their conjunction) in a single pass over each chunk. Per
+// chunk, the predicates are ordered by their estimated selectivity, which is derived from the dictionary for
+// DictionarySegments. On DictionarySegments, each predicate is evaluated against the dictionary once and the attribute
+// vector is then scanned for a range of value ids, or a bitset of them for IN-lists, join filters and LIKE patterns
+// that are not prefix searches. The most selective predicate scans the whole chunk, all further predicates only look at
+// the rows that are still candidates. This way, no intermediate tables of ReferenceSegments are built.
 class TableScan : public AbstractOperator {
  public:
   TableScan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id, const ScanType scan_type,
             const AllTypeVariant search_value);
 
+  TableScan(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id, const ScanType scan_type,
+            const TypedValue search_value);
+
+  TableScan(const std::shared_ptr<const AbstractOperator>& in, const std::vector<ScanPredicate>& predicates);
+
+  // The column, scan type and search value of the first predicate
   ColumnID column_id() const;
   ScanType scan_type() const;
   const AllTypeVariant& search_value() const;
 
+  const std::vector<ScanPredicate>& predicates() const;
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
+
+  const std::vector<ScanPredicate> _predicates;
 };
 
 }  // namespace opossum
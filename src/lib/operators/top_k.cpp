@@ -0,0 +1,153 @@
+#include "top_k.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <optional>
+#include <queue>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+template <typename T>
+struct Candidate {
+  T value;
+  RowID row_id;
+};
+
+// Orders candidates by value in the requested direction and by their position in the input for equal values
+template <typename T>
+struct CandidateOrder {
+  OrderByMode order_by_mode;
+
+  bool operator()(const Candidate<T>& lhs, const Candidate<T>& rhs) const {
+    return comes_before(lhs.value, lhs.row_id, rhs);
+  }
+
+  bool comes_before(const T& value, const RowID& row_id, const Candidate<T>& other) const {
+    if (value != other.value) {
+      return order_by_mode == OrderByMode::Ascending ? value < other.value : other.value < value;
+    }
+    return row_id < other.row_id;
+  }
+};
+
+// Returns the best value of a segment in the given order if it is known without looking at all values
+template <typename T>
+std::optional<T> best_value_of_segment(const BaseSegment& segment, const OrderByMode order_by_mode) {
+  const auto dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment);
+  if (!dictionary_segment || dictionary_segment->unique_values_count() == 0) return std::nullopt;
+
+  const auto& dictionary = *dictionary_segment->dictionary();
+  return order_by_mode == OrderByMode::Ascending ? dictionary.front() : dictionary.back();
+}
+
+template <typename T>
+PosList top_k_positions(const Table& table, const ColumnID column_id, const OrderByMode order_by_mode,
+                        const size_t k) {
+  const auto order = CandidateOrder<T>{order_by_mode};
+  using Heap = std::priority_queue<Candidate<T>, std::vector<Candidate<T>>, CandidateOrder<T>>;
+
+  // Each thread processes a contiguous range of chunks, so that rows are visited in ascending RowID order per heap
+  const auto chunk_count = static_cast<size_t>(table.chunk_count());
+  const auto range_count = std::min(chunk_count, worker_count());
+  auto heaps = std::vector<Heap>(range_count, Heap{order});
+
+  parallel_for(range_count, [&](const size_t range_index) {
+    // The top of the heap is the worst of the best k candidates seen so far
+    auto& heap = heaps[range_index];
+    const auto first_chunk_id = range_index * chunk_count / range_count;
+    const auto last_chunk_id = (range_index + 1) * chunk_count / range_count;
+
+    for (auto chunk_index = first_chunk_id; chunk_index < last_chunk_id; ++chunk_index) {
+      const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+      const auto chunk = table.pin_chunk(chunk_id);
+      const auto chunk_size = chunk->size();
+      if (chunk_size == 0) continue;
+
+      const auto& segment = *chunk->get_segment(column_id);
+      if (heap.size() == k) {
+        // All rows of this chunk come after the rows in the heap, so they would have to be strictly better
+        const auto best_value = best_value_of_segment<T>(segment, order_by_mode);
+        if (best_value && !order.comes_before(*best_value, RowID{chunk_id, 0}, heap.top())) continue;
+      }
+
+      segment_iterate<T>(segment, chunk_size, [&](const auto& value, const auto chunk_offset) {
+        const auto row_id = RowID{chunk_id, chunk_offset};
+        if (heap.size() < k) {
+          heap.push(Candidate<T>{value, row_id});
+        } else if (order.comes_before(value, row_id, heap.top())) {
+          heap.pop();
+          heap.push(Candidate<T>{value, row_id});
+        }
+      });
+    }
+  });
+
+  // k can be much larger than the table, so the heaps are sized by the rows they hold
+  auto candidate_count = size_t{0};
+  for (const auto& heap : heaps) candidate_count += heap.size();
+  auto candidates = std::vector<Candidate<T>>{};
+  candidates.reserve(candidate_count);
+  for (auto& heap : heaps) {
+    for (; !heap.empty(); heap.pop()) candidates.push_back(heap.top());
+  }
+  std::sort(candidates.begin(), candidates.end(), order);
+  if (candidates.size() > k) candidates.resize(k);
+
+  auto positions = PosList{};
+  positions.reserve(candidates.size());
+  for (const auto& candidate : candidates) positions.push_back(candidate.row_id);
+  return positions;
+}
+
+}  // namespace
+
+TopK::TopK(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id,
+           const OrderByMode order_by_mode, const size_t k)
+    : AbstractOperator(in), _column_id(column_id), _order_by_mode(order_by_mode), _k(k) {}
+
+ColumnID TopK::column_id() const { return _column_id; }
+
+OrderByMode TopK::order_by_mode() const { return _order_by_mode; }
+
+size_t TopK::k() const { return _k; }
+
+std::shared_ptr<const Table> TopK::_on_execute() {
+  const auto input_table = _left_input_table();
+  auto output_table = std::make_shared<Table>(input_table->target_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  auto positions = PosList{};
+  if (_k > 0) {
+    resolve_data_type(input_table->column_type(_column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      positions = top_k_positions<Type>(*input_table, _column_id, _order_by_mode, _k);
+    });
+  }
+
+  const auto output_chunk_size = std::max(size_t{1}, static_cast<size_t>(input_table->target_chunk_size()));
+  for (auto begin = size_t{0}; begin < positions.size(); begin += output_chunk_size) {
+    const auto end = std::min(positions.size(), begin + output_chunk_size);
+    output_table->emplace_chunk(make_reference_chunk(
+        input_table, PosList(positions.cbegin() + static_cast<ptrdiff_t>(begin),
+                             positions.cbegin() + static_cast<ptrdiff_t>(end))));
+  }
+  if (positions.empty()) output_table->emplace_chunk(make_reference_chunk(input_table, PosList{}));
+
+  return output_table;
+}
+
+}  // namespace opossum
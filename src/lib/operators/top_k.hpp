@@ -0,0 +1,37 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+// Returns the k first rows of the input table in the given order of one column, i.e., ORDER BY column LIMIT k. Rows
+// with equal values are returned in input order.
+//
+// The chunks are split into one contiguous range per thread. Each thread keeps a bounded heap of the k best rows it
+// has seen and skips chunks whose best value cannot make it into the heap anymore. This is known for
+// DictionarySegments, where the first and last dictionary entries bound the values of the chunk. In the
+// end, the per-thread heaps are merged. Thus, the memory consumption is O(k * threads), independent of the input size.
+// The output consists of ReferenceSegments.
+class TopK : public AbstractOperator {
+ public:
+  TopK(const std::shared_ptr<const AbstractOperator>& in, const ColumnID column_id, const OrderByMode order_by_mode,
+       const size_t k);
+
+  ColumnID column_id() const;
+  OrderByMode order_by_mode() const;
+  size_t k() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const ColumnID _column_id;
+  const OrderByMode _order_by_mode;
+  const size_t _k;
+};
+
+}  // namespace opossum
@@ -0,0 +1,16 @@
+#include "union_positions.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+namespace opossum {
+
+void UnionPositions::_merge(const std::vector<ChunkOffset>& left, const std::vector<ChunkOffset>& right,
+                            std::vector<ChunkOffset>& result) const {
+  result.reserve(left.size() + right.size());
+  std::set_union(left.cbegin(), left.cend(), right.cbegin(), right.cend(), std::back_inserter(result));
+  result.erase(std::unique(result.begin(), result.end()), result.end());
+}
+
+}  // namespace opossum
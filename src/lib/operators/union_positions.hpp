@@ -0,0 +1,22 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_positions_set_operator.hpp"
+
+namespace opossum {
+
+// Returns the rows that are part of at least one of the inputs, each row once. Together with TableScans, this
+// evaluates disjunctions such as a = 1 OR b = 2.
+class UnionPositions : public AbstractPositionsSetOperator {
+ public:
+  using AbstractPositionsSetOperator::AbstractPositionsSetOperator;
+
+ protected:
+  void _merge(const std::vector<ChunkOffset>& left, const std::vector<ChunkOffset>& right,
+              std::vector<ChunkOffset>& result) const override;
+};
+
+}  // namespace opossum
@@ -0,0 +1,86 @@
+#include "validate.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "concurrency/transaction_context.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+Validate::Validate(const std::shared_ptr<const AbstractOperator>& in,
+                   const std::shared_ptr<const TransactionContext>& transaction_context)
+    : AbstractOperator(in), _transaction_context(transaction_context) {
+  Assert(_transaction_context, "Validate needs a transaction context");
+}
+
+std::shared_ptr<const Table> Validate::_on_execute() {
+  const auto input_table = _left_input_table();
+  auto output_table = std::make_shared<Table>(input_table->target_chunk_size());
+  for (auto column_id = ColumnID{0}; column_id < input_table->column_count(); ++column_id) {
+    output_table->add_column_definition(input_table->column_name(column_id), input_table->column_type(column_id));
+  }
+
+  const auto transaction_id = _transaction_context->transaction_id();
+  const auto snapshot_commit_id = _transaction_context->snapshot_commit_id();
+
+  // Chunks that are added after the chunk count was read only hold rows that are not part of the snapshot
+  auto output_chunks = std::vector<Chunk>(input_table->chunk_count());
+  parallel_for(output_chunks.size(), [&](const size_t chunk_index) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+    const auto input_chunk = input_table->pin_chunk(chunk_id);
+    const auto chunk_size = input_chunk->size();
+    if (chunk_size == 0 || input_chunk->column_count() == 0) return;
+
+    auto positions = PosList{};
+    positions.reserve(chunk_size);
+    const auto segment = input_chunk->get_segment(ColumnID{0});
+    const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(segment);
+    if (reference_segment) {
+      // All columns reference the same table, so the rows are validated using the positions of the first one
+      const auto& referenced_table = *reference_segment->referenced_table();
+      const auto& pos_list = *reference_segment->pos_list();
+      auto current_chunk_id = INVALID_CHUNK_ID;
+      auto mvcc_data = std::shared_ptr<const MvccData>{};
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        const auto& row_id = pos_list[chunk_offset];
+        if (row_id.chunk_id != current_chunk_id) {
+          current_chunk_id = row_id.chunk_id;
+          mvcc_data = referenced_table.pin_chunk(row_id.chunk_id)->mvcc_data();
+        }
+        if (!mvcc_data || mvcc_data->is_visible(row_id.chunk_offset, transaction_id, snapshot_commit_id)) {
+          positions.push_back(RowID{chunk_id, chunk_offset});
+        }
+      }
+    } else {
+      const auto& mvcc_data = input_chunk->mvcc_data();
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        if (!mvcc_data || mvcc_data->is_visible(chunk_offset, transaction_id, snapshot_commit_id)) {
+          positions.push_back(RowID{chunk_id, chunk_offset});
+        }
+      }
+    }
+
+    if (positions.empty()) return;
+    // Chunks of values are referenced even if all their rows are visible, so that the output only references one table
+    if (positions.size() == chunk_size && reference_segment) {
+      for (auto column_id = ColumnID{0}; column_id < input_chunk->column_count(); ++column_id) {
+        output_chunks[chunk_index].add_segment(input_chunk->get_segment(column_id));
+      }
+      return;
+    }
+    output_chunks[chunk_index] = make_reference_chunk(input_table, positions);
+  });
+
+  for (auto& chunk : output_chunks) {
+    if (chunk.column_count() > 0) output_table->emplace_chunk(std::move(chunk));
+  }
+  if (output_table->row_count() == 0) output_table->emplace_chunk(make_reference_chunk(input_table, PosList{}));
+
+  return output_table;
+}
+
+}  // namespace opossum
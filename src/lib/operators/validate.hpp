@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+
+#include "abstract_operator.hpp"
+
+namespace opossum {
+
+class TransactionContext;
+
+// Filters the input table to the rows that are visible to a transaction (see MvccData). The input is either a table
+// that uses MVCC or a table of ReferenceSegments into one, such as the output of a TableScan on it. Rows of chunks
+// without MVCC columns are always visible. The output only consists of ReferenceSegments into the table that the input
+// references (or the input itself), so that it can be passed on to TransactionContext::delete_rows and to operators
+// that create ReferenceSegments themselves. Chunks of ReferenceSegments whose rows are all visible are forwarded.
+class Validate : public AbstractOperator {
+ public:
+  Validate(const std::shared_ptr<const AbstractOperator>& in,
+           const std::shared_ptr<const TransactionContext>& transaction_context);
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  const std::shared_ptr<const TransactionContext> _transaction_context;
+};
+
+}  // namespace opossum
@@ -3,6 +3,7 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include <boost/hana/equal.hpp>
@@ -78,4 +79,21 @@ void resolve_data_type(const std::string& type_string, const Functor& func) {
   });
 }
 
+// Returns the type string of a data type, i.e., the inverse of resolve_data_type
+template <typename T>
+std::string data_type_name() {
+  auto type_string = std::string{};
+  hana::for_each(data_types, [&](auto x) {
+    if constexpr (std::is_same_v<typename decltype(+hana::second(x))::type, T>) type_string = hana::first(x);
+  });
+  DebugAssert(!type_string.empty(), "Type is not in AllTypeVariant");
+  return type_string;
+}
+
+// Returns the type string of the value stored in an AllTypeVariant
+inline std::string data_type_of(const AllTypeVariant& value) {
+  return boost::apply_visitor(
+      [](const auto& typed_value) { return data_type_name<std::decay_t<decltype(typed_value)>>(); }, value);
+}
+
 }  // namespace opossum
@@ -4,6 +4,7 @@
 #include <string>
 
 #include "all_type_variant.hpp"
+#include "typed_value.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -23,9 +24,15 @@ class BaseSegment : private Noncopyable {
   // returns the value at a given position
   virtual AllTypeVariant operator[](const ChunkOffset chunk_offset) const = 0;
 
+  // returns the value at a given position without copying strings, which stay owned by the segment
+  virtual TypedValue typed_value(const ChunkOffset chunk_offset) const = 0;
+
   // appends the value at the end of the segment
   virtual void append(const AllTypeVariant& val) = 0;
 
+  // same as append(AllTypeVariant), but does not need a boxed value
+  virtual void append(const TypedValue& value) = 0;
+
   // returns the number of values
   virtual ChunkOffset size() const = 0;
 
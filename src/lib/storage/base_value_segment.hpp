@@ -0,0 +1,32 @@
+#pragma once
+
+#include "base_segment.hpp"
+#include "column_span.hpp"
+
+namespace opossum {
+
+// BaseValueSegment is the abstract super class of ValueSegment<T>. Besides appending values one at a time, it allows a
+// Chunk to write values of reserved rows into storage that was allocated up front, from several threads at once (see
+// Chunk::try_append). Such values only become visible to readers once they are published.
+class BaseValueSegment : public BaseSegment {
+ public:
+  // returns the index of the data type in data_types, as for AllTypeVariant::which()
+  virtual size_t which() const = 0;
+
+  // converts a value to the data type of the segment, throws if that is not possible
+  virtual AllTypeVariant convert(const TypedValue& value) const = 0;
+
+  // writes a value, which has to have the data type of the segment, into the allocated storage
+  virtual void write(const ChunkOffset chunk_offset, const TypedValue& value) = 0;
+
+  // writes values of the data type of the segment into the allocated storage, starting at chunk_offset
+  virtual void write_values(const ChunkOffset chunk_offset, const ColumnSpan& values) = 0;
+
+  // writes the default value of the data type (0 or an empty string) into the allocated storage of the rows
+  // [first_row, end), which cannot fail
+  virtual void write_defaults(const ChunkOffset first_row, const ChunkOffset end) noexcept = 0;
+
+  // makes the first size values visible, i.e., sets the size of the segment. All of them have to be written.
+  virtual void publish(const ChunkOffset size) = 0;
+};
+}  // namespace opossum
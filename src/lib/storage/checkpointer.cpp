@@ -0,0 +1,262 @@
+#include "checkpointer.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/write_ahead_log.hpp"
+#include "utils/assert.hpp"
+#include "utils/binary_table.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+const auto MANIFEST_FILE = std::string{"manifest"};
+const auto TEMPORARY_MANIFEST_FILE = std::string{"manifest.tmp"};
+
+// Flushes a file or directory (i.e., the names of its entries) to disk
+void sync_path(const std::filesystem::path& path) {
+  const auto file_descriptor = ::open(path.c_str(), O_RDONLY);
+  Assert(file_descriptor >= 0, "Could not open " + path.string());
+  const auto result = ::fsync(file_descriptor);
+  ::close(file_descriptor);
+  Assert(result == 0, "Could not sync " + path.string());
+}
+
+// The state of a table as collected for a checkpoint
+struct CheckpointTable {
+  std::string name;
+  std::shared_ptr<const Table> table;
+  std::vector<ChunkID> chunk_ids;
+  std::vector<std::vector<std::shared_ptr<BaseSegment>>> chunks;
+  std::vector<std::string> file_names;
+};
+
+bool is_dictionary_encoded(const Table& table, const std::vector<std::shared_ptr<BaseSegment>>& segments) {
+  auto dictionary_encoded = true;
+  for (auto column_id = ColumnID{0}; column_id < segments.size(); ++column_id) {
+    resolve_data_type(table.column_type(column_id), [&](auto type) {
+      using Type = typename decltype(type)::type;
+      dictionary_encoded &= static_cast<bool>(std::dynamic_pointer_cast<DictionarySegment<Type>>(segments[column_id]));
+    });
+  }
+  return dictionary_encoded;
+}
+
+}  // namespace
+
+Checkpointer::Checkpointer(const std::string& directory, const std::shared_ptr<WriteAheadLog>& write_ahead_log)
+    : _directory(directory), _write_ahead_log(write_ahead_log) {
+  std::filesystem::create_directories(_directory);
+}
+
+uint64_t Checkpointer::recover(StorageManager& storage_manager) {
+  const auto lock = std::lock_guard{_mutex};
+  const auto directory = std::filesystem::path{_directory};
+  if (!std::filesystem::exists(directory / MANIFEST_FILE)) return 0;
+
+  auto manifest = std::ifstream{directory / MANIFEST_FILE};
+  auto first_lsn = uint64_t{0};
+  auto table_count = size_t{0};
+  Assert(manifest >> _checkpoint_number >> first_lsn >> table_count, "Checkpoint manifest is corrupted");
+
+  for (auto table_index = size_t{0}; table_index < table_count; ++table_index) {
+    auto name = std::string{};
+    auto target_chunk_size = ChunkOffset{0};
+    auto uses_mvcc = false;
+    auto column_count = size_t{0};
+    auto chunk_count = size_t{0};
+    manifest.ignore();
+    std::getline(manifest, name);
+    Assert(manifest >> target_chunk_size >> uses_mvcc >> column_count >> chunk_count,
+           "Checkpoint manifest is corrupted");
+    manifest.ignore();
+
+    const auto table = std::make_shared<Table>(target_chunk_size, UseMvcc{uses_mvcc});
+    for (auto column_id = size_t{0}; column_id < column_count; ++column_id) {
+      auto column_name = std::string{};
+      auto column_type = std::string{};
+      std::getline(manifest, column_name);
+      std::getline(manifest, column_type);
+      table->add_column(column_name, column_type);
+    }
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      auto file_name = std::string{};
+      Assert(manifest >> file_name, "Checkpoint manifest is corrupted");
+      const auto chunk_table = open_binary_table(directory / file_name);
+      Assert(chunk_table->chunk_count() == 1 && chunk_table->column_count() == column_count,
+             "Checkpoint chunk file " + file_name + " does not match the manifest");
+
+      auto& chunk = chunk_table->get_chunk(ChunkID{0});
+      auto segments = std::vector<std::shared_ptr<BaseSegment>>{};
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        segments.push_back(chunk.get_segment(column_id));
+      }
+      if (is_dictionary_encoded(*table, segments)) _written_chunks[name][chunk_id] = {segments.front(), file_name};
+
+      // The rows of the last chunk are appended instead, so that it is mutable again if it was before
+      auto columns = std::vector<ColumnSpan>{};
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        resolve_data_type(table->column_type(column_id), [&](auto type) {
+          using Type = typename decltype(type)::type;
+          const auto value_segment = std::dynamic_pointer_cast<ValueSegment<Type>>(segments[column_id]);
+          if (value_segment) columns.emplace_back(value_segment->values());
+        });
+      }
+      if (chunk_id + 1 == chunk_count && columns.size() == column_count) {
+        table->append_columns(columns);
+      } else {
+        table->emplace_chunk(std::move(chunk));
+      }
+    }
+    storage_manager.add_table(name, table);
+  }
+  return first_lsn;
+}
+
+void Checkpointer::checkpoint(StorageManager& storage_manager) {
+  const auto lock = std::lock_guard{_mutex};
+  const auto directory = std::filesystem::path{_directory};
+  const auto checkpoint_number = _checkpoint_number + 1;
+
+  // Collects the chunks of all tables at one point in the log, so that the checkpoint holds exactly the changes
+  // before that point
+  auto first_lsn = uint64_t{0};
+  auto tables = std::vector<CheckpointTable>{};
+  {
+    const auto blocked_changes = _write_ahead_log->block_changes();
+    first_lsn = _write_ahead_log->next_lsn();
+    for (const auto& name : storage_manager.table_names()) {
+      auto& checkpoint_table = tables.emplace_back();
+      checkpoint_table.name = name;
+      const auto table = storage_manager.get_table(name);
+      checkpoint_table.table = table;
+
+      for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+        const auto chunk = table->pin_chunk(chunk_id);
+        const auto chunk_size = chunk->size();
+        if (chunk_size == 0) continue;
+
+        // Rows can only be appended to a mutable chunk that is not full yet, so only its segments are copied
+        const auto is_mutable = chunk->is_mutable() && chunk_size < chunk->capacity();
+        auto& segments = checkpoint_table.chunks.emplace_back();
+        for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+          auto segment = chunk->get_segment(column_id);
+          resolve_data_type(table->column_type(column_id), [&](auto type) {
+            using Type = typename decltype(type)::type;
+            const auto value_segment = std::dynamic_pointer_cast<ValueSegment<Type>>(segment);
+            if (!is_mutable || !value_segment) return;
+            const auto values = value_segment->values();
+            auto values_copy = std::vector<Type>(values.begin(), values.begin() + chunk_size);
+            segment = std::make_shared<ValueSegment<Type>>(std::move(values_copy));
+          });
+          segments.push_back(std::move(segment));
+        }
+        checkpoint_table.chunk_ids.push_back(chunk_id);
+      }
+    }
+  }
+
+  // Chooses the chunks to write, reusing the files of the chunks that have not changed since they were written
+  auto written_chunks = std::map<std::string, std::map<ChunkID, WrittenChunk>>{};
+  auto chunks_to_write = std::vector<std::pair<size_t, size_t>>{};
+  for (auto table_index = size_t{0}; table_index < tables.size(); ++table_index) {
+    auto& checkpoint_table = tables[table_index];
+    for (auto index = size_t{0}; index < checkpoint_table.chunks.size(); ++index) {
+      const auto chunk_id = checkpoint_table.chunk_ids[index];
+      const auto& segments = checkpoint_table.chunks[index];
+      auto file_name = std::string{};
+
+      const auto dictionary_encoded = is_dictionary_encoded(*checkpoint_table.table, segments);
+      if (dictionary_encoded) {
+        const auto table_it = _written_chunks.find(checkpoint_table.name);
+        if (table_it != _written_chunks.end()) {
+          const auto chunk_it = table_it->second.find(chunk_id);
+          if (chunk_it != table_it->second.end() && chunk_it->second.first_segment.lock() == segments.front()) {
+            file_name = chunk_it->second.file_name;
+          }
+        }
+      }
+      if (file_name.empty()) {
+        file_name = std::to_string(checkpoint_number) + "_" + std::to_string(table_index) + "_" +
+                    std::to_string(chunk_id) + ".bin";
+        chunks_to_write.emplace_back(table_index, index);
+      }
+      if (dictionary_encoded) written_chunks[checkpoint_table.name][chunk_id] = {segments.front(), file_name};
+      checkpoint_table.file_names.push_back(std::move(file_name));
+    }
+  }
+
+  parallel_for(chunks_to_write.size(), [&](const size_t task_index) {
+    const auto [table_index, index] = chunks_to_write[task_index];
+    const auto& checkpoint_table = tables[table_index];
+    const auto& table = *checkpoint_table.table;
+
+    auto chunk_table = Table{table.target_chunk_size()};
+    auto chunk = Chunk{};
+    for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+      chunk_table.add_column_definition(table.column_name(column_id), table.column_type(column_id));
+      chunk.add_segment(checkpoint_table.chunks[index][column_id]);
+    }
+    chunk_table.emplace_chunk(std::move(chunk));
+
+    const auto path = directory / checkpoint_table.file_names[index];
+    write_binary_table(chunk_table, path);
+    sync_path(path);
+  });
+
+  {
+    auto manifest = std::ofstream{directory / TEMPORARY_MANIFEST_FILE};
+    manifest << checkpoint_number << ' ' << first_lsn << '\n' << tables.size() << '\n';
+    for (const auto& checkpoint_table : tables) {
+      const auto& table = *checkpoint_table.table;
+      Assert(checkpoint_table.name.find('\n') == std::string::npos, "Table names must not contain line breaks");
+      manifest << checkpoint_table.name << '\n'
+               << table.target_chunk_size() << ' ' << (table.uses_mvcc() == UseMvcc::Yes) << ' '
+               << table.column_count() << ' ' << checkpoint_table.chunks.size() << '\n';
+      for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+        manifest << table.column_name(column_id) << '\n' << table.column_type(column_id) << '\n';
+      }
+      for (const auto& file_name : checkpoint_table.file_names) manifest << file_name << '\n';
+    }
+    manifest.close();
+    Assert(!manifest.fail(), "Could not write checkpoint manifest");
+  }
+  sync_path(directory / TEMPORARY_MANIFEST_FILE);
+  std::filesystem::rename(directory / TEMPORARY_MANIFEST_FILE, directory / MANIFEST_FILE);
+  sync_path(directory);
+
+  // The new manifest is in place, so the chunk files that only the previous checkpoints referenced can be removed
+  auto referenced_files = std::set<std::string>{};
+  for (const auto& checkpoint_table : tables) {
+    referenced_files.insert(checkpoint_table.file_names.begin(), checkpoint_table.file_names.end());
+  }
+  for (const auto& entry : std::filesystem::directory_iterator{directory}) {
+    const auto file_name = entry.path().filename().string();
+    if (entry.path().extension() == ".bin" && !referenced_files.contains(file_name)) {
+      std::filesystem::remove(entry.path());
+    }
+  }
+
+  _checkpoint_number = checkpoint_number;
+  _written_chunks = std::move(written_chunks);
+  _write_ahead_log->truncate(first_lsn);
+}
+
+}  // namespace opossum
@@ -0,0 +1,66 @@
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseSegment;
+class StorageManager;
+class WriteAheadLog;
+
+/**
+ * Writes checkpoints of all tables of the StorageManager, so that recovery only has to replay the write-ahead log
+ * since the last checkpoint. A checkpoint consists of one binary table file (see write_binary_table) per chunk and a
+ * manifest, which lists the tables with their schemas and chunk files, and the LSN of the first change that is not
+ * part of the checkpoint:
+ *
+ *   <checkpoint number> <LSN>
+ *   <table count>
+ *   per table: <name>
+ *              <target chunk size> <uses MVCC> <column count> <chunk count>
+ *              per column: <name>
+ *                          <type>
+ *              per chunk:  <file name>
+ *
+ * Checkpoints are consistent and online: tables can be read and appended to while a checkpoint is written. Changes are
+ * only blocked while the chunks are collected, which takes the rows of the mutable chunks that are not full yet, as
+ * they are still being appended to, and shares the segments of all other chunks. The chunks are then written in
+ * parallel. Checkpoints are incremental: chunks that are fully dictionary-encoded cannot change anymore, so their file
+ * is written once and referenced by the following checkpoints for as long as the chunk exists.
+ */
+class Checkpointer : private Noncopyable {
+ public:
+  Checkpointer(const std::string& directory, const std::shared_ptr<WriteAheadLog>& write_ahead_log);
+
+  // Adds the tables of the last checkpoint to the storage manager and returns the LSN of the first change that has
+  // to be replayed from the write-ahead log
+  uint64_t recover(StorageManager& storage_manager);
+
+  // Writes a checkpoint of all tables of the storage manager and then truncates the write-ahead log. Can run in a
+  // background thread while the tables are used, only one checkpoint is written at a time.
+  void checkpoint(StorageManager& storage_manager);
+
+ protected:
+  // A chunk file that can be referenced by following checkpoints, as long as the chunk still contains the segment
+  struct WrittenChunk {
+    std::weak_ptr<const BaseSegment> first_segment;
+    std::string file_name;
+  };
+
+  const std::string _directory;
+  const std::shared_ptr<WriteAheadLog> _write_ahead_log;
+
+  std::mutex _mutex;
+  uint64_t _checkpoint_number = 0;
+  // The immutable chunks of the last checkpoint, by table name and chunk id
+  std::map<std::string, std::map<ChunkID, WrittenChunk>> _written_chunks;
+};
+
+}  // namespace opossum
@@ -1,9 +1,11 @@
+#include <algorithm>
 #include <iomanip>
 #include <iterator>
 #include <limits>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -11,30 +13,156 @@
 #include "chunk.hpp"
 
 #include "utils/assert.hpp"
+#include "value_segment.hpp"
 
 namespace opossum {
 
+Chunk::Chunk(const ChunkOffset capacity) : _capacity(capacity) {
+  Assert(capacity > 0, "Mutable chunks need a capacity");
+}
+
+Chunk::Chunk(Chunk&& other) noexcept
+    : _segments(std::move(other._segments)),
+      _mvcc_data(std::move(other._mvcc_data)),
+      _capacity(other._capacity),
+      _reserved_rows(other._reserved_rows.load()),
+      _size(other._size.load()) {}
+
+Chunk& Chunk::operator=(Chunk&& other) noexcept {
+  _segments = std::move(other._segments);
+  _mvcc_data = std::move(other._mvcc_data);
+  _capacity = other._capacity;
+  _reserved_rows = other._reserved_rows.load();
+  _size = other._size.load();
+  return *this;
+}
+
 void Chunk::add_segment(std::shared_ptr<BaseSegment> segment) {
-  // Implementation goes here
+  Assert(!is_mutable() || std::dynamic_pointer_cast<BaseValueSegment>(segment),
+         "Mutable chunks can only hold ValueSegments");
+  _segments.push_back(std::move(segment));
 }
 
 void Chunk::append(const std::vector<AllTypeVariant>& values) {
-  // Implementation goes here
+  DebugAssert(values.size() == _segments.size(), "Number of values does not match the number of segments");
+  if (is_mutable()) {
+    Assert(try_append(values), "Chunk is full");
+    return;
+  }
+  for (auto column_id = ColumnID{0}; column_id < values.size(); ++column_id) {
+    _segments[column_id]->append(values[column_id]);
+  }
+}
+
+void Chunk::append_columns(const std::vector<ColumnSpan>& columns) {
+  Assert(columns.size() == _segments.size(), "Number of columns does not match the number of segments");
+  for (auto column_id = ColumnID{0}; column_id < columns.size(); ++column_id) {
+    Assert(columns[column_id].size() == columns.front().size(), "All columns need to have the same number of rows");
+  }
+  if (is_mutable()) {
+    const auto row_count = columns.empty() ? size_t{0} : columns.front().size();
+    Assert(try_append_columns(columns, 0) == row_count, "Chunk is full");
+    return;
+  }
+
+  for (auto column_id = ColumnID{0}; column_id < columns.size(); ++column_id) {
+    columns[column_id].resolve([&](const auto values) {
+      using Type = typename decltype(values)::value_type;
+      const auto segment = std::dynamic_pointer_cast<ValueSegment<Type>>(_segments[column_id]);
+      Assert(segment, "Values can only be appended to ValueSegments of the same data type");
+      segment->append_values(values);
+    });
+  }
+}
+
+size_t Chunk::try_append_columns(const std::vector<ColumnSpan>& columns, const size_t first_row,
+                                 const TransactionID transaction_id, ChunkOffset* const chunk_offset) {
+  DebugAssert(is_mutable(), "Rows can only be reserved in mutable chunks");
+  DebugAssert(columns.size() == _segments.size(), "Number of columns does not match the number of segments");
+  const auto row_count = columns.empty() ? size_t{0} : columns.front().size() - first_row;
+  if (row_count == 0) return 0;
+  // A reserved row range has to be written, so the data types are checked before
+  for (auto column_id = ColumnID{0}; column_id < columns.size(); ++column_id) {
+    Assert(columns[column_id].which() == _value_segment(column_id).which(), "Column has a different data type");
+  }
+
+  const auto row = _reserved_rows.fetch_add(row_count);
+  if (row >= _capacity) return 0;
+
+  const auto count = std::min(row_count, size_t{_capacity - row});
+  try {
+    for (auto column_id = ColumnID{0}; column_id < columns.size(); ++column_id) {
+      _value_segment(column_id).write_values(static_cast<ChunkOffset>(row),
+                                             columns[column_id].subspan(first_row, count));
+    }
+  } catch (...) {
+    _publish_invalid(static_cast<ChunkOffset>(row), static_cast<ChunkOffset>(row + count));
+    throw;
+  }
+  _write_mvcc_data(static_cast<ChunkOffset>(row), static_cast<ChunkOffset>(count), transaction_id);
+  _publish(static_cast<ChunkOffset>(row), static_cast<ChunkOffset>(row + count));
+  if (chunk_offset) *chunk_offset = static_cast<ChunkOffset>(row);
+  return count;
 }
 
 std::shared_ptr<BaseSegment> Chunk::get_segment(ColumnID column_id) const {
-  // Implementation goes here
-  return nullptr;
+  DebugAssert(column_id < _segments.size(), "ColumnID is out of bounds");
+  return _segments[column_id];
 }
 
-ColumnCount Chunk::column_count() const {
-  // Implementation goes here
-  return ColumnCount{0};
+void Chunk::set_mvcc_data(std::shared_ptr<MvccData> mvcc_data) {
+  Assert(!mvcc_data || mvcc_data->tids.size() >= std::max(size(), _capacity), "MVCC columns are too small");
+  _mvcc_data = std::move(mvcc_data);
 }
 
+const std::shared_ptr<MvccData>& Chunk::mvcc_data() const { return _mvcc_data; }
+
+ColumnCount Chunk::column_count() const { return ColumnCount{static_cast<ColumnCount::base_type>(_segments.size())}; }
+
 ChunkOffset Chunk::size() const {
-  // Implementation goes here
-  return 0;
+  if (is_mutable()) return _size.load(std::memory_order_acquire);
+  if (_segments.empty()) return 0;
+  return _segments.front()->size();
+}
+
+bool Chunk::is_mutable() const { return _capacity > 0; }
+
+ChunkOffset Chunk::capacity() const { return _capacity; }
+
+BaseValueSegment& Chunk::_value_segment(const ColumnID column_id) const {
+  return static_cast<BaseValueSegment&>(*_segments[column_id]);
+}
+
+void Chunk::_write_mvcc_data(const ChunkOffset first_row, const ChunkOffset count,
+                             const TransactionID transaction_id) {
+  if (!_mvcc_data) return;
+  // Rows that are not appended by a transaction are committed right away, i.e., visible to all snapshots
+  const auto begin_cid = transaction_id == INVALID_TRANSACTION_ID ? CommitID{0} : MAX_COMMIT_ID;
+  for (auto chunk_offset = first_row; chunk_offset < first_row + count; ++chunk_offset) {
+    _mvcc_data->tids[chunk_offset].store(transaction_id, std::memory_order_relaxed);
+    _mvcc_data->begin_cids[chunk_offset].store(begin_cid, std::memory_order_relaxed);
+  }
+}
+
+void Chunk::_publish(const ChunkOffset first_row, const ChunkOffset end) {
+  // Rows are published in the order in which they were reserved, so this waits for the writers of the rows before
+  while (_size.load(std::memory_order_acquire) != first_row) std::this_thread::yield();
+  for (auto column_id = ColumnID{0}; column_id < _segments.size(); ++column_id) _value_segment(column_id).publish(end);
+  _size.store(end, std::memory_order_release);
+}
+
+void Chunk::_publish_invalid(const ChunkOffset first_row, const ChunkOffset end) {
+  for (auto column_id = ColumnID{0}; column_id < _segments.size(); ++column_id) {
+    _value_segment(column_id).write_defaults(first_row, end);
+  }
+  if (_mvcc_data) {
+    // begin_cids stay at MAX_COMMIT_ID, as for inserts that were rolled back
+    for (auto chunk_offset = first_row; chunk_offset < end; ++chunk_offset) {
+      _mvcc_data->tids[chunk_offset].store(INVALID_TRANSACTION_ID, std::memory_order_relaxed);
+    }
+    _mvcc_data->invalid_row_count += end - first_row;
+  }
+  _publish(first_row, end);
 }
 
 }  // namespace opossum
@@ -6,10 +6,17 @@
 #include <atomic>
 #include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 #include "all_type_variant.hpp"
+#include "base_segment.hpp"
+#include "base_value_segment.hpp"
+#include "column_span.hpp"
+#include "mvcc_data.hpp"
+#include "typed_value.hpp"
 #include "types.hpp"
+#include "utils/assert.hpp"
 
 namespace opossum {
 
@@ -24,6 +31,14 @@ class Chunk : private Noncopyable {
  public:
   Chunk() = default;
 
+  // Creates a mutable chunk, i.e., one that rows can be appended to from several threads at once. All its segments
+  // have to be ValueSegments with storage for capacity rows.
+  explicit Chunk(const ChunkOffset capacity);
+
+  // Atomics cannot be moved, so these are implemented by hand. Chunks must not be moved while rows are appended.
+  Chunk(Chunk&& other) noexcept;
+  Chunk& operator=(Chunk&& other) noexcept;
+
   // adds a segment to the "right" of the chunk
   void add_segment(std::shared_ptr<BaseSegment> segment);
 
@@ -33,15 +48,121 @@ class Chunk : private Noncopyable {
   // returns the number of rows (cannot exceed ChunkOffset (uint32_t))
   ChunkOffset size() const;
 
+  // returns whether rows are appended with try_append
+  bool is_mutable() const;
+
+  // returns the maximum number of rows of a mutable chunk
+  ChunkOffset capacity() const;
+
   // adds a new row, given as a list of values, to the chunk
-  // note this is slow and not thread-safe and should be used for testing purposes only
+  // note this is slow and not thread-safe (unless the chunk is mutable) and should be used for testing purposes only
   void append(const std::vector<AllTypeVariant>& values);
 
+  // same as above, but takes a container of TypedValues (e.g., a std::array), so that appending numbers does not
+  // allocate. This is a template so that append({...}) keeps resolving to the AllTypeVariant overload.
+  template <typename TypedValues,
+            typename = std::enable_if_t<std::is_same_v<typename TypedValues::value_type, TypedValue>>>
+  void append(const TypedValues& values) {
+    DebugAssert(values.size() == _segments.size(), "Number of values does not match the number of segments");
+    if (is_mutable()) {
+      Assert(try_append(values), "Chunk is full");
+      return;
+    }
+    auto column_id = ColumnID{0};
+    for (const auto& value : values) _segments[column_id++]->append(value);
+  }
+
+  // Appends a row, given as a container of AllTypeVariants or TypedValues, to a mutable chunk and returns true, or
+  // returns false if the chunk is full. Can be called from several threads at once: each row is reserved with an
+  // atomic increment and written into the storage of the segments without a lock. Rows become visible in the order
+  // in which they were reserved, once all values of the row and of the rows before it are written, so that readers
+  // never see a partially written row.
+  template <typename Values>
+  bool try_append(const Values& values) {
+    DebugAssert(is_mutable(), "Rows can only be reserved in mutable chunks");
+    DebugAssert(values.size() == _segments.size(), "Number of values does not match the number of segments");
+
+    // A reserved row has to be written, so values of other data types are converted before the row is reserved
+    auto column_id = ColumnID{0};
+    for (const auto& value : values) {
+      if (TypedValue{value}.which() != _value_segment(column_id).which()) return try_append(_convert(values));
+      ++column_id;
+    }
+
+    const auto row = _reserved_rows.fetch_add(1);
+    if (row >= _capacity) return false;
+
+    try {
+      column_id = ColumnID{0};
+      for (const auto& value : values) {
+        _value_segment(column_id).write(row, TypedValue{value});
+        ++column_id;
+      }
+    } catch (...) {
+      // Copying a string can still fail, and the rows after this one can only become visible once it is published
+      _publish_invalid(static_cast<ChunkOffset>(row), static_cast<ChunkOffset>(row + 1));
+      throw;
+    }
+    _write_mvcc_data(static_cast<ChunkOffset>(row), 1, INVALID_TRANSACTION_ID);
+    _publish(static_cast<ChunkOffset>(row), static_cast<ChunkOffset>(row + 1));
+    return true;
+  }
+
+  // Adds the rows given as one ColumnSpan per segment. All segments have to be ValueSegments of the data types of the
+  // ColumnSpans, and all ColumnSpans have to have the same size.
+  void append_columns(const std::vector<ColumnSpan>& columns);
+
+  // Appends the rows from first_row on, given as one ColumnSpan per segment as for append_columns, to a mutable
+  // chunk, as many as fit. Returns the number of appended rows. Can be called from several threads at once (see
+  // try_append), the rows of one call are contiguous and start at *chunk_offset if it is given. Rows that are
+  // appended by a transaction stay invisible to other transactions until it commits (see MvccData), other rows are
+  // visible to all transactions.
+  size_t try_append_columns(const std::vector<ColumnSpan>& columns, const size_t first_row,
+                            const TransactionID transaction_id = INVALID_TRANSACTION_ID,
+                            ChunkOffset* const chunk_offset = nullptr);
+
   // Returns the segment at a given position
   std::shared_ptr<BaseSegment> get_segment(ColumnID column_id) const;
 
+  // Sets the MVCC columns of a chunk of a table that uses MVCC, which are shared when the chunk is compressed
+  void set_mvcc_data(std::shared_ptr<MvccData> mvcc_data);
+
+  // Returns the MVCC columns, or nullptr if the chunk has none, in which case all rows are visible to all transactions
+  const std::shared_ptr<MvccData>& mvcc_data() const;
+
  protected:
-  // Implementation goes here
+  BaseValueSegment& _value_segment(const ColumnID column_id) const;
+
+  template <typename Values>
+  std::vector<AllTypeVariant> _convert(const Values& values) const {
+    auto converted_values = std::vector<AllTypeVariant>{};
+    converted_values.reserve(values.size());
+    auto column_id = ColumnID{0};
+    for (const auto& value : values) {
+      converted_values.push_back(_value_segment(column_id).convert(TypedValue{value}));
+      ++column_id;
+    }
+    return converted_values;
+  }
+
+  void _write_mvcc_data(const ChunkOffset first_row, const ChunkOffset count, const TransactionID transaction_id);
+
+  // Waits until the rows before first_row are visible, then makes the rows up to end visible
+  void _publish(const ChunkOffset first_row, const ChunkOffset end);
+
+  // Publishes reserved rows that could not be written, so that appends after them do not wait forever. Their values
+  // are reset to the defaults of the data types (see BaseValueSegment::write_defaults), so that readers never see
+  // partially written rows. In chunks with MVCC columns, they are also marked like rolled back inserts, i.e., they are
+  // invisible to all transactions. Readers that do not validate rows see the default values.
+  void _publish_invalid(const ChunkOffset first_row, const ChunkOffset end);
+
+  std::vector<std::shared_ptr<BaseSegment>> _segments;
+  std::shared_ptr<MvccData> _mvcc_data;
+  ChunkOffset _capacity = 0;
+  // The number of rows that were reserved, which can exceed the capacity when appends to a full chunk fail
+  std::atomic<uint64_t> _reserved_rows{0};
+  // The number of visible rows of a mutable chunk
+  std::atomic<ChunkOffset> _size{0};
 };
 
 }  // namespace opossum
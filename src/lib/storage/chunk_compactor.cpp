@@ -0,0 +1,226 @@
+#include "chunk_compactor.hpp"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "concurrency/transaction_manager.hpp"
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+// A chunk of the old table whose rows may be merged into new chunks
+struct CandidateChunk {
+  ChunkID chunk_id;
+  // The rows that are kept, all others are dropped
+  std::vector<ChunkOffset> kept_offsets;
+  // The rows that were locked, which are all rows unless a transaction is inserting or deleting some of them
+  std::vector<ChunkOffset> locked_offsets;
+  bool is_locked = true;
+};
+
+// The kept rows [begin, end) of a candidate chunk
+struct RowSlice {
+  const CandidateChunk* candidate;
+  size_t begin;
+  size_t end;
+};
+
+// Locks the rows of the chunk, so that no transaction can delete them, and finds the rows that are kept
+void lock_rows(const Chunk& chunk, const CommitID oldest_snapshot_commit_id, CandidateChunk& candidate) {
+  const auto size = chunk.size();
+  const auto& mvcc_data = chunk.mvcc_data();
+  if (!mvcc_data) {
+    candidate.kept_offsets.resize(size);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < size; ++chunk_offset) {
+      candidate.kept_offsets[chunk_offset] = chunk_offset;
+    }
+    return;
+  }
+
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < size; ++chunk_offset) {
+    auto row_transaction_id = INVALID_TRANSACTION_ID;
+    if (mvcc_data->tids[chunk_offset].compare_exchange_strong(row_transaction_id, MOVED_ROW_TRANSACTION_ID)) {
+      candidate.locked_offsets.push_back(chunk_offset);
+    } else if (mvcc_data->end_cids[chunk_offset].load() == MAX_COMMIT_ID) {
+      // A transaction is inserting or deleting the row. Rows whose delete was committed stay locked by the deleting
+      // transaction, so they can be moved as well.
+      candidate.is_locked = false;
+      for (const auto locked_offset : candidate.locked_offsets) {
+        mvcc_data->tids[locked_offset].store(INVALID_TRANSACTION_ID);
+      }
+      candidate.locked_offsets.clear();
+      candidate.kept_offsets.clear();
+      return;
+    }
+
+    // Rows whose insert was rolled back are never visible
+    const auto begin_cid = mvcc_data->begin_cids[chunk_offset].load(std::memory_order_relaxed);
+    const auto end_cid = mvcc_data->end_cids[chunk_offset].load(std::memory_order_relaxed);
+    if (begin_cid != MAX_COMMIT_ID && end_cid > oldest_snapshot_commit_id) {
+      candidate.kept_offsets.push_back(chunk_offset);
+    }
+  }
+}
+
+void unlock_rows(const Chunk& chunk, const CandidateChunk& candidate) {
+  for (const auto chunk_offset : candidate.locked_offsets) {
+    chunk.mvcc_data()->tids[chunk_offset].store(INVALID_TRANSACTION_ID);
+  }
+}
+
+// Copies the kept rows of the slices of table into a new chunk, whose segments use the global dictionaries of table
+// where possible
+std::shared_ptr<Chunk> merge_rows(const Table& table, const std::vector<RowSlice>& slices) {
+  auto slice_offsets = std::vector<std::vector<ChunkOffset>>{};
+  auto size = ChunkOffset{0};
+  for (const auto& [candidate, begin, end] : slices) {
+    const auto& kept_offsets = candidate->kept_offsets;
+    slice_offsets.emplace_back(kept_offsets.begin() + begin, kept_offsets.begin() + end);
+    size += static_cast<ChunkOffset>(end - begin);
+  }
+
+  auto chunk = std::make_shared<Chunk>();
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    resolve_data_type(table.column_type(column_id), [&](auto data_type) {
+      using Type = typename decltype(data_type)::type;
+      auto values = std::vector<Type>{};
+      values.reserve(size);
+      for (auto slice_index = size_t{0}; slice_index < slices.size(); ++slice_index) {
+        const auto segment = table.pin_chunk(slices[slice_index].candidate->chunk_id)->get_segment(column_id);
+        segment_iterate<Type>(*segment, slice_offsets[slice_index],
+                              [&](const auto& value, const auto) { values.emplace_back(value); });
+      }
+      chunk->add_segment(table.encode_with_global_dictionary(
+          column_id, std::make_shared<DictionarySegment<Type>>(std::span<const Type>{values})));
+    });
+  }
+
+  if (table.uses_mvcc() == UseMvcc::Yes) {
+    auto mvcc_data = std::make_shared<MvccData>(size);
+    auto row = ChunkOffset{0};
+    for (auto slice_index = size_t{0}; slice_index < slices.size(); ++slice_index) {
+      const auto old_mvcc_data = table.pin_chunk(slices[slice_index].candidate->chunk_id)->mvcc_data();
+      for (const auto chunk_offset : slice_offsets[slice_index]) {
+        // Rows of chunks without MVCC columns were added as committed
+        const auto begin_cid = old_mvcc_data ? old_mvcc_data->begin_cids[chunk_offset].load() : CommitID{0};
+        const auto end_cid = old_mvcc_data ? old_mvcc_data->end_cids[chunk_offset].load() : MAX_COMMIT_ID;
+        mvcc_data->begin_cids[row].store(begin_cid, std::memory_order_relaxed);
+        mvcc_data->end_cids[row].store(end_cid, std::memory_order_relaxed);
+        if (end_cid != MAX_COMMIT_ID) ++mvcc_data->invalid_row_count;
+        ++row;
+      }
+    }
+    chunk->set_mvcc_data(std::move(mvcc_data));
+  }
+  return chunk;
+}
+
+}  // namespace
+
+ChunkCompactor::ChunkCompactor(const std::string& table_name, const double fill_threshold)
+    : _table_name(table_name), _fill_threshold(fill_threshold) {}
+
+size_t ChunkCompactor::compact() {
+  const auto lock = std::lock_guard{_mutex};
+  const auto table = StorageManager::get().get_table(_table_name);
+  const auto chunk_count = table->chunk_count();
+  const auto fill_limit = _fill_threshold * static_cast<double>(table->target_chunk_size());
+
+  auto candidates = std::vector<CandidateChunk>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->pin_chunk(chunk_id);
+    if (chunk->is_mutable()) continue;
+    const auto invalid_row_count = chunk->mvcc_data() ? chunk->mvcc_data()->invalid_row_count.load() : ChunkOffset{0};
+    if (static_cast<double>(chunk->size() - invalid_row_count) < fill_limit) {
+      candidates.emplace_back();
+      candidates.back().chunk_id = chunk_id;
+    }
+  }
+  const auto oldest_snapshot_commit_id = TransactionManager::get().oldest_snapshot_commit_id();
+  parallel_for(candidates.size(), [&](const size_t candidate_index) {
+    auto& candidate = candidates[candidate_index];
+    lock_rows(*table->pin_chunk(candidate.chunk_id), oldest_snapshot_commit_id, candidate);
+  });
+
+  // Each run of adjacent locked candidates is merged into new chunks, unless it is a single chunk without rows to drop
+  auto runs = std::vector<std::pair<size_t, size_t>>{};
+  for (auto run_begin = size_t{0}; run_begin < candidates.size();) {
+    auto run_end = run_begin + 1;
+    if (candidates[run_begin].is_locked) {
+      while (run_end < candidates.size() && candidates[run_end].is_locked &&
+             candidates[run_end].chunk_id == candidates[run_end - 1].chunk_id + 1) {
+        ++run_end;
+      }
+      const auto& first_candidate = candidates[run_begin];
+      if (run_end - run_begin > 1 ||
+          first_candidate.kept_offsets.size() < table->pin_chunk(first_candidate.chunk_id)->size()) {
+        runs.emplace_back(run_begin, run_end);
+      } else {
+        unlock_rows(*table->pin_chunk(first_candidate.chunk_id), first_candidate);
+      }
+    }
+    run_begin = run_end;
+  }
+  if (runs.empty()) return 0;
+
+  // The kept rows of each run are split into chunks of target_chunk_size rows
+  const auto target_chunk_size = size_t{table->target_chunk_size()};
+  auto chunk_slices = std::vector<std::vector<RowSlice>>{};
+  auto run_chunk_counts = std::vector<size_t>{};
+  for (const auto& [run_begin, run_end] : runs) {
+    const auto first_chunk_index = chunk_slices.size();
+    auto chunk_size = target_chunk_size;
+    for (auto candidate_index = run_begin; candidate_index < run_end; ++candidate_index) {
+      const auto& candidate = candidates[candidate_index];
+      for (auto begin = size_t{0}; begin < candidate.kept_offsets.size();) {
+        if (chunk_size == target_chunk_size) {
+          chunk_slices.emplace_back();
+          chunk_size = 0;
+        }
+        const auto end = std::min(candidate.kept_offsets.size(), begin + target_chunk_size - chunk_size);
+        chunk_slices.back().push_back({&candidate, begin, end});
+        chunk_size += end - begin;
+        begin = end;
+      }
+    }
+    run_chunk_counts.push_back(chunk_slices.size() - first_chunk_index);
+  }
+
+  auto merged_chunks = std::vector<std::shared_ptr<Chunk>>(chunk_slices.size());
+  parallel_for(chunk_slices.size(), [&](const size_t chunk_index) {
+    merged_chunks[chunk_index] = merge_rows(*table, chunk_slices[chunk_index]);
+  });
+
+  // The new version of the table consists of the merged chunks in place of the runs and shares all other chunks
+  auto replacements = std::vector<ChunkRunReplacement>{};
+  auto removed_chunk_count = size_t{0};
+  auto merged_chunk = merged_chunks.begin();
+  for (auto run_index = size_t{0}; run_index < runs.size(); ++run_index) {
+    const auto [run_begin, run_end] = runs[run_index];
+    const auto run_chunk_count = run_chunk_counts[run_index];
+    const auto run_merged_chunks_end = merged_chunk + static_cast<std::ptrdiff_t>(run_chunk_count);
+    replacements.push_back({candidates[run_begin].chunk_id, ChunkID{candidates[run_end - 1].chunk_id + 1},
+                            std::vector<std::shared_ptr<Chunk>>(merged_chunk, run_merged_chunks_end)});
+    merged_chunk = run_merged_chunks_end;
+    removed_chunk_count += (run_end - run_begin) - run_chunk_count;
+  }
+
+  // Chunks that are replaced in the old table (e.g., by a DeltaMerger) until it is handed over would be missing in the
+  // new one
+  const auto replacement_lock = table->block_chunk_replacements();
+  const auto compacted_table = table->create_successor(chunk_count, std::move(replacements), replacement_lock);
+  StorageManager::get().replace_table(_table_name, compacted_table, chunk_count);
+  return removed_chunk_count;
+}
+
+}  // namespace opossum
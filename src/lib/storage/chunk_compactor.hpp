@@ -0,0 +1,43 @@
+#pragma once
+
+#include <mutex>
+#include <string>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Compacts a table of the StorageManager. Tables that were loaded in many small batches end up with many small
+ * chunks, and tables with many deletes end up with chunks of mostly invalid rows, so that the overhead per chunk
+ * (segments, dictionaries, virtual calls) dominates scans. Compaction merges each run of adjacent immutable chunks
+ * with fewer valid rows than the fill threshold into full chunks of target_chunk_size rows, drops the rows that no
+ * transaction can see anymore (deleted before the oldest snapshot, or rolled back), and dictionary-encodes the rows.
+ *
+ * The compacted table is a new version of the table that shares all other chunks with the old one. It replaces the
+ * old one in the StorageManager at once (see StorageManager::replace_table), so the chunk list changes atomically for
+ * readers: queries that hold the old table keep reading its chunks, and appends go to the new one from then on (see
+ * Table::hand_over). Chunk replacements (e.g., by a DeltaMerger) are blocked while the new version is created and
+ * handed over, so that none of them is lost, and later ones are forwarded to it. The rows of the merged chunks stay
+ * locked in the old chunks, so that transactions that try to delete them through the old table get a conflict and
+ * retry on the new one. Chunks with rows that a transaction is inserting or deleting at the moment are left as they
+ * are.
+ *
+ * compact() is meant to be called periodically from a background thread, only one compaction runs at a time.
+ */
+class ChunkCompactor : private Noncopyable {
+ public:
+  // Chunks with fewer valid rows than fill_threshold * target_chunk_size are merged
+  explicit ChunkCompactor(const std::string& table_name, const double fill_threshold = 0.5);
+
+  // Compacts the table and returns the number of chunks that were removed
+  size_t compact();
+
+ protected:
+  const std::string _table_name;
+  const double _fill_threshold;
+
+  std::mutex _mutex;
+};
+
+}  // namespace opossum
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <span>
+#include <string>
+#include <vector>
+
+#include <boost/hana/for_each.hpp>
+
+#include "all_type_variant.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * A non-owning view of the values of one column, e.g., of a std::vector<int32_t>, which is used to append many rows to
+ * a Table or Chunk at once (see Table::append_columns). The data type is part of the view, so that the views of
+ * columns of different types can be passed in one std::vector:
+ *
+ *   const auto ids = std::vector<int32_t>{1, 2, 3};
+ *   const auto names = std::vector<std::string>{"a", "b", "c"};
+ *   table->append_columns({ids, names});
+ */
+class ColumnSpan {
+ public:
+  template <typename T>
+  ColumnSpan(const std::span<const T> values)  // NOLINT(runtime/explicit)
+      : _data(values.data()), _size(values.size()), _which(detail::index_of(types, hana::type_c<T>)) {}
+
+  template <typename T>
+  ColumnSpan(const std::vector<T>& values) : ColumnSpan(std::span<const T>{values}) {}  // NOLINT(runtime/explicit)
+
+  size_t size() const { return _size; }
+
+  // The index of the data type in data_types, as for AllTypeVariant::which()
+  size_t which() const { return _which; }
+
+  // Returns the values, T has to be the data type of the column
+  template <typename T>
+  std::span<const T> values() const {
+    Assert(_which == detail::index_of(types, hana::type_c<T>), "ColumnSpan has a different data type");
+    return {static_cast<const T*>(_data), _size};
+  }
+
+  // Returns a view of the values [offset, offset + count)
+  ColumnSpan subspan(const size_t offset, const size_t count) const {
+    DebugAssert(offset + count <= _size, "Subspan is out of bounds");
+    auto span = *this;
+    span._data = static_cast<const char*>(_data) + offset * _element_size();
+    span._size = count;
+    return span;
+  }
+
+  // Calls func with the values as a std::span<const T> of the data type of the column
+  template <typename Functor>
+  void resolve(const Functor& func) const {
+    hana::for_each(types, [&](auto type) {
+      using Type = typename decltype(type)::type;
+      if (_which == detail::index_of(types, hana::type_c<Type>)) func(values<Type>());
+    });
+  }
+
+ protected:
+  size_t _element_size() const {
+    auto element_size = size_t{0};
+    hana::for_each(types, [&](auto type) {
+      using Type = typename decltype(type)::type;
+      if (_which == detail::index_of(types, hana::type_c<Type>)) element_size = sizeof(Type);
+    });
+    return element_size;
+  }
+
+  const void* _data;
+  size_t _size;
+  size_t _which;
+};
+
+}  // namespace opossum
@@ -0,0 +1,75 @@
+#include "delta_merger.hpp"
+
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+DeltaMerger::DeltaMerger(const std::shared_ptr<Table>& table) : _table(table) {}
+
+size_t DeltaMerger::merge() {
+  const auto lock = std::lock_guard{_mutex};
+  // The chunk ids of a successor are different, so its delta is searched from the start. The rows merged into the
+  // chunks shared with it are merged again.
+  while (const auto successor = _table->successor()) {
+    _table = successor;
+    _first_delta_chunk_id = ChunkID{0};
+    _merged_segments.clear();
+  }
+
+  const auto column_count = _table->column_count();
+  if (column_count == 0) return 0;
+
+  auto moved_chunk_count = size_t{0};
+  const auto chunk_count = _table->chunk_count();
+  for (auto chunk_id = _first_delta_chunk_id; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = _table->pin_chunk(chunk_id);
+    if (!chunk->is_mutable()) {
+      if (chunk_id == _first_delta_chunk_id) ++_first_delta_chunk_id;
+      continue;
+    }
+
+    // Rows that are appended from now on are left to the next merge
+    const auto size = chunk->size();
+    auto& merged_segments = _merged_segments[chunk_id];
+    const auto merged_size = merged_segments.empty() ? ChunkOffset{0} : merged_segments.front()->size();
+    if (size == merged_size) continue;
+
+    auto segments = std::vector<std::shared_ptr<BaseSegment>>(column_count);
+    parallel_for(column_count, [&](const size_t column_index) {
+      const auto column_id = ColumnID{static_cast<ColumnID::base_type>(column_index)};
+      resolve_data_type(_table->column_type(column_id), [&](auto data_type) {
+        using Type = typename decltype(data_type)::type;
+        const auto& value_segment = static_cast<const ValueSegment<Type>&>(*chunk->get_segment(column_id));
+        const auto values = value_segment.values().first(size);
+        if (merged_segments.empty()) {
+          segments[column_id] = std::make_shared<DictionarySegment<Type>>(values);
+        } else {
+          const auto& main = static_cast<const DictionarySegment<Type>&>(*merged_segments[column_id]);
+          segments[column_id] = std::make_shared<DictionarySegment<Type>>(main, values.subspan(merged_size));
+        }
+      });
+    });
+
+    if (size < chunk->capacity()) {
+      merged_segments = std::move(segments);
+      continue;
+    }
+
+    _table->replace_chunk(chunk_id, std::move(segments));
+    _merged_segments.erase(chunk_id);
+    ++moved_chunk_count;
+    if (chunk_id == _first_delta_chunk_id) ++_first_delta_chunk_id;
+  }
+  return moved_chunk_count;
+}
+
+}  // namespace opossum
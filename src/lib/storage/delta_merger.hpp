@@ -0,0 +1,49 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class BaseSegment;
+class Table;
+
+/**
+ * Merges the delta of a table into its main store. The delta consists of the mutable chunks, which rows are appended
+ * to without locks (see Chunk::try_append) and which hold write-optimized ValueSegments. The main store consists of
+ * the immutable, dictionary-encoded chunks, which are read-optimized.
+ *
+ * Each merge encodes the rows that were appended to a mutable chunk since the previous merge and merges them into the
+ * dictionary segments of the rows merged before (see DictionarySegment), so the encoding work is spread over the
+ * merges instead of being done at once when the chunk is full. Once a chunk is full, the merged segments replace it
+ * (see Table::replace_chunk). Neither reads nor appends are blocked by a merge: readers see the ValueSegments of a
+ * chunk until it is replaced by the dictionary-encoded chunk with the same rows. Readers that pinned the chunk before
+ * (see Table::pin_chunk) keep it alive until they are done with it.
+ *
+ * Once the table was compacted (see ChunkCompactor), rows are only appended to its successor (see Table::hand_over),
+ * so the merger follows the table to its successors.
+ *
+ * merge() is meant to be called periodically from a background thread, only one merge runs at a time.
+ */
+class DeltaMerger : private Noncopyable {
+ public:
+  explicit DeltaMerger(const std::shared_ptr<Table>& table);
+
+  // Merges the rows appended since the last merge and returns the number of chunks that were moved to the main store
+  size_t merge();
+
+ protected:
+  std::shared_ptr<Table> _table;
+
+  std::mutex _mutex;
+  // All chunks before this one are in the main store
+  ChunkID _first_delta_chunk_id{0};
+  // The dictionary segments of the rows merged so far, by the id of the mutable chunk they belong to
+  std::map<ChunkID, std::vector<std::shared_ptr<BaseSegment>>> _merged_segments;
+};
+
+}  // namespace opossum
@@ -0,0 +1,7 @@
+#include "dictionary_segment.hpp"
+
+namespace opossum {
+
+EXPLICITLY_INSTANTIATE_DATA_TYPES(DictionarySegment);
+
+}  // namespace opossum
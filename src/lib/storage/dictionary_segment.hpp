@@ -1,19 +1,23 @@
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "all_type_variant.hpp"
+#include "base_segment.hpp"
+#include "fixed_size_attribute_vector.hpp"
+#include "type_cast.hpp"
 #include "types.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
 
 namespace opossum {
 
-class BaseAttributeVector;
-class BaseSegment;
-
 // Even though ValueIDs do not have to use the full width of ValueID (uint32_t), this will also work for smaller ValueID
 // types (uint8_t, uint16_t) since after a down-cast INVALID_VALUE_ID will look like their numeric_limit::max()
 constexpr ValueID INVALID_VALUE_ID{std::numeric_limits<ValueID::base_type>::max()};
@@ -25,53 +29,177 @@ class DictionarySegment : public BaseSegment {
   /**
    * Creates a Dictionary segment from a given value segment.
    */
-  explicit DictionarySegment(const std::shared_ptr<BaseSegment>& base_segment);
+  explicit DictionarySegment(const std::shared_ptr<BaseSegment>& base_segment)
+      : DictionarySegment(_values_of(base_segment)) {}
 
-  // SEMINAR INFORMATION: Since most of these methods depend on the template parameter, you will have to implement
-  // the DictionarySegment in this file. Replace the method signatures with actual implementations.
+  /**
+   * Creates a Dictionary segment from the given values, e.g., the first rows of a ValueSegment that is still being
+   * appended to.
+   */
+  explicit DictionarySegment(const std::span<const T> values) {
+    _dictionary = std::make_shared<std::vector<T>>(values.begin(), values.end());
+    std::sort(_dictionary->begin(), _dictionary->end());
+    _dictionary->erase(std::unique(_dictionary->begin(), _dictionary->end()), _dictionary->end());
+    _dictionary->shrink_to_fit();
+
+    _attribute_vector = make_attribute_vector(_dictionary->size(), values.size());
+    for (auto chunk_offset = size_t{0}; chunk_offset < values.size(); ++chunk_offset) {
+      _attribute_vector->set(chunk_offset, lower_bound(values[chunk_offset]));
+    }
+  }
+
+  /**
+   * Creates a Dictionary segment that holds the values of main followed by the delta values (see DeltaMerger). The
+   * sorted distinct delta values are merged into the dictionary of main in a single pass, which also yields the new
+   * value id of every old one. The value ids of main are then remapped in one pass without decoding its values.
+   */
+  DictionarySegment(const DictionarySegment<T>& main, const std::span<const T> delta) {
+    auto delta_dictionary = std::vector<T>(delta.begin(), delta.end());
+    std::sort(delta_dictionary.begin(), delta_dictionary.end());
+    delta_dictionary.erase(std::unique(delta_dictionary.begin(), delta_dictionary.end()), delta_dictionary.end());
+
+    const auto& main_dictionary = *main._dictionary;
+    _dictionary = std::make_shared<std::vector<T>>();
+    _dictionary->reserve(main_dictionary.size() + delta_dictionary.size());
+    auto new_value_ids = std::vector<ValueID>(main_dictionary.size());
+    auto main_index = size_t{0};
+    auto delta_index = size_t{0};
+    while (main_index < main_dictionary.size() || delta_index < delta_dictionary.size()) {
+      if (delta_index == delta_dictionary.size() ||
+          (main_index < main_dictionary.size() && !(delta_dictionary[delta_index] < main_dictionary[main_index]))) {
+        // Values that are in both dictionaries are taken from main
+        if (delta_index < delta_dictionary.size() && !(main_dictionary[main_index] < delta_dictionary[delta_index])) {
+          ++delta_index;
+        }
+        new_value_ids[main_index] = ValueID{static_cast<ValueID::base_type>(_dictionary->size())};
+        _dictionary->push_back(main_dictionary[main_index]);
+        ++main_index;
+      } else {
+        _dictionary->push_back(delta_dictionary[delta_index]);
+        ++delta_index;
+      }
+    }
+    _dictionary->shrink_to_fit();
+
+    const auto main_size = main.size();
+    _attribute_vector = make_attribute_vector(_dictionary->size(), main_size + delta.size());
+    resolve_attribute_vector(*main._attribute_vector, [&](const auto value_ids) {
+      for (auto chunk_offset = size_t{0}; chunk_offset < value_ids.size(); ++chunk_offset) {
+        _attribute_vector->set(chunk_offset, new_value_ids[value_ids[chunk_offset]]);
+      }
+    });
+    for (auto delta_offset = size_t{0}; delta_offset < delta.size(); ++delta_offset) {
+      _attribute_vector->set(main_size + delta_offset, lower_bound(delta[delta_offset]));
+    }
+  }
+
+  /**
+   * Creates a Dictionary segment that holds the values of segment, but shares the dictionary of dictionary_segment,
+   * which has to contain all of them (e.g., the table-wide dictionary of a column, see Table::use_global_dictionary).
+   * Every value id of segment is mapped once, and the attribute vector is remapped in one pass.
+   */
+  DictionarySegment(const DictionarySegment<T>& segment, const DictionarySegment<T>& dictionary_segment)
+      : _dictionary(dictionary_segment._dictionary) {
+    const auto& old_dictionary = *segment._dictionary;
+    auto new_value_ids = std::vector<ValueID>(old_dictionary.size());
+    for (auto value_id = size_t{0}; value_id < old_dictionary.size(); ++value_id) {
+      const auto new_value_id = lower_bound(old_dictionary[value_id]);
+      Assert(new_value_id != INVALID_VALUE_ID && (*_dictionary)[new_value_id] == old_dictionary[value_id],
+             "Dictionary has to contain all values of the segment");
+      new_value_ids[value_id] = new_value_id;
+    }
+
+    _attribute_vector = make_attribute_vector(_dictionary->size(), segment.size());
+    resolve_attribute_vector(*segment._attribute_vector, [&](const auto value_ids) {
+      for (auto chunk_offset = size_t{0}; chunk_offset < value_ids.size(); ++chunk_offset) {
+        _attribute_vector->set(chunk_offset, new_value_ids[value_ids[chunk_offset]]);
+      }
+    });
+  }
+
+  /**
+   * Creates a Dictionary segment from an already sorted dictionary without duplicates and an attribute vector of
+   * value ids into it, e.g., when reading a segment that was written to disk.
+   */
+  DictionarySegment(const std::shared_ptr<std::vector<T>>& dictionary,
+                    const std::shared_ptr<BaseAttributeVector>& attribute_vector)
+      : _dictionary(dictionary), _attribute_vector(attribute_vector) {
+    DebugAssert(std::is_sorted(_dictionary->cbegin(), _dictionary->cend()), "Dictionary has to be sorted");
+  }
 
   // return the value at a certain position. If you want to write efficient operators, back off!
-  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override { return get(chunk_offset); }
 
   // return the value at a certain position.
-  T get(const size_t chunk_offset) const;
+  T get(const size_t chunk_offset) const { return value_by_value_id(_attribute_vector->get(chunk_offset)); }
+
+  TypedValue typed_value(const ChunkOffset chunk_offset) const override {
+    return TypedValue{value_by_value_id(_attribute_vector->get(chunk_offset))};
+  }
 
   // dictionary segments are immutable
-  void append(const AllTypeVariant& val) override;
+  void append(const AllTypeVariant& val) override { Fail("DictionarySegment is immutable"); }
+
+  void append(const TypedValue& /*value*/) override { Fail("DictionarySegment is immutable"); }
 
   // returns an underlying dictionary
-  std::shared_ptr<const std::vector<T>> dictionary() const;
+  std::shared_ptr<const std::vector<T>> dictionary() const { return _dictionary; }
 
   // returns an underlying data structure
-  std::shared_ptr<const BaseAttributeVector> attribute_vector() const;
+  std::shared_ptr<const BaseAttributeVector> attribute_vector() const { return _attribute_vector; }
 
   // return the value represented by a given ValueID
-  const T& value_by_value_id(ValueID value_id) const;
+  const T& value_by_value_id(ValueID value_id) const {
+    DebugAssert(value_id < _dictionary->size(), "ValueID is out of bounds");
+    return (*_dictionary)[value_id];
+  }
 
   // returns the first value ID that refers to a value >= the search value
   // returns INVALID_VALUE_ID if all values are smaller than the search value
-  ValueID lower_bound(T value) const;
+  ValueID lower_bound(T value) const {
+    const auto it = std::lower_bound(_dictionary->cbegin(), _dictionary->cend(), value);
+    if (it == _dictionary->cend()) return INVALID_VALUE_ID;
+    return ValueID{static_cast<ValueID::base_type>(std::distance(_dictionary->cbegin(), it))};
+  }
 
   // same as lower_bound(T), but accepts an AllTypeVariant
-  ValueID lower_bound(const AllTypeVariant& value) const;
+  ValueID lower_bound(const AllTypeVariant& value) const { return lower_bound(type_cast<T>(value)); }
+
+  // same as lower_bound(T), but accepts a TypedValue
+  ValueID lower_bound(const TypedValue& value) const { return lower_bound(type_cast<T>(value)); }
 
   // returns the first value ID that refers to a value > the search value
   // returns INVALID_VALUE_ID if all values are smaller than or equal to the search value
-  ValueID upper_bound(T value) const;
+  ValueID upper_bound(T value) const {
+    const auto it = std::upper_bound(_dictionary->cbegin(), _dictionary->cend(), value);
+    if (it == _dictionary->cend()) return INVALID_VALUE_ID;
+    return ValueID{static_cast<ValueID::base_type>(std::distance(_dictionary->cbegin(), it))};
+  }
 
   // same as upper_bound(T), but accepts an AllTypeVariant
-  ValueID upper_bound(const AllTypeVariant& value) const;
+  ValueID upper_bound(const AllTypeVariant& value) const { return upper_bound(type_cast<T>(value)); }
+
+  // same as upper_bound(T), but accepts a TypedValue
+  ValueID upper_bound(const TypedValue& value) const { return upper_bound(type_cast<T>(value)); }
 
   // return the number of unique_values (dictionary entries)
-  size_t unique_values_count() const;
+  size_t unique_values_count() const { return _dictionary->size(); }
 
   // return the number of entries
-  ChunkOffset size() const override;
+  ChunkOffset size() const override { return static_cast<ChunkOffset>(_attribute_vector->size()); }
 
   // returns the calculated memory usage
-  size_t estimate_memory_usage() const final;
+  size_t estimate_memory_usage() const final {
+    return sizeof(T) * _dictionary->size() + _attribute_vector->width() * _attribute_vector->size();
+  }
 
  protected:
+  static std::span<const T> _values_of(const std::shared_ptr<BaseSegment>& base_segment) {
+    const auto value_segment = std::dynamic_pointer_cast<ValueSegment<T>>(base_segment);
+    Assert(value_segment, "DictionarySegment can only be created from a ValueSegment of the same type");
+    return value_segment->values();
+  }
+
   std::shared_ptr<std::vector<T>> _dictionary;
   std::shared_ptr<BaseAttributeVector> _attribute_vector;
 };
@@ -0,0 +1,79 @@
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "base_attribute_vector.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+// FixedSizeAttributeVector stores value ids using the smallest unsigned integer type (uint8_t, uint16_t, uint32_t)
+// that can represent all value ids of the dictionary
+template <typename uintX_t>
+class FixedSizeAttributeVector : public BaseAttributeVector {
+ public:
+  explicit FixedSizeAttributeVector(const size_t size) : _owned_value_ids(size), _value_ids(_owned_value_ids) {}
+
+  // Uses value ids that are stored elsewhere, e.g., in a memory-mapped file, without copying them. Such an attribute
+  // vector is immutable and keeps the owner of the memory alive.
+  FixedSizeAttributeVector(const std::span<const uintX_t> value_ids, const std::shared_ptr<const void>& owner)
+      : _value_ids(value_ids), _owner(owner) {}
+
+  ValueID get(const size_t i) const final { return ValueID{_value_ids[i]}; }
+
+  void set(const size_t i, const ValueID value_id) final {
+    DebugAssert(!_owner, "Attribute vectors of external memory are immutable");
+    DebugAssert(i < _value_ids.size(), "Position is out of bounds");
+    DebugAssert(value_id <= std::numeric_limits<uintX_t>::max(), "ValueID is too large for this attribute vector");
+    _owned_value_ids[i] = static_cast<uintX_t>(value_id);
+  }
+
+  size_t size() const final { return _value_ids.size(); }
+
+  AttributeVectorWidth width() const final { return sizeof(uintX_t); }
+
+  // Returns all value ids. Operators should use this (see resolve_attribute_vector) instead of the virtual get().
+  std::span<const uintX_t> value_ids() const { return _value_ids; }
+
+ protected:
+  std::vector<uintX_t> _owned_value_ids;
+  // Points to either _owned_value_ids or external memory. Moving the vector keeps its buffer, so this stays valid.
+  std::span<const uintX_t> _value_ids;
+  std::shared_ptr<const void> _owner;
+};
+
+// Creates an attribute vector that is wide enough to store value ids up to (excluding) unique_values_count
+inline std::shared_ptr<BaseAttributeVector> make_attribute_vector(const size_t unique_values_count, const size_t size) {
+  if (unique_values_count <= std::numeric_limits<uint8_t>::max()) {
+    return std::make_shared<FixedSizeAttributeVector<uint8_t>>(size);
+  }
+  if (unique_values_count <= std::numeric_limits<uint16_t>::max()) {
+    return std::make_shared<FixedSizeAttributeVector<uint16_t>>(size);
+  }
+  return std::make_shared<FixedSizeAttributeVector<uint32_t>>(size);
+}
+
+// Resolves the concrete width of an attribute vector and passes its value ids (a std::span<const uintX_t>) on to a
+// generic lambda, so that tight loops over value ids do not have to go through BaseAttributeVector::get().
+template <typename Functor>
+void resolve_attribute_vector(const BaseAttributeVector& attribute_vector, const Functor& func) {
+  switch (attribute_vector.width()) {
+    case 1:
+      func(static_cast<const FixedSizeAttributeVector<uint8_t>&>(attribute_vector).value_ids());
+      break;
+    case 2:
+      func(static_cast<const FixedSizeAttributeVector<uint16_t>&>(attribute_vector).value_ids());
+      break;
+    case 4:
+      func(static_cast<const FixedSizeAttributeVector<uint32_t>&>(attribute_vector).value_ids());
+      break;
+    default:
+      Fail("Unsupported attribute vector width");
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,10 @@
+#include "mvcc_data.hpp"
+
+namespace opossum {
+
+MvccData::MvccData(const ChunkOffset size) : begin_cids(size), end_cids(size), tids(size) {
+  for (auto& begin_cid : begin_cids) begin_cid.store(MAX_COMMIT_ID, std::memory_order_relaxed);
+  for (auto& end_cid : end_cids) end_cid.store(MAX_COMMIT_ID, std::memory_order_relaxed);
+}
+
+}  // namespace opossum
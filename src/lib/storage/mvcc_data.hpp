@@ -0,0 +1,51 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * The MVCC columns of a chunk of a table that uses MVCC. For every row, they hold the commit ID of the transaction that
+ * inserted it (begin), the commit ID of the transaction that deleted it (end), and the ID of the transaction that is
+ * inserting or deleting it at the moment. Each is a vector of 32 bit atomics, so that transactions can change them
+ * while other ones read them. The vectors are allocated for the capacity of the chunk, so they never move.
+ *
+ * A row is visible to a transaction if the transaction inserted it itself and the insert is not committed yet, or if
+ * another transaction inserted it before the snapshot of the transaction and nobody deleted it before the snapshot.
+ * So rows inserted by a transaction become visible to later snapshots all at once, when it commits.
+ */
+struct MvccData : private Noncopyable {
+  explicit MvccData(const ChunkOffset size);
+
+  bool is_visible(const ChunkOffset chunk_offset, const TransactionID transaction_id,
+                  const CommitID snapshot_commit_id) const {
+    const auto row_transaction_id = tids[chunk_offset].load(std::memory_order_relaxed);
+    const auto begin_cid = begin_cids[chunk_offset].load(std::memory_order_relaxed);
+    const auto end_cid = end_cids[chunk_offset].load(std::memory_order_relaxed);
+    const auto own_insert =
+        row_transaction_id == transaction_id && begin_cid == MAX_COMMIT_ID && end_cid == MAX_COMMIT_ID;
+    const auto past_insert =
+        row_transaction_id != transaction_id && begin_cid <= snapshot_commit_id && end_cid > snapshot_commit_id;
+    return own_insert || past_insert;
+  }
+
+  std::vector<std::atomic<CommitID>> begin_cids;
+  std::vector<std::atomic<CommitID>> end_cids;
+  std::vector<std::atomic<TransactionID>> tids;
+
+  // The number of rows that were deleted or whose insert was rolled back
+  std::atomic<ChunkOffset> invalid_row_count{0};
+};
+
+// Rows [begin, end) of the chunk with the given MVCC columns
+struct MvccRowRange {
+  std::shared_ptr<MvccData> mvcc_data;
+  ChunkOffset begin;
+  ChunkOffset end;
+};
+
+}  // namespace opossum
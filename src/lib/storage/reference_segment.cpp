@@ -0,0 +1,107 @@
+#include "reference_segment.hpp"
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace opossum {
+
+ReferenceSegment::ReferenceSegment(const std::shared_ptr<const Table>& referenced_table,
+                                   const ColumnID referenced_column_id, const std::shared_ptr<const PosList>& pos)
+    : _referenced_table(referenced_table), _referenced_column_id(referenced_column_id), _pos_list(pos) {
+  // Operators reference the original table (see make_reference_chunk), so that every value is one indirection away
+  DebugAssert(referenced_table->chunk_count() == 0 || referenced_table->pin_chunk(ChunkID{0})->column_count() == 0 ||
+                  !std::dynamic_pointer_cast<const ReferenceSegment>(
+                      referenced_table->pin_chunk(ChunkID{0})->get_segment(referenced_column_id)),
+              "ReferenceSegments must not reference ReferenceSegments");
+}
+
+AllTypeVariant ReferenceSegment::operator[](const ChunkOffset chunk_offset) const {
+  DebugAssert(chunk_offset < _pos_list->size(), "ChunkOffset is out of bounds");
+  const auto& row_id = (*_pos_list)[chunk_offset];
+  const auto chunk = _referenced_table->pin_chunk(row_id.chunk_id);
+  return (*chunk->get_segment(_referenced_column_id))[row_id.chunk_offset];
+}
+
+TypedValue ReferenceSegment::typed_value(const ChunkOffset chunk_offset) const {
+  DebugAssert(chunk_offset < _pos_list->size(), "ChunkOffset is out of bounds");
+  const auto& row_id = (*_pos_list)[chunk_offset];
+  const auto chunk = _referenced_table->pin_chunk(row_id.chunk_id);
+  return chunk->get_segment(_referenced_column_id)->typed_value(row_id.chunk_offset);
+}
+
+ChunkOffset ReferenceSegment::size() const { return static_cast<ChunkOffset>(_pos_list->size()); }
+
+const std::shared_ptr<const PosList>& ReferenceSegment::pos_list() const { return _pos_list; }
+
+const std::shared_ptr<const Table>& ReferenceSegment::referenced_table() const { return _referenced_table; }
+
+ColumnID ReferenceSegment::referenced_column_id() const { return _referenced_column_id; }
+
+size_t ReferenceSegment::estimate_memory_usage() const { return sizeof(RowID) * _pos_list->size(); }
+
+Chunk make_reference_chunk(const std::shared_ptr<const Table>& table, const PosList& positions) {
+  auto chunk = Chunk{};
+
+  // Maps the input PosLists that a column is backed by (one entry per run of positions in the same chunk, nullptr for
+  // non-reference segments) to the output PosList created for it
+  auto output_pos_lists = std::map<std::vector<const PosList*>, std::shared_ptr<const PosList>>{};
+
+  for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+    auto input_pos_lists = std::vector<const PosList*>{};
+    auto referenced_table = table;
+    auto referenced_column_id = column_id;
+
+    // An empty position list does not tell us which table the input references, so we look at the first chunk
+    if (positions.empty() && table->chunk_count() > 0 && table->pin_chunk(ChunkID{0})->column_count() > 0) {
+      const auto segment = table->pin_chunk(ChunkID{0})->get_segment(column_id);
+      if (const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(segment)) {
+        referenced_table = reference_segment->referenced_table();
+        referenced_column_id = reference_segment->referenced_column_id();
+        input_pos_lists.push_back(reference_segment->pos_list().get());
+      }
+    }
+
+    // The output segment can only reference one table, so all runs have to resolve to the same table and column
+    auto current_chunk_id = INVALID_CHUNK_ID;
+    for (const auto& position : positions) {
+      if (position.chunk_id == current_chunk_id) continue;
+
+      const auto segment = table->pin_chunk(position.chunk_id)->get_segment(column_id);
+      const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(segment);
+      input_pos_lists.push_back(reference_segment ? reference_segment->pos_list().get() : nullptr);
+      const auto run_table = reference_segment ? reference_segment->referenced_table() : table;
+      const auto run_column_id = reference_segment ? reference_segment->referenced_column_id() : column_id;
+      Assert(current_chunk_id == INVALID_CHUNK_ID ||
+                 (run_table == referenced_table && run_column_id == referenced_column_id),
+             "All positions have to resolve to the same referenced table and column");
+      referenced_table = run_table;
+      referenced_column_id = run_column_id;
+      current_chunk_id = position.chunk_id;
+    }
+
+    auto& output_pos_list = output_pos_lists[input_pos_lists];
+    if (!output_pos_list) {
+      auto pos_list = std::make_shared<PosList>();
+      pos_list->reserve(positions.size());
+
+      auto run_index = size_t{0};
+      current_chunk_id = INVALID_CHUNK_ID;
+      auto input_pos_list = static_cast<const PosList*>(nullptr);
+      for (const auto& position : positions) {
+        if (position.chunk_id != current_chunk_id) {
+          current_chunk_id = position.chunk_id;
+          input_pos_list = input_pos_lists[run_index++];
+        }
+        pos_list->push_back(input_pos_list ? (*input_pos_list)[position.chunk_offset] : position);
+      }
+      output_pos_list = pos_list;
+    }
+
+    chunk.add_segment(std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, output_pos_list));
+  }
+
+  return chunk;
+}
+
+}  // namespace opossum
@@ -9,6 +9,7 @@
 
 #include "base_segment.hpp"
 #include "dictionary_segment.hpp"
+#include "fixed_size_attribute_vector.hpp"
 #include "table.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
@@ -16,7 +17,8 @@
 
 namespace opossum {
 
-// ReferenceSegment is a specific segment type that stores all its values as position list of a referenced segment
+// ReferenceSegment is a specific segment type that stores all its values as position list of a referenced segment.
+// The referenced table never consists of ReferenceSegments itself, i.e., there is only a single level of references.
 class ReferenceSegment : public BaseSegment {
  public:
   // creates a reference segment
@@ -26,8 +28,12 @@ class ReferenceSegment : public BaseSegment {
 
   AllTypeVariant operator[](const ChunkOffset chunk_offset) const override;
 
+  TypedValue typed_value(const ChunkOffset chunk_offset) const override;
+
   void append(const AllTypeVariant&) override { throw std::logic_error("ReferenceSegment is immutable"); };
 
+  void append(const TypedValue&) override { throw std::logic_error("ReferenceSegment is immutable"); };
+
   ChunkOffset size() const override;
 
   const std::shared_ptr<const PosList>& pos_list() const;
@@ -36,6 +42,124 @@ class ReferenceSegment : public BaseSegment {
   ColumnID referenced_column_id() const;
 
   size_t estimate_memory_usage() const final;
+
+  // Writes the referenced values into output[0, size()), where T has to be the data type of the referenced column.
+  // Unlike operator[], which resolves chunk, segment and value for every position, the referenced segment is resolved
+  // once per group of positions in the same chunk. Positions usually come in runs of the same chunk (e.g., from scans);
+  // if the runs are short (e.g., after a join or sort), the positions are grouped by chunk first. While gathering, the
+  // values prefetch_distance positions ahead are prefetched, so that their cache misses overlap.
+  template <typename T>
+  void gather(T* output, const size_t prefetch_distance = DEFAULT_PREFETCH_DISTANCE) const;
+
+  static constexpr auto DEFAULT_PREFETCH_DISTANCE = size_t{16};
+
+  // Positions are grouped by chunk before gathering if their runs of the same chunk are shorter than this on average
+  static constexpr auto MIN_AVERAGE_RUN_LENGTH = size_t{8};
+
+ protected:
+  // Gathers the values at the chunk offsets offset_at(index) of a single referenced segment for every index in
+  // [0, count) and passes them on to write(index, value)
+  template <typename T, typename OffsetAt, typename Write>
+  static void _gather_from_segment(const BaseSegment& segment, const size_t count, const size_t prefetch_distance,
+                                   const OffsetAt& offset_at, const Write& write);
+
+  const std::shared_ptr<const Table> _referenced_table;
+  const ColumnID _referenced_column_id;
+  const std::shared_ptr<const PosList> _pos_list;
 };
 
+template <typename T>
+void ReferenceSegment::gather(T* output, const size_t prefetch_distance) const {
+  const auto& pos_list = *_pos_list;
+  const auto size = pos_list.size();
+
+  auto run_count = size_t{0};
+  for (auto index = size_t{0}; index < size; ++index) {
+    run_count += index == 0 || pos_list[index].chunk_id != pos_list[index - 1].chunk_id;
+  }
+
+  if (run_count * MIN_AVERAGE_RUN_LENGTH <= size) {
+    auto run_begin = size_t{0};
+    while (run_begin < size) {
+      const auto chunk_id = pos_list[run_begin].chunk_id;
+      auto run_end = run_begin + 1;
+      while (run_end < size && pos_list[run_end].chunk_id == chunk_id) ++run_end;
+
+      const auto run = pos_list.data() + run_begin;
+      const auto run_output = output + run_begin;
+      _gather_from_segment<T>(
+          *_referenced_table->pin_chunk(chunk_id)->get_segment(_referenced_column_id), run_end - run_begin,
+          prefetch_distance, [&](const size_t index) { return run[index].chunk_offset; },
+          [&](const size_t index, const T& value) { run_output[index] = value; });
+      run_begin = run_end;
+    }
+    return;
+  }
+
+  // Groups the positions by chunk with a counting sort, remembering where in the output each of them belongs
+  const auto chunk_count = _referenced_table->chunk_count();
+  auto group_begins = std::vector<size_t>(chunk_count + 1);
+  for (const auto& row_id : pos_list) ++group_begins[row_id.chunk_id + 1];
+  for (auto chunk_id = size_t{0}; chunk_id < chunk_count; ++chunk_id) {
+    group_begins[chunk_id + 1] += group_begins[chunk_id];
+  }
+
+  auto chunk_offsets = std::vector<ChunkOffset>(size);
+  auto output_indices = std::vector<size_t>(size);
+  auto group_ends = std::vector<size_t>(group_begins.cbegin(), group_begins.cend() - 1);
+  for (auto index = size_t{0}; index < size; ++index) {
+    const auto group_index = group_ends[pos_list[index].chunk_id]++;
+    chunk_offsets[group_index] = pos_list[index].chunk_offset;
+    output_indices[group_index] = index;
+  }
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto group_begin = group_begins[chunk_id];
+    const auto group_size = group_begins[chunk_id + 1] - group_begin;
+    if (group_size == 0) continue;
+
+    // The output is written in scattered order, but into memory that the caller usually has just allocated
+    _gather_from_segment<T>(
+        *_referenced_table->pin_chunk(chunk_id)->get_segment(_referenced_column_id), group_size, prefetch_distance,
+        [&](const size_t index) { return chunk_offsets[group_begin + index]; },
+        [&](const size_t index, const T& value) { output[output_indices[group_begin + index]] = value; });
+  }
+}
+
+template <typename T, typename OffsetAt, typename Write>
+void ReferenceSegment::_gather_from_segment(const BaseSegment& segment, const size_t count,
+                                            const size_t prefetch_distance, const OffsetAt& offset_at,
+                                            const Write& write) {
+  if (const auto value_segment = dynamic_cast<const ValueSegment<T>*>(&segment)) {
+    const auto values = value_segment->values();
+    for (auto index = size_t{0}; index < count; ++index) {
+      if (index + prefetch_distance < count) __builtin_prefetch(&values[offset_at(index + prefetch_distance)]);
+      write(index, values[offset_at(index)]);
+    }
+    return;
+  }
+
+  const auto dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment);
+  Assert(dictionary_segment, "ReferenceSegments must reference ValueSegments or DictionarySegments of the same type");
+  const auto& dictionary = *dictionary_segment->dictionary();
+  resolve_attribute_vector(*dictionary_segment->attribute_vector(), [&](const auto& value_ids) {
+    // Two stages: the value id is prefetched first, and once it has arrived, the dictionary entry it points to
+    const auto dictionary_distance = prefetch_distance / 2;
+    for (auto index = size_t{0}; index < count; ++index) {
+      if (index + prefetch_distance < count) __builtin_prefetch(&value_ids[offset_at(index + prefetch_distance)]);
+      if (index + dictionary_distance < count) {
+        __builtin_prefetch(&dictionary[value_ids[offset_at(index + dictionary_distance)]]);
+      }
+      write(index, dictionary[value_ids[offset_at(index)]]);
+    }
+  });
+}
+
+// Creates a chunk of ReferenceSegments that holds the rows of `table` at the given positions. If `table` itself
+// consists of ReferenceSegments, the new segments point to the originally referenced table instead, so that operators
+// never create references to references. Columns that share a PosList in the input also share one in the output.
+// All positions of a column have to resolve to the same table, i.e., `table` must not mix chunks of values with
+// chunks of ReferenceSegments, or ReferenceSegments into different tables.
+Chunk make_reference_chunk(const std::shared_ptr<const Table>& table, const PosList& positions);
+
 }  // namespace opossum
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "base_segment.hpp"
+#include "dictionary_segment.hpp"
+#include "fixed_size_attribute_vector.hpp"
+#include "reference_segment.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+#include "value_segment.hpp"
+
+namespace opossum {
+
+namespace detail {
+
+// Calls func(value, chunk_offset) for the chunk offsets returned by offset_at(index) for every index in [0, count)
+template <typename T, typename OffsetAt, typename Functor>
+void segment_iterate_offsets(const BaseSegment& segment, const ChunkOffset count, const OffsetAt& offset_at,
+                             const Functor& func) {
+  if (const auto value_segment = dynamic_cast<const ValueSegment<T>*>(&segment)) {
+    const auto values = value_segment->values();
+    for (auto index = ChunkOffset{0}; index < count; ++index) {
+      const auto chunk_offset = offset_at(index);
+      func(values[chunk_offset], chunk_offset);
+    }
+  } else if (const auto dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment)) {
+    const auto& dictionary = *dictionary_segment->dictionary();
+    resolve_attribute_vector(*dictionary_segment->attribute_vector(), [&](const auto& value_ids) {
+      for (auto index = ChunkOffset{0}; index < count; ++index) {
+        const auto chunk_offset = offset_at(index);
+        func(dictionary[value_ids[chunk_offset]], chunk_offset);
+      }
+    });
+  } else if (const auto reference_segment = dynamic_cast<const ReferenceSegment*>(&segment)) {
+    const auto& pos_list = *reference_segment->pos_list();
+    const auto& referenced_table = *reference_segment->referenced_table();
+    const auto referenced_column_id = reference_segment->referenced_column_id();
+
+    // Positions usually come in runs of the same chunk, so the referenced segment is resolved once per run
+    auto current_chunk_id = INVALID_CHUNK_ID;
+    // Keeps the referenced segment alive, even if its chunk is replaced (see Table::replace_chunk)
+    auto referenced_segment = std::shared_ptr<const BaseSegment>{};
+    auto referenced_value_segment = static_cast<const ValueSegment<T>*>(nullptr);
+    auto referenced_values = std::span<const T>{};
+    auto referenced_dictionary_segment = static_cast<const DictionarySegment<T>*>(nullptr);
+
+    for (auto index = ChunkOffset{0}; index < count; ++index) {
+      const auto chunk_offset = offset_at(index);
+      const auto& row_id = pos_list[chunk_offset];
+      if (row_id.chunk_id != current_chunk_id) {
+        current_chunk_id = row_id.chunk_id;
+        referenced_segment = referenced_table.pin_chunk(row_id.chunk_id)->get_segment(referenced_column_id);
+        referenced_value_segment = dynamic_cast<const ValueSegment<T>*>(referenced_segment.get());
+        if (referenced_value_segment) referenced_values = referenced_value_segment->values();
+        referenced_dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(referenced_segment.get());
+        Assert(referenced_value_segment || referenced_dictionary_segment,
+               "ReferenceSegments must reference ValueSegments or DictionarySegments of the same data type");
+      }
+
+      if (referenced_value_segment) {
+        func(referenced_values[row_id.chunk_offset], chunk_offset);
+      } else {
+        func(referenced_dictionary_segment->get(row_id.chunk_offset), chunk_offset);
+      }
+    }
+  } else {
+    Fail("Unknown segment type");
+  }
+}
+
+}  // namespace detail
+
+/**
+ * Calls func(const T& value, const ChunkOffset chunk_offset) for the first row_count values of a segment whose data
+ * type T is already known, e.g., from resolve_data_type. The concrete segment type is resolved once per segment (and
+ * once per referenced chunk for ReferenceSegments), so that func is inlined into a tight loop instead of going through
+ * the virtual BaseSegment::operator[] and AllTypeVariant for every value.
+ *
+ * row_count is the size of the chunk, read once by the caller, which also sizes its buffers with it. It must not be
+ * taken from the segment: the ValueSegments of a mutable chunk are published before the chunk itself (see
+ * Chunk::try_append), so they can hold more rows than Chunk::size() returned a moment ago.
+ *
+ * Example:
+ *
+ *   auto sum = int64_t{0};
+ *   segment_iterate<int32_t>(*chunk->get_segment(column_id), chunk_size, [&](const auto value, const auto) {
+ *     sum += value;
+ *   });
+ */
+template <typename T, typename Functor>
+void segment_iterate(const BaseSegment& segment, const ChunkOffset row_count, const Functor& func) {
+  DebugAssert(row_count <= segment.size(), "Segment has fewer rows than requested");
+  detail::segment_iterate_offsets<T>(
+      segment, row_count, [](const ChunkOffset index) { return index; }, func);
+}
+
+// Same as above, but only visits the given chunk offsets, e.g., the rows that qualified for an earlier predicate
+template <typename T, typename Functor>
+void segment_iterate(const BaseSegment& segment, const std::vector<ChunkOffset>& chunk_offsets, const Functor& func) {
+  detail::segment_iterate_offsets<T>(
+      segment, static_cast<ChunkOffset>(chunk_offsets.size()),
+      [&](const ChunkOffset index) { return chunk_offsets[index]; }, func);
+}
+
+}  // namespace opossum
@@ -1,6 +1,8 @@
 #include "storage_manager.hpp"
 
+#include <filesystem>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -9,39 +11,142 @@
 
 namespace opossum {
 
+namespace {
+
+const auto CHECKPOINT_DIRECTORY = std::string{"checkpoint"};
+const auto WRITE_AHEAD_LOG_FILE = std::string{"wal.log"};
+
+}  // namespace
+
 StorageManager& StorageManager::get() {
-  return *(new StorageManager());
-  // A really hacky fix to get the tests to run - replace this with your implementation
+  static auto instance = StorageManager{};
+  return instance;
 }
 
+StorageManager::StorageManager() : _tables(std::make_shared<const TableMap>()) {}
+
 void StorageManager::add_table(const std::string& name, std::shared_ptr<Table> table) {
-  // Implementation goes here
+  const auto lock = std::lock_guard{_write_mutex};
+  auto tables = std::make_shared<TableMap>(*_tables.load());
+  Assert(!tables->contains(name), "A table with the name " + name + " already exists");
+  auto change = WriteAheadLog::ChangeLock{};
+  if (_write_ahead_log) {
+    Assert(table->uses_mvcc() == UseMvcc::No, "Tables that use MVCC cannot be made durable");
+    change = _write_ahead_log->log_create_table(name, *table);
+    table->set_write_ahead_log(_write_ahead_log, name);
+  }
+  tables->emplace(name, std::move(table));
+  _tables.store(std::move(tables));
+  ++_tables_version;
 }
 
 void StorageManager::drop_table(const std::string& name) {
-  // Implementation goes here
+  const auto lock = std::lock_guard{_write_mutex};
+  auto tables = std::make_shared<TableMap>(*_tables.load());
+  const auto it = tables->find(name);
+  Assert(it != tables->cend(), "No table with the name " + name);
+  auto change = WriteAheadLog::ChangeLock{};
+  if (_write_ahead_log) {
+    // Rows that are being appended are logged before the drop, later ones are not logged anymore
+    it->second->set_write_ahead_log(nullptr, "");
+    change = _write_ahead_log->log_drop_table(name);
+  }
+  // Queries that still hold the table keep it alive
+  tables->erase(it);
+  _tables.store(std::move(tables));
+  ++_tables_version;
 }
 
-std::shared_ptr<Table> StorageManager::get_table(const std::string& name) const {
-  // Implementation goes here
-  return nullptr;
+void StorageManager::replace_table(const std::string& name, std::shared_ptr<Table> table, const ChunkID chunk_count) {
+  const auto lock = std::lock_guard{_write_mutex};
+  auto tables = std::make_shared<TableMap>(*_tables.load());
+  const auto it = tables->find(name);
+  Assert(it != tables->cend(), "No table with the name " + name);
+  // Checkpoints see either the old table or the new one with all rows appended so far. Neither the tables nor their
+  // rows change, so nothing is logged.
+  const auto change = _write_ahead_log ? _write_ahead_log->begin_change() : WriteAheadLog::ChangeLock{};
+  if (_write_ahead_log) table->set_write_ahead_log(_write_ahead_log, name);
+  it->second->hand_over(table, chunk_count);
+  it->second = std::move(table);
+  _tables.store(std::move(tables));
+  ++_tables_version;
 }
 
-bool StorageManager::has_table(const std::string& name) const {
-  // Implementation goes here
-  return false;
+std::shared_ptr<Table> StorageManager::get_table(const std::string& name) const {
+  const auto& tables = _current_tables();
+  const auto it = tables->find(name);
+  Assert(it != tables->cend(), "No table with the name " + name);
+  return it->second;
 }
 
+bool StorageManager::has_table(const std::string& name) const { return _current_tables()->contains(name); }
+
 std::vector<std::string> StorageManager::table_names() const {
-  throw std::runtime_error("Implement StorageManager::table_names");
+  const auto tables = _current_tables();
+  auto names = std::vector<std::string>{};
+  names.reserve(tables->size());
+  for (const auto& table : *tables) names.push_back(table.first);
+  return names;
 }
 
 void StorageManager::print(std::ostream& out) const {
-  // Implementation goes here
+  const auto tables = _current_tables();
+  for (const auto& [name, table] : *tables) {
+    out << "Table " << name << " (" << table->column_count() << " columns, " << table->row_count() << " rows, "
+        << table->chunk_count() << " chunks)" << std::endl;
+  }
 }
 
 void StorageManager::reset() {
-  // Implementation goes here;
+  const auto lock = std::lock_guard{_write_mutex};
+  // Tables that are still referenced elsewhere must not log to the log of the discarded tables
+  for (const auto& [name, table] : *_tables.load()) table->set_write_ahead_log(nullptr, "");
+  _tables.store(std::make_shared<const TableMap>());
+  ++_tables_version;
+  _write_ahead_log = nullptr;
+  _checkpointer = nullptr;
+}
+
+void StorageManager::enable_durability(const std::string& directory) {
+  Assert(_current_tables()->empty() && !_write_ahead_log, "Durability has to be enabled on an empty StorageManager");
+  const auto path = std::filesystem::path{directory};
+  std::filesystem::create_directories(path);
+
+  const auto write_ahead_log = std::make_shared<WriteAheadLog>(path / WRITE_AHEAD_LOG_FILE);
+  const auto checkpointer = std::make_shared<Checkpointer>(path / CHECKPOINT_DIRECTORY, write_ahead_log);
+  const auto first_lsn = checkpointer->recover(*this);
+  write_ahead_log->recover(*this, first_lsn);
+
+  const auto lock = std::lock_guard{_write_mutex};
+  _write_ahead_log = write_ahead_log;
+  _checkpointer = checkpointer;
+  for (const auto& [name, table] : *_tables.load()) table->set_write_ahead_log(_write_ahead_log, name);
+}
+
+void StorageManager::checkpoint() {
+  auto checkpointer = std::shared_ptr<Checkpointer>{};
+  {
+    const auto lock = std::lock_guard{_write_mutex};
+    checkpointer = _checkpointer;
+  }
+  Assert(checkpointer, "Durability is not enabled");
+  checkpointer->checkpoint(*this);
+}
+
+const std::shared_ptr<const StorageManager::TableMap>& StorageManager::_current_tables() const {
+  // The version number only changes when the map changes, so reading it is all a lookup costs in the common case
+  struct CachedTables {
+    uint64_t version = 0;
+    std::shared_ptr<const TableMap> tables;
+  };
+  thread_local auto cached_tables = CachedTables{};
+
+  const auto version = _tables_version.load(std::memory_order_acquire);
+  if (!cached_tables.tables || cached_tables.version != version) {
+    cached_tables.tables = _tables.load();
+    cached_tables.version = version;
+  }
+  return cached_tables.tables;
 }
 
 }  // namespace opossum
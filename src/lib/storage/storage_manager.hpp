@@ -1,18 +1,29 @@
 #pragma once
 
+#include <atomic>
 #include <iostream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
+#include "storage/checkpointer.hpp"
 #include "storage/table.hpp"
+#include "storage/write_ahead_log.hpp"
 #include "types.hpp"
 
 namespace opossum {
 
 // The StorageManager is a singleton that maintains all tables
 // by mapping table names to table instances.
+//
+// All methods are thread-safe. Tables are looked up on every query, while they are rarely added or dropped, so the
+// map is copied on write (RCU-style): a change creates a new version of the map and publishes it atomically. Each
+// thread keeps the version it has seen last and only loads the new one once the version number has changed, so
+// lookups take no lock and do not write to memory shared with other threads. A dropped table is freed once it is
+// neither held by a query anymore nor part of a version that a thread has seen last, i.e., at the latest when all
+// threads that looked tables up have looked up a table again or have exited.
 class StorageManager : private Noncopyable {
  public:
   static StorageManager& get();
@@ -23,6 +34,11 @@ class StorageManager : private Noncopyable {
   // removes the table from the storage manger
   void drop_table(const std::string& name);
 
+  // Replaces a table by a version with the same rows that was built from its first chunk_count chunks, e.g., a
+  // compacted one (see ChunkCompactor). Queries that hold the old table keep reading it, appends to the old table are
+  // handed over to the new one (see Table::hand_over).
+  void replace_table(const std::string& name, std::shared_ptr<Table> table, const ChunkID chunk_count);
+
   // returns the table instance with the given name
   std::shared_ptr<Table> get_table(const std::string& name) const;
 
@@ -38,12 +54,33 @@ class StorageManager : private Noncopyable {
   // deletes the entire StorageManager and creates a new one, used especially in tests
   void reset();
 
+  // Makes the tables durable. Loads the last checkpoint in the directory and replays the write-ahead log there (both
+  // are created if they do not exist yet), then logs all following changes (adding and dropping tables, appends) to
+  // the log. Has to be called on an empty StorageManager. Tables that use MVCC cannot be added afterwards (see
+  // Table::set_write_ahead_log).
+  void enable_durability(const std::string& directory);
+
+  // Writes an incremental checkpoint of all tables to the durability directory and truncates the write-ahead log, so
+  // that recovery only has to replay the changes since the checkpoint. Tables can be read and appended to meanwhile,
+  // so this is usually called from a background thread (see Checkpointer).
+  void checkpoint();
+
   StorageManager(StorageManager&&) = delete;
 
  protected:
-  StorageManager() {}
-  StorageManager& operator=(StorageManager&&) = default;
+  using TableMap = std::map<std::string, std::shared_ptr<Table>>;
+
+  StorageManager();
+
+  // Returns the current version of the map, as seen by the calling thread
+  const std::shared_ptr<const TableMap>& _current_tables() const;
+
+  // Serializes changes to the map and to the durability settings
+  std::mutex _write_mutex;
+  std::atomic<std::shared_ptr<const TableMap>> _tables;
+  std::atomic<uint64_t> _tables_version{0};
 
-  // Implementation goes here
+  std::shared_ptr<WriteAheadLog> _write_ahead_log;
+  std::shared_ptr<Checkpointer> _checkpointer;
 };
 }  // namespace opossum
@@ -1,83 +1,466 @@
 #include "table.hpp"
 
 #include <algorithm>
+#include <bit>
 #include <iomanip>
 #include <limits>
 #include <memory>
-#include <numeric>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
+#include "dictionary_segment.hpp"
 #include "value_segment.hpp"
 
 #include "resolve_type.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
+#include "utils/parallel_for.hpp"
 
 namespace opossum {
 
-Table::Table(const ChunkOffset target_chunk_size) {
-  // Implementation goes here
+Table::Table(const ChunkOffset target_chunk_size, const UseMvcc use_mvcc)
+    : _target_chunk_size(target_chunk_size), _use_mvcc(use_mvcc) {
+  create_new_chunk();
 }
 
+Table::Table(Table&& other) noexcept
+    : _target_chunk_size(other._target_chunk_size),
+      _use_mvcc(other._use_mvcc),
+      _chunk_blocks(std::move(other._chunk_blocks)),
+      _chunk_count(other._chunk_count.load()),
+      _reserved_chunk_count(other._reserved_chunk_count.load()),
+      _column_names(std::move(other._column_names)),
+      _column_types(std::move(other._column_types)),
+      _write_ahead_log(other._write_ahead_log.load()),
+      _successor(std::move(other._successor)),
+      _successor_ready(other._successor_ready.load()),
+      _global_dictionaries(std::move(other._global_dictionaries)) {}
+
 void Table::add_column_definition(const std::string& name, const std::string& type) {
-  // Implementation goes here
+  _column_names.push_back(name);
+  _column_types.push_back(type);
 }
 
 void Table::add_column(const std::string& name, const std::string& type) {
-  // Implementation goes here
+  Assert(row_count() == 0, "Columns can only be added to empty tables");
+  add_column_definition(name, type);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count(); ++chunk_id) {
+    const auto chunk = pin_chunk(chunk_id);
+    resolve_data_type(type, [&](auto data_type) {
+      using Type = typename decltype(data_type)::type;
+      chunk->add_segment(chunk->is_mutable() ? std::make_shared<ValueSegment<Type>>(chunk->capacity())
+                                             : std::make_shared<ValueSegment<Type>>());
+    });
+  }
+}
+
+void Table::append(const std::vector<AllTypeVariant>& values) { _log_and_append_row(values); }
+
+void Table::append_columns(const std::vector<ColumnSpan>& columns) {
+  _check_and_append_columns(columns, INVALID_TRANSACTION_ID, nullptr);
+}
+
+std::vector<MvccRowRange> Table::append_columns(const std::vector<ColumnSpan>& columns,
+                                                const TransactionID transaction_id) {
+  Assert(_use_mvcc == UseMvcc::Yes, "Transactions can only insert into tables that use MVCC");
+  auto row_ranges = std::vector<MvccRowRange>{};
+  _check_and_append_columns(columns, transaction_id, &row_ranges);
+  return row_ranges;
+}
+
+void Table::_check_and_append_columns(const std::vector<ColumnSpan>& columns, const TransactionID transaction_id,
+                                      std::vector<MvccRowRange>* const row_ranges) {
+  Assert(columns.size() == column_count(), "Number of columns does not match the table");
+  const auto row_count = columns.empty() ? size_t{0} : columns.front().size();
+  // Checks all columns first, so that a mismatch does not leave the table with a partially appended row range
+  for (auto column_id = ColumnID{0}; column_id < columns.size(); ++column_id) {
+    Assert(columns[column_id].size() == row_count, "All columns need to have the same number of rows");
+    resolve_data_type(_column_types[column_id], [&](auto type) {
+      Assert(columns[column_id].which() == detail::index_of(types, type), "Column has a different data type");
+    });
+  }
+
+  const auto logged_change = _begin_logged_change();
+  if (logged_change.log) {
+    logged_change.log->write_ahead_log->log_append(logged_change.change, logged_change.log->table_name, columns);
+  }
+  _append_columns(columns, 0, transaction_id, row_ranges);
 }
 
-void Table::append(const std::vector<AllTypeVariant>& values) {
-  // Implementation goes here
+size_t Table::_column_data_type_index(const ColumnID column_id) const {
+  auto index = size_t{0};
+  resolve_data_type(_column_types[column_id], [&](auto type) { index = detail::index_of(types, type); });
+  return index;
+}
+
+AllTypeVariant Table::_convert_to_column_type(const ColumnID column_id, const TypedValue& value) const {
+  auto converted_value = AllTypeVariant{};
+  resolve_data_type(_column_types[column_id], [&](auto type) {
+    using Type = typename decltype(type)::type;
+    converted_value = type_cast<Type>(value);
+  });
+  return converted_value;
+}
+
+void Table::_append_columns(const std::vector<ColumnSpan>& columns, size_t first_row,
+                            const TransactionID transaction_id, std::vector<MvccRowRange>* const row_ranges) {
+  const auto row_count = columns.empty() ? size_t{0} : columns.front().size();
+  auto row = first_row;
+  while (row < row_count) {
+    const auto chunk_id = ChunkID{chunk_count() - 1};
+    const auto chunk = pin_chunk(chunk_id);
+    auto chunk_offset = ChunkOffset{0};
+    const auto count = chunk->is_mutable() ? chunk->try_append_columns(columns, row, transaction_id, &chunk_offset) : 0;
+    if (count == 0 && !_roll_chunk(chunk_id)) {
+      return _successor->_append_columns(columns, row, transaction_id, row_ranges);
+    }
+    if (count > 0 && row_ranges) {
+      row_ranges->push_back({chunk->mvcc_data(), chunk_offset, static_cast<ChunkOffset>(chunk_offset + count)});
+    }
+    row += count;
+  }
+}
+
+void Table::set_write_ahead_log(const std::shared_ptr<WriteAheadLog>& write_ahead_log, const std::string& log_name) {
+  Assert(!write_ahead_log || _use_mvcc == UseMvcc::No, "Tables that use MVCC cannot be made durable");
+  const auto previous_log = _write_ahead_log.exchange(
+      write_ahead_log ? std::make_shared<const LogTarget>(LogTarget{write_ahead_log, log_name}) : nullptr);
+  // Changes that began before the exchange are logged to the previous log, so wait until they are applied. Later ones
+  // see that the log was replaced (see _begin_logged_change).
+  if (previous_log) {
+    const auto blocked_changes = previous_log->write_ahead_log->block_changes();
+  }
+}
+
+Table::LoggedChange Table::_begin_logged_change() const {
+  while (true) {
+    auto log = _write_ahead_log.load();
+    if (!log) return {};
+    auto change = log->write_ahead_log->begin_change();
+    if (_write_ahead_log.load() == log) return {std::move(log), std::move(change)};
+  }
 }
 
 void Table::create_new_chunk() {
-  // Implementation goes here
+  DebugAssert(!(_reserved_chunk_count & HANDED_OVER), "Table was handed over");
+  _add_chunk(ChunkID{_reserved_chunk_count++}, _create_mutable_chunk());
+}
+
+void Table::emplace_chunk(Chunk chunk) {
+  auto new_chunk = std::make_shared<Chunk>(std::move(chunk));
+  if (_use_mvcc == UseMvcc::Yes && !new_chunk->mvcc_data()) {
+    auto mvcc_data = std::make_shared<MvccData>(new_chunk->size());
+    for (auto& begin_cid : mvcc_data->begin_cids) begin_cid.store(0, std::memory_order_relaxed);
+    new_chunk->set_mvcc_data(std::move(mvcc_data));
+  }
+  _share_chunk(std::move(new_chunk));
+}
+
+std::unique_lock<std::mutex> Table::block_chunk_replacements() const { return std::unique_lock{_replace_mutex}; }
+
+std::shared_ptr<Table> Table::create_successor(const ChunkID chunk_count,
+                                               std::vector<ChunkRunReplacement> replacements,
+                                               const std::unique_lock<std::mutex>& replacement_lock) const {
+  Assert(replacement_lock.mutex() == &_replace_mutex && replacement_lock.owns_lock(),
+         "Chunk replacements have to be blocked");
+  auto successor = std::make_shared<Table>(_target_chunk_size, _use_mvcc);
+  for (auto column_id = ColumnID{0}; column_id < column_count(); ++column_id) {
+    successor->add_column(_column_names[column_id], _column_types[column_id]);
+  }
+  successor->_global_dictionaries = _global_dictionaries;
+
+  auto replacement = replacements.begin();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count;) {
+    if (replacement == replacements.end() || chunk_id != replacement->begin) {
+      successor->_share_chunk(_chunk_slot(chunk_id).load());
+      ++chunk_id;
+      continue;
+    }
+    DebugAssert(replacement->begin < replacement->end && replacement->end <= chunk_count, "Invalid run of chunks");
+    for (auto& chunk : replacement->chunks) successor->_share_chunk(std::move(chunk));
+    chunk_id = replacement->end;
+    ++replacement;
+  }
+  Assert(replacement == replacements.end(), "Runs of chunks have to be ordered");
+  return successor;
+}
+
+void Table::hand_over(const std::shared_ptr<Table>& successor, const ChunkID chunk_count) {
+  Assert(!_successor, "Table was handed over already");
+  // From now on, no chunk can be reserved anymore. The chunks that were reserved before are shared once they are added.
+  const auto reserved_chunk_count = _reserved_chunk_count.fetch_or(HANDED_OVER);
+  while (_chunk_count.load(std::memory_order_acquire) != reserved_chunk_count) std::this_thread::yield();
+  for (auto chunk_id = chunk_count; chunk_id < reserved_chunk_count; ++chunk_id) {
+    successor->_share_chunk(pin_chunk(chunk_id));
+  }
+  // Appends only go to the successor once it has all chunks
+  _successor = successor;
+  _successor_ready.store(true, std::memory_order_release);
+}
+
+std::shared_ptr<Table> Table::successor() const {
+  return _successor_ready.load(std::memory_order_acquire) ? _successor : nullptr;
+}
+
+void Table::_share_chunk(std::shared_ptr<Chunk> chunk) {
+  DebugAssert(!(_reserved_chunk_count & HANDED_OVER), "Table was handed over");
+  if (chunk_count() == 1 && pin_chunk(ChunkID{0})->size() == 0) {
+    _chunk_slot(ChunkID{0}).store(std::move(chunk));
+  } else {
+    _add_chunk(ChunkID{_reserved_chunk_count++}, std::move(chunk));
+  }
+}
+
+bool Table::_roll_chunk(const ChunkID full_chunk_id) {
+  // Of all threads that found the chunk full, only the one that reserves the next chunk id adds a chunk. The others
+  // wait until it is visible.
+  auto next_chunk_id = ChunkID::base_type{full_chunk_id + 1};
+  if (_reserved_chunk_count.compare_exchange_strong(next_chunk_id, next_chunk_id + 1)) {
+    _add_chunk(ChunkID{next_chunk_id}, _create_mutable_chunk(pin_chunk(full_chunk_id)->capacity()));
+    return true;
+  }
+  // Once the table is handed over, a chunk that was not reserved before will never be added
+  if (next_chunk_id == (ChunkID::base_type{full_chunk_id + 1} | HANDED_OVER)) {
+    while (!_successor_ready.load(std::memory_order_acquire)) std::this_thread::yield();
+    return false;
+  }
+  while (_chunk_count.load(std::memory_order_acquire) <= full_chunk_id + 1) std::this_thread::yield();
+  return true;
+}
+
+std::shared_ptr<Chunk> Table::_create_mutable_chunk(const ChunkOffset previous_capacity) const {
+  const auto max_capacity = std::clamp(_target_chunk_size, ChunkOffset{1}, MAX_MUTABLE_CHUNK_SIZE);
+  const auto capacity = std::min(max_capacity, std::max(INITIAL_MUTABLE_CHUNK_SIZE, 2 * previous_capacity));
+  auto chunk = std::make_shared<Chunk>(capacity);
+  if (_use_mvcc == UseMvcc::Yes) chunk->set_mvcc_data(std::make_shared<MvccData>(capacity));
+  for (const auto& type : _column_types) {
+    resolve_data_type(type, [&](auto data_type) {
+      using Type = typename decltype(data_type)::type;
+      chunk->add_segment(std::make_shared<ValueSegment<Type>>(capacity));
+    });
+  }
+  return chunk;
+}
+
+void Table::_add_chunk(const ChunkID chunk_id, std::shared_ptr<Chunk> chunk) {
+  // Waiting for the chunks before also makes sure that the block of the chunk is allocated before it is used
+  while (_chunk_count.load(std::memory_order_acquire) != chunk_id) std::this_thread::yield();
+
+  const auto index = uint64_t{chunk_id} + 1;
+  const auto block = std::bit_width(index) - 1;
+  const auto block_begin = uint64_t{1} << block;
+  Assert(block < _chunk_blocks.size(), "Table has too many chunks");
+  if (index == block_begin) {
+    _chunk_blocks[block] = std::make_unique<std::atomic<std::shared_ptr<Chunk>>[]>(block_begin);
+  }
+  _chunk_blocks[block][index - block_begin].store(std::move(chunk));
+  _chunk_count.store(chunk_id + 1, std::memory_order_release);
+}
+
+std::atomic<std::shared_ptr<Chunk>>& Table::_chunk_slot(const ChunkID chunk_id) const {
+  const auto index = uint64_t{chunk_id} + 1;
+  const auto block = std::bit_width(index) - 1;
+  return _chunk_blocks[block][index - (uint64_t{1} << block)];
 }
 
 ColumnCount Table::column_count() const {
-  // Implementation goes here
-  return ColumnCount{0};
+  return ColumnCount{static_cast<ColumnCount::base_type>(_column_names.size())};
 }
 
 uint64_t Table::row_count() const {
-  // Implementation goes here
-  return 0;
+  auto row_count = uint64_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count(); ++chunk_id) row_count += pin_chunk(chunk_id)->size();
+  return row_count;
 }
 
-ChunkID Table::chunk_count() const {
-  // Implementation goes here
-  return ChunkID{0};
+uint64_t Table::approx_valid_row_count() const {
+  auto row_count = uint64_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count(); ++chunk_id) {
+    const auto chunk = pin_chunk(chunk_id);
+    row_count += chunk->size();
+    if (chunk->mvcc_data()) row_count -= chunk->mvcc_data()->invalid_row_count;
+  }
+  return row_count;
 }
 
+UseMvcc Table::uses_mvcc() const { return _use_mvcc; }
+
+ChunkID Table::chunk_count() const { return ChunkID{_chunk_count.load(std::memory_order_acquire)}; }
+
 ColumnID Table::column_id_by_name(const std::string& column_name) const {
-  // Implementation goes here
-  return ColumnID{0};
+  const auto it = std::find(_column_names.cbegin(), _column_names.cend(), column_name);
+  Assert(it != _column_names.cend(), "No column with name " + column_name);
+  return ColumnID{static_cast<ColumnID::base_type>(std::distance(_column_names.cbegin(), it))};
 }
 
-ChunkOffset Table::target_chunk_size() const {
-  // Implementation goes here
-  return 0;
-}
+ChunkOffset Table::target_chunk_size() const { return _target_chunk_size; }
 
-const std::vector<std::string>& Table::column_names() const {
-  throw std::runtime_error("Implement Table::column_names()");
-}
+const std::vector<std::string>& Table::column_names() const { return _column_names; }
 
 const std::string& Table::column_name(const ColumnID column_id) const {
-  throw std::runtime_error("Implement Table::column_name");
+  DebugAssert(column_id < _column_names.size(), "ColumnID is out of bounds");
+  return _column_names[column_id];
 }
 
 const std::string& Table::column_type(const ColumnID column_id) const {
-  throw std::runtime_error("Implement Table::column_type");
+  DebugAssert(column_id < _column_types.size(), "ColumnID is out of bounds");
+  return _column_types[column_id];
+}
+
+Chunk& Table::get_chunk(ChunkID chunk_id) { return *pin_chunk(chunk_id); }
+
+const Chunk& Table::get_chunk(ChunkID chunk_id) const { return *pin_chunk(chunk_id); }
+
+std::shared_ptr<Chunk> Table::pin_chunk(ChunkID chunk_id) {
+  DebugAssert(chunk_id < chunk_count(), "ChunkID is out of bounds");
+  return _chunk_slot(chunk_id).load();
+}
+
+std::shared_ptr<const Chunk> Table::pin_chunk(ChunkID chunk_id) const {
+  DebugAssert(chunk_id < chunk_count(), "ChunkID is out of bounds");
+  return _chunk_slot(chunk_id).load();
+}
+
+void Table::compress_chunk(ChunkID chunk_id) {
+  const auto chunk = pin_chunk(chunk_id);
+  const auto column_count = chunk->column_count();
+
+  // Each column is dictionary-encoded in its own thread. The resulting segments are stored at their column's position
+  // so that the order of the segments in the new chunk is not affected by the order in which the threads finish.
+  auto dictionary_segments = std::vector<std::shared_ptr<BaseSegment>>(column_count);
+  auto threads = std::vector<std::thread>{};
+  threads.reserve(column_count);
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    resolve_data_type(_column_types[column_id], [&](auto data_type) {
+      using Type = typename decltype(data_type)::type;
+      const auto segment = chunk->get_segment(column_id);
+
+      // Segments that are already dictionary-encoded are kept as they are
+      if (std::dynamic_pointer_cast<DictionarySegment<Type>>(segment)) {
+        dictionary_segments[column_id] = segment;
+        return;
+      }
+
+      Assert(std::dynamic_pointer_cast<ValueSegment<Type>>(segment), "Only ValueSegments can be compressed");
+      threads.emplace_back([&dictionary_segments, segment, column_id]() {
+        dictionary_segments[column_id] = std::make_shared<DictionarySegment<Type>>(segment);
+      });
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  replace_chunk(chunk_id, std::move(dictionary_segments));
 }
 
-Chunk& Table::get_chunk(ChunkID chunk_id) { throw std::runtime_error("Implement Table::get_chunk"); }
+void Table::replace_chunk(ChunkID chunk_id, std::vector<std::shared_ptr<BaseSegment>> segments) {
+  const auto lock = std::lock_guard{_replace_mutex};
+  _replace_chunk(chunk_id, std::move(segments));
+}
+
+void Table::_replace_chunk(const ChunkID chunk_id, std::vector<std::shared_ptr<BaseSegment>> segments) {
+  const auto chunk = _chunk_slot(chunk_id).load();
+  Assert(segments.size() == chunk->column_count(), "Chunk has to be replaced by a segment per column");
+
+  auto new_chunk = std::make_shared<Chunk>();
+  for (auto column_id = ColumnID{0}; column_id < segments.size(); ++column_id) {
+    Assert(segments[column_id]->size() == chunk->size(), "Segments have to hold the rows of the chunk");
+    new_chunk->add_segment(_encode_with_global_dictionary(column_id, segments[column_id]));
+  }
+  new_chunk->set_mvcc_data(chunk->mvcc_data());
+  const auto logged_change = _begin_logged_change();
+  _chunk_slot(chunk_id).store(std::move(new_chunk));
+
+  // The successor is set while replacements are blocked (see block_chunk_replacements), so it cannot be set meanwhile
+  if (!_successor) return;
+  const auto successor_lock = std::lock_guard{_successor->_replace_mutex};
+  for (auto successor_chunk_id = ChunkID{0}; successor_chunk_id < _successor->chunk_count(); ++successor_chunk_id) {
+    if (_successor->_chunk_slot(successor_chunk_id).load() == chunk) {
+      _successor->_replace_chunk(successor_chunk_id, std::move(segments));
+      return;
+    }
+  }
+}
+
+void Table::use_global_dictionary(const ColumnID column_id) {
+  const auto lock = std::lock_guard{_replace_mutex};
+  resolve_data_type(column_type(column_id), [&](auto data_type) {
+    using Type = typename decltype(data_type)::type;
+
+    // The dictionaries of the chunks are collected once each, chunks that share one add it only once
+    const auto chunk_count = this->chunk_count();
+    auto segments = std::vector<std::shared_ptr<const DictionarySegment<Type>>>(chunk_count);
+    auto values = std::vector<Type>{};
+    auto previous_dictionary = std::shared_ptr<const std::vector<Type>>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = pin_chunk(chunk_id);
+      if (chunk->is_mutable()) continue;
+      segments[chunk_id] = std::dynamic_pointer_cast<const DictionarySegment<Type>>(chunk->get_segment(column_id));
+      if (!segments[chunk_id]) continue;
+
+      const auto dictionary = segments[chunk_id]->dictionary();
+      if (dictionary == previous_dictionary) continue;
+      values.insert(values.end(), dictionary->cbegin(), dictionary->cend());
+      previous_dictionary = dictionary;
+    }
+    std::sort(values.begin(), values.end());
+    values.erase(std::unique(values.begin(), values.end()), values.end());
+    values.shrink_to_fit();
+
+    const auto value_count = values.size();
+    const auto global_dictionary = std::make_shared<DictionarySegment<Type>>(
+        std::make_shared<std::vector<Type>>(std::move(values)), make_attribute_vector(value_count, 0));
+    _global_dictionaries[column_id] = global_dictionary;
 
-const Chunk& Table::get_chunk(ChunkID chunk_id) const { throw std::runtime_error("Implement Table::get_chunk"); }
+    parallel_for(chunk_count, [&](const size_t chunk_index) {
+      const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(chunk_index)};
+      if (!segments[chunk_id]) return;
 
-void Table::compress_chunk(ChunkID chunk_id) { throw std::runtime_error("Implement Table::compress_chunk"); }
+      const auto chunk = pin_chunk(chunk_id);
+      auto chunk_segments = std::vector<std::shared_ptr<BaseSegment>>{};
+      for (auto segment_column_id = ColumnID{0}; segment_column_id < chunk->column_count(); ++segment_column_id) {
+        chunk_segments.push_back(chunk->get_segment(segment_column_id));
+      }
+      chunk_segments[column_id] = std::make_shared<DictionarySegment<Type>>(*segments[chunk_id], *global_dictionary);
+      _replace_chunk(chunk_id, std::move(chunk_segments));
+    });
+  });
+}
+
+bool Table::has_global_dictionary(const ColumnID column_id) const {
+  const auto lock = std::lock_guard{_replace_mutex};
+  return _global_dictionaries.contains(column_id);
+}
+
+std::shared_ptr<BaseSegment> Table::encode_with_global_dictionary(const ColumnID column_id,
+                                                                  const std::shared_ptr<BaseSegment>& segment) const {
+  const auto lock = std::lock_guard{_replace_mutex};
+  return _encode_with_global_dictionary(column_id, segment);
+}
+
+std::shared_ptr<BaseSegment> Table::_encode_with_global_dictionary(const ColumnID column_id,
+                                                                   const std::shared_ptr<BaseSegment>& segment) const {
+  const auto global_dictionary_iter = _global_dictionaries.find(column_id);
+  if (global_dictionary_iter == _global_dictionaries.end()) return segment;
+
+  auto encoded_segment = segment;
+  resolve_data_type(_column_types[column_id], [&](auto data_type) {
+    using Type = typename decltype(data_type)::type;
+    const auto dictionary_segment = std::dynamic_pointer_cast<const DictionarySegment<Type>>(segment);
+    if (!dictionary_segment) return;
+
+    const auto& global_dictionary_segment =
+        static_cast<const DictionarySegment<Type>&>(*global_dictionary_iter->second);
+    const auto& dictionary = *dictionary_segment->dictionary();
+    const auto& global_dictionary = *global_dictionary_segment.dictionary();
+    if (&dictionary == &global_dictionary || !std::includes(global_dictionary.cbegin(), global_dictionary.cend(),
+                                                            dictionary.cbegin(), dictionary.cend())) {
+      return;
+    }
+    encoded_segment = std::make_shared<DictionarySegment<Type>>(*dictionary_segment, global_dictionary_segment);
+  });
+  return encoded_segment;
+}
 
 }  // namespace opossum
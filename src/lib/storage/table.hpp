@@ -1,15 +1,19 @@
 #pragma once
 
+#include <array>
+#include <atomic>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
 #include "base_segment.hpp"
 #include "chunk.hpp"
+#include "write_ahead_log.hpp"
 
 #include "type_cast.hpp"
 #include "types.hpp"
@@ -19,13 +23,34 @@ namespace opossum {
 
 class TableStatistics;
 
+// Chunks [begin, end) of a table and the chunks that take their place in its successor (see Table::create_successor)
+struct ChunkRunReplacement {
+  ChunkID begin;
+  ChunkID end;
+  std::vector<std::shared_ptr<Chunk>> chunks;
+};
+
 // A table is partitioned horizontally into a number of chunks
 class Table : private Noncopyable {
  public:
   // creates a table
   // the parameter specifies the maximum chunk size, i.e., partition size
   // default is the maximum chunk size minus 1. A table holds always at least one chunk
-  explicit Table(const ChunkOffset target_chunk_size = std::numeric_limits<ChunkOffset>::max() - 1);
+  // Chunks that rows are appended to hold at most MAX_MUTABLE_CHUNK_SIZE rows, even if the target chunk size is larger
+  // Transactions (see TransactionContext) can only insert into and delete from tables that use MVCC
+  explicit Table(const ChunkOffset target_chunk_size = std::numeric_limits<ChunkOffset>::max() - 1,
+                 const UseMvcc use_mvcc = UseMvcc::No);
+
+  // Atomics cannot be moved, so this is implemented by hand. Tables must not be moved while they are used.
+  Table(Table&& other) noexcept;
+
+  // The chunks that rows are appended to allocate the storage for all their rows up front (see Chunk::try_append),
+  // so they hold at most this many rows, even if the target chunk size is larger. So that small tables do not allocate
+  // the storage of such a chunk, the first one holds INITIAL_MUTABLE_CHUNK_SIZE rows, and each following one twice as
+  // many as the chunk before until the target chunk size or MAX_MUTABLE_CHUNK_SIZE is reached. The ChunkCompactor
+  // merges the smaller chunks later on.
+  static constexpr auto INITIAL_MUTABLE_CHUNK_SIZE = ChunkOffset{1'024};
+  static constexpr auto MAX_MUTABLE_CHUNK_SIZE = ChunkOffset{65'535};
 
   // returns the number of columns (cannot exceed ColumnID (uint16_t))
   ColumnCount column_count() const;
@@ -35,14 +60,27 @@ class Table : private Noncopyable {
   // Use approx_valid_row_count() for an approximate count of valid rows instead.
   uint64_t row_count() const;
 
+  // Returns the number of rows that are neither deleted nor rolled back. This ignores deletes and inserts that are
+  // not committed yet, so the visible row count of a transaction can differ.
+  uint64_t approx_valid_row_count() const;
+
+  UseMvcc uses_mvcc() const;
+
   // returns the number of chunks (cannot exceed ChunkID (uint32_t))
   ChunkID chunk_count() const;
 
   // returns the chunk with the given id
+  // The reference is only valid until the chunk is replaced (see replace_chunk), so code that can run concurrently
+  // with replacements (e.g., operators, while a DeltaMerger or use_global_dictionary runs) uses pin_chunk instead.
   Chunk& get_chunk(ChunkID chunk_id);
   const Chunk& get_chunk(ChunkID chunk_id) const;
 
-  // Adds a chunk to the table. If the first chunk is empty, it is replaced.
+  // Returns the chunk with the given id and keeps it alive for as long as the caller holds it, even if it is replaced
+  std::shared_ptr<Chunk> pin_chunk(ChunkID chunk_id);
+  std::shared_ptr<const Chunk> pin_chunk(ChunkID chunk_id) const;
+
+  // Adds a chunk to the table. If the first chunk is empty, it is replaced. If the table uses MVCC, the rows of a chunk
+  // without MVCC columns are added as committed.
   void emplace_chunk(Chunk chunk);
 
   // Returns a list of all column names.
@@ -60,6 +98,7 @@ class Table : private Noncopyable {
   ColumnID column_id_by_name(const std::string& column_name) const;
 
   // return the target chunk size (cannot exceed ChunkOffset (uint32_t))
+  // Chunks that rows are appended to can be smaller (see MAX_MUTABLE_CHUNK_SIZE)
   ChunkOffset target_chunk_size() const;
 
   // adds column definition without creating the actual columns
@@ -73,16 +112,195 @@ class Table : private Noncopyable {
   void add_column(const std::string& name, const std::string& type);
 
   // inserts a row at the end of the table
-  // note this is slow and not thread-safe and should be used for testing purposes only
+  // Rows can be appended from several threads at once. Each thread reserves a row in the last chunk without a lock
+  // (see Chunk::try_append), and the thread that finds the chunk full first adds the next one. Readers only see rows
+  // that are completely written.
   void append(const std::vector<AllTypeVariant>& values);
 
+  // same as above, but takes a container of TypedValues (see Chunk::append)
+  template <typename TypedValues,
+            typename = std::enable_if_t<std::is_same_v<typename TypedValues::value_type, TypedValue>>>
+  void append(const TypedValues& values) { _log_and_append_row(values); }
+
+  // Inserts the rows given as one ColumnSpan per column at the end of the table, filling the last chunk and creating
+  // new chunks of target_chunk_size rows as needed. This is the way to load larger amounts of data, since the values
+  // are copied column by column without going through AllTypeVariant. Can be called from several threads at once, as
+  // append; the rows of one call are contiguous within each chunk.
+  void append_columns(const std::vector<ColumnSpan>& columns);
+
+  // Same as above, but the rows are inserted by a transaction and stay invisible to other transactions until it
+  // commits (see TransactionContext::insert). Returns the rows of each chunk that the rows were added to.
+  std::vector<MvccRowRange> append_columns(const std::vector<ColumnSpan>& columns, const TransactionID transaction_id);
+
   // creates a new chunk and appends it
   void create_new_chunk();
 
   // compresses a ValueColumn into a DictionaryColumn
+  // Rows must not be appended to the chunk while it is compressed. Appends after that go to a new chunk.
   void compress_chunk(ChunkID chunk_id);
 
+  // Replaces the chunk by one of the given segments, which have to hold the same rows (e.g., encoded differently), and
+  // keeps its MVCC columns. Rows must not be appended to the chunk anymore. The new chunk is published atomically, and
+  // readers that pinned the replaced chunk (see pin_chunk) keep it alive until they are done with it. If the table was
+  // handed over, the chunk is replaced in the successor as well, unless the successor does not hold it anymore.
+  void replace_chunk(ChunkID chunk_id, std::vector<std::shared_ptr<BaseSegment>> segments);
+
+  // Makes the dictionary-encoded immutable chunks of the column share one table-wide dictionary, which is meant for
+  // columns with few distinct values: the union of their dictionaries is stored once instead of per chunk, and value
+  // ids can be compared across chunks (e.g., by Aggregate). The chunks are replaced by ones whose segment of the column
+  // only holds its attribute vector remapped into the shared dictionary. Segments that are dictionary-encoded later
+  // (see replace_chunk) use the shared dictionary if it contains all their values, and keep their own dictionary
+  // otherwise until this is called again, which rebuilds the shared dictionary. The shared dictionaries are not part
+  // of checkpoints. The chunks are replaced as by replace_chunk, so the table can be read meanwhile.
+  void use_global_dictionary(const ColumnID column_id);
+
+  bool has_global_dictionary(const ColumnID column_id) const;
+
+  // Returns the segment encoded with the global dictionary of the column if the table has one that contains all
+  // values of the segment, and the segment itself otherwise
+  std::shared_ptr<BaseSegment> encode_with_global_dictionary(const ColumnID column_id,
+                                                             const std::shared_ptr<BaseSegment>& segment) const;
+
+  // Logs all following appends under the given table name before they are applied, so that they survive a crash. Set
+  // by the StorageManager when durability is enabled, pass nullptr to stop logging. Can be called while rows are
+  // appended: it waits until the rows that are being logged to the previous log are appended, and all later rows are
+  // logged to the new log. Must not be called within a change of the previous log. Chunks that are added with
+  // emplace_chunk are not logged. Tables that use MVCC cannot be logged: commits, rollbacks and deletes are not part of
+  // the log, and checkpoints do not hold the MVCC columns, so recovery would make all their rows visible.
+  void set_write_ahead_log(const std::shared_ptr<WriteAheadLog>& write_ahead_log, const std::string& log_name);
+
+  // Blocks replace_chunk and use_global_dictionary (and thereby the DeltaMerger) for as long as the lock is held, so
+  // that a successor can be created and handed over without missing a replaced chunk
+  [[nodiscard]] std::unique_lock<std::mutex> block_chunk_replacements() const;
+
+  // Creates a version of this table from its first chunk_count chunks (e.g., a compacted one, see ChunkCompactor). It
+  // has the same columns and global dictionaries and shares the chunks, except for the given runs of chunks, which
+  // are replaced by the chunks of the runs. The runs have to be ordered. Chunk replacements have to be blocked until
+  // the successor is handed over.
+  std::shared_ptr<Table> create_successor(const ChunkID chunk_count, std::vector<ChunkRunReplacement> replacements,
+                                          const std::unique_lock<std::mutex>& replacement_lock) const;
+
+  // Makes the successor, a version of this table that was built from its first chunk_count chunks (see
+  // create_successor), take over: the chunks that were added after those are shared with the successor, and appends
+  // that need a new chunk go to the successor from now on. Chunks must not be added to this table otherwise
+  // afterwards (see create_new_chunk and emplace_chunk). Chunk replacements have to be blocked by the caller.
+  void hand_over(const std::shared_ptr<Table>& successor, const ChunkID chunk_count);
+
+  // Returns the table that this one was handed over to, or nullptr if it was not handed over
+  std::shared_ptr<Table> successor() const;
+
  protected:
-  // Implementation goes here
+  // Set in _reserved_chunk_count once the table was handed over to its successor
+  static constexpr auto HANDED_OVER = ChunkID::base_type{1} << 31;
+
+  // The log that appends are written to and the name of the table in it (see set_write_ahead_log)
+  struct LogTarget {
+    std::shared_ptr<WriteAheadLog> write_ahead_log;
+    std::string table_name;
+  };
+
+  struct LoggedChange {
+    std::shared_ptr<const LogTarget> log;
+    WriteAheadLog::ChangeLock change;
+  };
+
+  // Loads the log once and begins a change of it, which keeps set_write_ahead_log from replacing the log until the
+  // change is logged and applied. Returns no log if the table is not logged.
+  LoggedChange _begin_logged_change() const;
+
+  // Logs the row before it is appended. Values of other data types are converted first, so that a row that cannot be
+  // appended is rejected before it is made durable and recovery only replays rows of the right data types.
+  template <typename Values>
+  void _log_and_append_row(const Values& values) {
+    Assert(values.size() == column_count(), "Number of values does not match the table");
+    const auto logged_change = _begin_logged_change();
+    if (!logged_change.log) return _append_row(values);
+
+    const auto log_and_append_row = [&](const auto& row) {
+      logged_change.log->write_ahead_log->log_append(logged_change.change, logged_change.log->table_name, row);
+      _append_row(row);
+    };
+    auto column_id = ColumnID{0};
+    for (const auto& value : values) {
+      if (TypedValue{value}.which() != _column_data_type_index(column_id)) {
+        auto converted_values = std::vector<AllTypeVariant>{};
+        converted_values.reserve(values.size());
+        column_id = ColumnID{0};
+        for (const auto& value_to_convert : values) {
+          converted_values.push_back(_convert_to_column_type(column_id, TypedValue{value_to_convert}));
+          ++column_id;
+        }
+        return log_and_append_row(converted_values);
+      }
+      ++column_id;
+    }
+    log_and_append_row(values);
+  }
+
+  // Returns the index of the data type of a column in data_types, which is the same as AllTypeVariant::which()
+  size_t _column_data_type_index(const ColumnID column_id) const;
+
+  // Converts a value to the data type of a column, throws if that is not possible
+  AllTypeVariant _convert_to_column_type(const ColumnID column_id, const TypedValue& value) const;
+
+  template <typename Values>
+  void _append_row(const Values& values) {
+    while (true) {
+      const auto chunk_id = ChunkID{chunk_count() - 1};
+      const auto chunk = pin_chunk(chunk_id);
+      if (chunk->is_mutable() && chunk->try_append(values)) return;
+      if (!_roll_chunk(chunk_id)) return _successor->_append_row(values);
+    }
+  }
+
+  void _check_and_append_columns(const std::vector<ColumnSpan>& columns, const TransactionID transaction_id,
+                                 std::vector<MvccRowRange>* const row_ranges);
+
+  // Appends the rows from first_row on, after the columns were checked and logged
+  void _append_columns(const std::vector<ColumnSpan>& columns, size_t first_row, const TransactionID transaction_id,
+                       std::vector<MvccRowRange>* const row_ranges);
+
+  // Adds a mutable chunk after the full chunk, unless another thread did so already. Returns false if the table was
+  // handed over, in which case the rows go to the successor.
+  [[nodiscard]] bool _roll_chunk(const ChunkID full_chunk_id);
+
+  // Creates a chunk with twice the capacity of the chunk before (see INITIAL_MUTABLE_CHUNK_SIZE)
+  std::shared_ptr<Chunk> _create_mutable_chunk(const ChunkOffset previous_capacity = 0) const;
+
+  // Adds the chunk with an id from _reserved_chunk_count. Chunks become visible in the order of their ids.
+  void _add_chunk(const ChunkID chunk_id, std::shared_ptr<Chunk> chunk);
+
+  std::atomic<std::shared_ptr<Chunk>>& _chunk_slot(const ChunkID chunk_id) const;
+
+  // Adds the chunk, replacing the first chunk if it is empty
+  void _share_chunk(std::shared_ptr<Chunk> chunk);
+
+  // Same as replace_chunk, with _replace_mutex held by the caller
+  void _replace_chunk(const ChunkID chunk_id, std::vector<std::shared_ptr<BaseSegment>> segments);
+
+  std::shared_ptr<BaseSegment> _encode_with_global_dictionary(const ColumnID column_id,
+                                                              const std::shared_ptr<BaseSegment>& segment) const;
+
+  const ChunkOffset _target_chunk_size;
+  const UseMvcc _use_mvcc;
+  // The chunks are stored in blocks that never move, so that chunks can be added while other threads access the
+  // table. Block b holds the 2^b chunks from chunk id 2^b - 1 on. The slots are atomic, so that chunks can be replaced
+  // while other threads pin them.
+  std::array<std::unique_ptr<std::atomic<std::shared_ptr<Chunk>>[]>, 32> _chunk_blocks;
+  // The number of visible chunks
+  std::atomic<ChunkID::base_type> _chunk_count{0};
+  // The number of chunks that are visible or being added
+  std::atomic<ChunkID::base_type> _reserved_chunk_count{0};
+  std::vector<std::string> _column_names;
+  std::vector<std::string> _column_types;
+  // Can be replaced while rows are appended, so appends load it once (see _begin_logged_change)
+  std::atomic<std::shared_ptr<const LogTarget>> _write_ahead_log;
+  std::shared_ptr<Table> _successor;
+  std::atomic<bool> _successor_ready{false};
+  // Held while chunks are replaced, so that no chunk misses a new global dictionary or a successor (see
+  // block_chunk_replacements). Also protects the global dictionaries.
+  mutable std::mutex _replace_mutex;
+  // Per column with a table-wide dictionary (see use_global_dictionary), an empty DictionarySegment that holds it
+  std::map<ColumnID, std::shared_ptr<BaseSegment>> _global_dictionaries;
 };
 }  // namespace opossum
@@ -1,5 +1,6 @@
 #include "value_segment.hpp"
 
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -12,26 +13,117 @@
 
 namespace opossum {
 
+template <typename T>
+ValueSegment<T>::ValueSegment(std::vector<T>&& values)
+    : _values(std::move(values)), _size(static_cast<ChunkOffset>(_values.size())) {}
+
+template <typename T>
+ValueSegment<T>::ValueSegment(const ChunkOffset capacity) : _values(capacity) {}
+
 template <typename T>
 AllTypeVariant ValueSegment<T>::operator[](const ChunkOffset chunk_offset) const {
-  throw std::runtime_error("Implement ValueSegment::operator[]");
+  DebugAssert(chunk_offset < size(), "ChunkOffset is out of bounds");
+  return _values[chunk_offset];
+}
+
+template <typename T>
+TypedValue ValueSegment<T>::typed_value(const ChunkOffset chunk_offset) const {
+  DebugAssert(chunk_offset < size(), "ChunkOffset is out of bounds");
+  return TypedValue{_values[chunk_offset]};
 }
 
 template <typename T>
 void ValueSegment<T>::append(const AllTypeVariant& val) {
-  // Implementation goes here
+  const auto size = _size.load(std::memory_order_relaxed);
+  if (size < _values.size()) {
+    _values[size] = type_cast<T>(val);
+  } else {
+    _values.push_back(type_cast<T>(val));
+  }
+  _size.store(size + 1, std::memory_order_release);
+}
+
+template <typename T>
+void ValueSegment<T>::append(const TypedValue& value) {
+  const auto size = _size.load(std::memory_order_relaxed);
+  if (size < _values.size()) {
+    _values[size] = type_cast<T>(value);
+  } else {
+    _values.push_back(type_cast<T>(value));
+  }
+  _size.store(size + 1, std::memory_order_release);
+}
+
+template <typename T>
+void ValueSegment<T>::append_values(const std::span<const T> values) {
+  // Values are written into the allocated storage first, the remaining ones are added to the end of the vector
+  const auto size = _size.load(std::memory_order_relaxed);
+  const auto fitting = std::min(values.size(), _values.size() - size);
+  std::copy(values.begin(), values.begin() + fitting, _values.begin() + size);
+  _values.insert(_values.end(), values.begin() + fitting, values.end());
+  _size.store(static_cast<ChunkOffset>(size + values.size()), std::memory_order_release);
+}
+
+template <typename T>
+size_t ValueSegment<T>::which() const {
+  return detail::index_of(types, hana::type_c<T>);
+}
+
+template <typename T>
+AllTypeVariant ValueSegment<T>::convert(const TypedValue& value) const {
+  return type_cast<T>(value);
+}
+
+template <typename T>
+void ValueSegment<T>::write(const ChunkOffset chunk_offset, const TypedValue& value) {
+  DebugAssert(chunk_offset < _values.size(), "ChunkOffset is out of the allocated storage");
+  DebugAssert(value.which() == which(), "Value has a different data type");
+  if constexpr (std::is_same_v<T, std::string>) {
+    _values[chunk_offset].assign(value.get<T>());
+  } else {
+    _values[chunk_offset] = value.get<T>();
+  }
+}
+
+template <typename T>
+void ValueSegment<T>::write_values(const ChunkOffset chunk_offset, const ColumnSpan& values) {
+  DebugAssert(chunk_offset + values.size() <= _values.size(), "Values do not fit into the allocated storage");
+  const auto typed_values = values.values<T>();
+  std::copy(typed_values.begin(), typed_values.end(), _values.begin() + chunk_offset);
+}
+
+template <typename T>
+void ValueSegment<T>::write_defaults(const ChunkOffset first_row, const ChunkOffset end) noexcept {
+  DebugAssert(end <= _values.size(), "Rows are out of the allocated storage");
+  for (auto chunk_offset = first_row; chunk_offset < end; ++chunk_offset) {
+    // Clearing a string keeps its buffer, so unlike assigning, it does not allocate
+    if constexpr (std::is_same_v<T, std::string>) {
+      _values[chunk_offset].clear();
+    } else {
+      _values[chunk_offset] = T{};
+    }
+  }
+}
+
+template <typename T>
+void ValueSegment<T>::publish(const ChunkOffset size) {
+  DebugAssert(size <= _values.size(), "Cannot publish more values than the allocated storage holds");
+  _size.store(size, std::memory_order_release);
 }
 
 template <typename T>
 ChunkOffset ValueSegment<T>::size() const {
-  // Implementation goes here
-  return 0;
+  return _size.load(std::memory_order_acquire);
+}
+
+template <typename T>
+std::span<const T> ValueSegment<T>::values() const {
+  return {_values.data(), size()};
 }
 
 template <typename T>
 size_t ValueSegment<T>::estimate_memory_usage() const {
-  // Implementation goes here
-  return 0;
+  return sizeof(T) * _values.size();
 }
 
 EXPLICITLY_INSTANTIATE_DATA_TYPES(ValueSegment);
@@ -1,37 +1,69 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <span>
 #include <string>
 #include <utility>
 #include <vector>
 
-#include "base_segment.hpp"
+#include "base_value_segment.hpp"
 
 namespace opossum {
 
 // ValueSegment is a segment type that stores all its values in a vector
 template <typename T>
-class ValueSegment : public BaseSegment {
+class ValueSegment : public BaseValueSegment {
  public:
+  ValueSegment() = default;
+
+  // creates a segment that takes ownership of already materialized values, e.g., from an operator
+  explicit ValueSegment(std::vector<T>&& values);
+
+  // creates an empty segment with storage for capacity values, which are written by a mutable Chunk
+  explicit ValueSegment(const ChunkOffset capacity);
+
   // return the value at a certain position. If you want to write efficient operators, back off!
   AllTypeVariant operator[](const ChunkOffset chunk_offset) const final;
 
+  TypedValue typed_value(const ChunkOffset chunk_offset) const final;
+
   // add a value to the end
   void append(const AllTypeVariant& val) final;
 
+  void append(const TypedValue& value) final;
+
+  // adds all given values to the end, allocating memory for all of them at once
+  void append_values(const std::span<const T> values);
+
+  size_t which() const final;
+
+  AllTypeVariant convert(const TypedValue& value) const final;
+
+  void write(const ChunkOffset chunk_offset, const TypedValue& value) final;
+
+  void write_values(const ChunkOffset chunk_offset, const ColumnSpan& values) final;
+
+  void write_defaults(const ChunkOffset first_row, const ChunkOffset end) noexcept final;
+
+  void publish(const ChunkOffset size) final;
+
   // return the number of entries
   ChunkOffset size() const final;
 
   // Return all values. This is the preferred method to check a value at a certain index. Usually you need to
   // access more than a single value anyway.
-  // e.g. const auto& values = value_segment.values(); and then: values[i]; in your loop.
-  const std::vector<T>& values() const;
+  // e.g. const auto values = value_segment.values(); and then: values[i]; in your loop.
+  std::span<const T> values() const;
 
   // returns the calculated memory usage
   size_t estimate_memory_usage() const final;
 
  protected:
-  // Implementation goes here
+  // Holds the values and, for segments of mutable chunks, the storage for the values that are not written yet
+  std::vector<T> _values;
+  // The number of visible values, which is published after the values have been written
+  std::atomic<ChunkOffset> _size{0};
 };
 
 }  // namespace opossum
@@ -0,0 +1,362 @@
+#include "write_ahead_log.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include <boost/crc.hpp>
+#include <boost/hana/for_each.hpp>
+
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+#include "utils/mapped_file.hpp"
+
+namespace opossum {
+
+namespace {
+
+// Reads the payload of a record, checking all reads against its bounds
+class RecordReader {
+ public:
+  explicit RecordReader(const std::string_view payload) : _payload(payload) {}
+
+  template <typename T>
+  T read() {
+    auto value = T{};
+    std::memcpy(&value, read_bytes(sizeof(T)).data(), sizeof(T));
+    return value;
+  }
+
+  std::string_view read_bytes(const size_t size) {
+    Assert(size <= _payload.size() - _position, "Write-ahead log record is corrupted");
+    const auto bytes = _payload.substr(_position, size);
+    _position += size;
+    return bytes;
+  }
+
+  std::string_view read_string() { return read_bytes(read<uint32_t>()); }
+
+  TypedValue read_value() {
+    const auto which = read<uint8_t>();
+    auto value = std::optional<TypedValue>{};
+    hana::for_each(types, [&](auto type) {
+      using Type = typename decltype(type)::type;
+      if (which != detail::index_of(types, type)) return;
+      if constexpr (std::is_same_v<Type, std::string>) {
+        value = TypedValue{read_string()};
+      } else {
+        value = TypedValue{read<Type>()};
+      }
+    });
+    Assert(value, "Write-ahead log record has an unknown data type");
+    return *value;
+  }
+
+ protected:
+  const std::string_view _payload;
+  size_t _position = 0;
+};
+
+void append_string(std::string& record, const std::string_view string) {
+  const auto size = static_cast<uint32_t>(string.size());
+  record.append(reinterpret_cast<const char*>(&size), sizeof(size));
+  record.append(string);
+}
+
+uint32_t checksum(const std::string_view payload, const uint64_t lsn) {
+  auto crc = boost::crc_32_type{};
+  crc.process_bytes(payload.data(), payload.size());
+  crc.process_bytes(&lsn, sizeof(lsn));
+  return crc.checksum();
+}
+
+// Calls func(lsn, payload, record_offset) for each record of the log and returns the size of the records. A torn or
+// corrupted record, or one whose LSN is not higher than the previous one, ends the log.
+template <typename Functor>
+size_t for_each_record(const std::string_view contents, const Functor& func) {
+  constexpr auto header_size = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+  auto offset = size_t{0};
+  auto last_lsn = std::optional<uint64_t>{};
+  while (contents.size() - offset >= header_size) {
+    auto header = RecordReader{contents.substr(offset, header_size)};
+    const auto payload_size = header.read<uint32_t>();
+    const auto record_checksum = header.read<uint32_t>();
+    const auto lsn = header.read<uint64_t>();
+    if (payload_size > contents.size() - offset - header_size) break;
+    const auto payload = contents.substr(offset + header_size, payload_size);
+    if (checksum(payload, lsn) != record_checksum || (last_lsn && lsn <= *last_lsn)) break;
+
+    func(lsn, payload, offset);
+    last_lsn = lsn;
+    offset += header_size + payload_size;
+  }
+  return offset;
+}
+
+bool write_all(const int file_descriptor, const std::string_view bytes) {
+  auto written = size_t{0};
+  while (written < bytes.size()) {
+    const auto result = ::write(file_descriptor, bytes.data() + written, bytes.size() - written);
+    if (result <= 0) return false;
+    written += static_cast<size_t>(result);
+  }
+  return true;
+}
+
+void sync_directory_of(const std::string& file_name) {
+  const auto directory = std::filesystem::path{file_name}.parent_path();
+  const auto file_descriptor = ::open(directory.empty() ? "." : directory.c_str(), O_RDONLY);
+  Assert(file_descriptor >= 0 && ::fsync(file_descriptor) == 0, "Could not sync directory of " + file_name);
+  ::close(file_descriptor);
+}
+
+}  // namespace
+
+WriteAheadLog::WriteAheadLog(const std::string& file_name)
+    : _file_name(file_name), _file_descriptor(::open(file_name.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644)) {
+  Assert(_file_descriptor >= 0, "Could not open write-ahead log " + file_name);
+}
+
+WriteAheadLog::~WriteAheadLog() { ::close(_file_descriptor); }
+
+void WriteAheadLog::recover(StorageManager& storage_manager, const uint64_t first_lsn) {
+  auto valid_size = size_t{0};
+  auto file_size = size_t{0};
+  auto last_lsn = std::optional<uint64_t>{};
+  {
+    const auto file = MappedFile{_file_name};
+    const auto contents = file.contents();
+    file_size = contents.size();
+
+    valid_size = for_each_record(contents, [&](const uint64_t lsn, const std::string_view payload, const size_t) {
+      last_lsn = lsn;
+      if (lsn < first_lsn) return;
+
+      auto reader = RecordReader{payload};
+      const auto type = reader.read<RecordType>();
+      const auto table_name = std::string{reader.read_string()};
+      switch (type) {
+        case RecordType::CreateTable: {
+          const auto target_chunk_size = reader.read<uint32_t>();
+          const auto table = std::make_shared<Table>(target_chunk_size, UseMvcc{reader.read<uint8_t>() != 0});
+          const auto column_count = reader.read<uint16_t>();
+          for (auto column_id = uint16_t{0}; column_id < column_count; ++column_id) {
+            const auto column_name = std::string{reader.read_string()};
+            table->add_column(column_name, std::string{reader.read_string()});
+          }
+          storage_manager.add_table(table_name, table);
+          break;
+        }
+        case RecordType::DropTable:
+          storage_manager.drop_table(table_name);
+          break;
+        case RecordType::Append: {
+          const auto table = storage_manager.get_table(table_name);
+          const auto row_count = reader.read<uint32_t>();
+          const auto column_count = reader.read<uint16_t>();
+          auto values = std::vector<TypedValue>{};
+          values.reserve(size_t{row_count} * column_count);
+          for (auto index = size_t{0}; index < size_t{row_count} * column_count; ++index) {
+            values.push_back(reader.read_value());
+          }
+          auto row = std::vector<TypedValue>(column_count);
+          for (auto row_index = size_t{0}; row_index < row_count; ++row_index) {
+            for (auto column_id = size_t{0}; column_id < column_count; ++column_id) {
+              row[column_id] = values[column_id * row_count + row_index];
+            }
+            table->append(row);
+          }
+          break;
+        }
+        default:
+          Fail("Write-ahead log record has an unknown type");
+      }
+    });
+  }
+
+  // Drops the remains of a record that was being written during a crash, so that new records directly follow the
+  // last complete one
+  if (valid_size < file_size) {
+    Assert(::ftruncate(_file_descriptor, static_cast<off_t>(valid_size)) == 0 && ::fdatasync(_file_descriptor) == 0,
+           "Could not truncate write-ahead log " + _file_name);
+  }
+
+  const auto lock = std::lock_guard{_mutex};
+  Assert(_next_lsn == 0, "Records were logged before recovery");
+  _next_lsn = std::max(first_lsn, last_lsn ? *last_lsn + 1 : 0);
+  _durable_lsn = _next_lsn;
+}
+
+WriteAheadLog::ChangeLock WriteAheadLog::log_create_table(const std::string& table_name, const Table& table) {
+  auto change = begin_change();
+  auto record = _begin_record(RecordType::CreateTable, table_name);
+  _encode_raw(record, uint32_t{table.target_chunk_size()});
+  _encode_raw(record, static_cast<uint8_t>(table.uses_mvcc()));
+  _encode_raw(record, static_cast<uint16_t>(table.column_count()));
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    append_string(record, table.column_name(column_id));
+    append_string(record, table.column_type(column_id));
+  }
+  _commit(record);
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    const auto chunk = table.pin_chunk(chunk_id);
+    const auto chunk_size = chunk->size();
+    if (chunk_size == 0) continue;
+
+    auto chunk_record = _begin_append(table_name, chunk_size, chunk->column_count());
+    for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+      const auto& segment = *chunk->get_segment(column_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+        _encode(chunk_record, segment.typed_value(chunk_offset));
+      }
+    }
+    _commit(chunk_record);
+  }
+  return change;
+}
+
+WriteAheadLog::ChangeLock WriteAheadLog::log_drop_table(const std::string& table_name) {
+  auto change = begin_change();
+  auto record = _begin_record(RecordType::DropTable, table_name);
+  _commit(record);
+  return change;
+}
+
+void WriteAheadLog::log_append(const ChangeLock& change, const std::string& table_name,
+                               const std::vector<ColumnSpan>& columns) {
+  DebugAssert(change.mutex() == &_change_mutex && change.owns_lock(), "Appends have to be logged within a change");
+  const auto row_count = columns.empty() ? size_t{0} : columns.front().size();
+  auto record = _begin_append(table_name, row_count, columns.size());
+  for (const auto& column : columns) {
+    column.resolve([&](const auto values) {
+      for (const auto& value : values) _encode(record, TypedValue{value});
+    });
+  }
+  _commit(record);
+}
+
+WriteAheadLog::ChangeLock WriteAheadLog::begin_change() { return ChangeLock{_change_mutex}; }
+
+std::unique_lock<std::shared_mutex> WriteAheadLog::block_changes() { return std::unique_lock{_change_mutex}; }
+
+uint64_t WriteAheadLog::next_lsn() const {
+  const auto lock = std::lock_guard{_mutex};
+  return _next_lsn;
+}
+
+void WriteAheadLog::truncate(const uint64_t first_lsn) {
+  // Records that are logged meanwhile stay in the buffer until the truncated log has replaced the old one
+  auto lock = std::unique_lock{_mutex};
+  _synced.wait(lock, [&]() { return !_syncing; });
+  Assert(!_failed, "Could not write to write-ahead log " + _file_name);
+
+  auto kept_records = std::string{};
+  {
+    const auto file = MappedFile{_file_name};
+    const auto contents = file.contents();
+    auto first_kept_offset = std::optional<size_t>{};
+    const auto size = for_each_record(contents, [&](const uint64_t lsn, const std::string_view, const size_t offset) {
+      if (lsn >= first_lsn && !first_kept_offset) first_kept_offset = offset;
+    });
+    if (first_kept_offset) kept_records = contents.substr(*first_kept_offset, size - *first_kept_offset);
+  }
+
+  // The remaining records are written to a new file, which then atomically replaces the log
+  const auto temporary_file_name = _file_name + ".tmp";
+  const auto file_descriptor = ::open(temporary_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+  Assert(file_descriptor >= 0, "Could not open write-ahead log " + temporary_file_name);
+  const auto success = write_all(file_descriptor, kept_records) && ::fdatasync(file_descriptor) == 0 &&
+                       ::rename(temporary_file_name.c_str(), _file_name.c_str()) == 0;
+  if (!success) ::close(file_descriptor);
+  Assert(success, "Could not truncate write-ahead log " + _file_name);
+  sync_directory_of(_file_name);
+
+  ::close(_file_descriptor);
+  _file_descriptor = file_descriptor;
+  ++_sync_count;
+}
+
+uint64_t WriteAheadLog::sync_count() const {
+  const auto lock = std::lock_guard{_mutex};
+  return _sync_count;
+}
+
+std::string WriteAheadLog::_begin_record(const RecordType type, const std::string& table_name) {
+  // The header is filled in by _commit
+  auto record = std::string(HEADER_SIZE, '\0');
+  _encode_raw(record, type);
+  append_string(record, table_name);
+  return record;
+}
+
+std::string WriteAheadLog::_begin_append(const std::string& table_name, const size_t row_count,
+                                         const size_t column_count) {
+  auto record = _begin_record(RecordType::Append, table_name);
+  _encode_raw(record, static_cast<uint32_t>(row_count));
+  _encode_raw(record, static_cast<uint16_t>(column_count));
+  return record;
+}
+
+void WriteAheadLog::_encode(std::string& record, const TypedValue& value) {
+  _encode_raw(record, static_cast<uint8_t>(value.which()));
+  value.visit([&](const auto typed_value) {
+    if constexpr (std::is_same_v<std::remove_cv_t<decltype(typed_value)>, std::string_view>) {
+      append_string(record, typed_value);
+    } else {
+      _encode_raw(record, typed_value);
+    }
+  });
+}
+
+void WriteAheadLog::_commit(std::string& record) {
+  const auto payload_size = record.size() - HEADER_SIZE;
+  Assert(payload_size <= std::numeric_limits<uint32_t>::max(), "Write-ahead log record is too large");
+  const auto payload = std::string_view{record}.substr(HEADER_SIZE);
+
+  auto lock = std::unique_lock{_mutex};
+  const auto lsn = _next_lsn++;
+  const auto header = std::array<uint32_t, 2>{static_cast<uint32_t>(payload_size), checksum(payload, lsn)};
+  std::memcpy(record.data(), header.data(), sizeof(header));
+  std::memcpy(record.data() + sizeof(header), &lsn, sizeof(lsn));
+  _buffer.append(record);
+
+  while (_durable_lsn <= lsn) {
+    Assert(!_failed, "Could not write to write-ahead log " + _file_name);
+    if (_syncing) {
+      _synced.wait(lock);
+      continue;
+    }
+
+    // This writer becomes the leader of the next group and writes the records of all writers that are waiting
+    _syncing = true;
+    const auto batch = std::move(_buffer);
+    _buffer.clear();
+    const auto batch_end_lsn = _next_lsn;
+    lock.unlock();
+
+    const auto success = write_all(_file_descriptor, batch) && ::fdatasync(_file_descriptor) == 0;
+
+    lock.lock();
+    _syncing = false;
+    _failed |= !success;
+    if (success) _durable_lsn = batch_end_lsn;
+    ++_sync_count;
+    _synced.notify_all();
+  }
+}
+
+}  // namespace opossum
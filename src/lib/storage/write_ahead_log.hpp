@@ -0,0 +1,121 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <vector>
+
+#include "storage/column_span.hpp"
+#include "typed_value.hpp"
+#include "types.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+class StorageManager;
+class Table;
+
+/**
+ * A write-ahead log that makes changes to the tables of the StorageManager durable (see
+ * StorageManager::enable_durability). Each change is written as one record, and the logging call only returns once
+ * the record is on disk:
+ *
+ *   record:   uint32 payload length, uint32 CRC-32 of the payload and the LSN, uint64 LSN, payload
+ *   payload:  uint8 record type, uint32 length + characters of the table name, and
+ *             - for CreateTable: uint32 target chunk size, uint8 whether the table uses MVCC, uint16 column count,
+ *               per column name and type as above
+ *             - for Append: uint32 row count, uint16 column count, the values column by column, each as uint8 data
+ *               type (as in AllTypeVariant::which()) and the number, or uint32 length + characters for strings
+ *
+ * Concurrent writers share fsyncs (group commit): the first writer that waits for its record writes all records
+ * buffered so far and syncs them, while the others wait for that sync and find their records already on disk. So the
+ * number of syncs does not grow with the number of writers.
+ *
+ * Logging a change returns a ChangeLock, which the caller holds until it has applied the change to the table. Appends
+ * are logged within a ChangeLock that the caller took before (see Table::set_write_ahead_log). A checkpoint (see
+ * Checkpointer) blocks changes for a moment with block_changes(), so that every change with an LSN below next_lsn()
+ * is fully applied and no other change is, which gives it a consistent state of all tables.
+ */
+class WriteAheadLog : private Noncopyable {
+ public:
+  // Opens the log file, creating it if it does not exist
+  explicit WriteAheadLog(const std::string& file_name);
+
+  ~WriteAheadLog();
+
+  // Applies the records with an LSN of at least first_lsn to the tables of the storage manager. A torn or corrupted
+  // record at the end of the log (i.e., one that was being written during a crash) and everything after it are
+  // removed. Has to be called before any records are logged.
+  void recover(StorageManager& storage_manager, uint64_t first_lsn);
+
+  using ChangeLock = std::shared_lock<std::shared_mutex>;
+
+  // Logs the schema and all rows of a table that is added to the StorageManager
+  [[nodiscard]] ChangeLock log_create_table(const std::string& table_name, const Table& table);
+
+  [[nodiscard]] ChangeLock log_drop_table(const std::string& table_name);
+
+  // Logs a row given as a container of AllTypeVariants or TypedValues. The caller holds the change (see begin_change)
+  // until it has appended the row.
+  template <typename Values>
+  void log_append(const ChangeLock& change, const std::string& table_name, const Values& row) {
+    DebugAssert(change.mutex() == &_change_mutex && change.owns_lock(), "Appends have to be logged within a change");
+    auto record = _begin_append(table_name, 1, row.size());
+    for (const auto& value : row) _encode(record, TypedValue{value});
+    _commit(record);
+  }
+
+  // Logs the rows appended by Table::append_columns, as above
+  void log_append(const ChangeLock& change, const std::string& table_name, const std::vector<ColumnSpan>& columns);
+
+  // For changes that do not need to be logged, but must not be half-applied when a checkpoint sees the tables (e.g.,
+  // replacing a chunk by its compressed version)
+  [[nodiscard]] ChangeLock begin_change();
+
+  // Waits until all changes that are being logged are applied and blocks new ones while the lock is held
+  [[nodiscard]] std::unique_lock<std::shared_mutex> block_changes();
+
+  // The LSN of the next record, i.e., all changes logged so far have a lower LSN
+  uint64_t next_lsn() const;
+
+  // Removes the records with an LSN below first_lsn, once their changes have been persisted in a checkpoint. Records
+  // can be logged concurrently.
+  void truncate(uint64_t first_lsn);
+
+  // The number of fsyncs so far, which is lower than the number of records when commits were grouped
+  uint64_t sync_count() const;
+
+ protected:
+  enum class RecordType : uint8_t { CreateTable = 0, DropTable = 1, Append = 2 };
+
+  static constexpr auto HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t) + sizeof(uint64_t);
+
+  static std::string _begin_record(RecordType type, const std::string& table_name);
+  static std::string _begin_append(const std::string& table_name, size_t row_count, size_t column_count);
+  static void _encode(std::string& record, const TypedValue& value);
+
+  template <typename T>
+  static void _encode_raw(std::string& record, const T& value) {
+    record.append(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  // Assigns the next LSN to the record and returns once the record is on disk
+  void _commit(std::string& record);
+
+  const std::string _file_name;
+  int _file_descriptor;
+
+  std::shared_mutex _change_mutex;
+  mutable std::mutex _mutex;
+  std::condition_variable _synced;
+  std::string _buffer;
+  uint64_t _next_lsn = 0;
+  uint64_t _durable_lsn = 0;
+  uint64_t _sync_count = 0;
+  bool _syncing = false;
+  bool _failed = false;
+};
+
+}  // namespace opossum
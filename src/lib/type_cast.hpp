@@ -1,31 +1,21 @@
 #pragma once
 
+#include <charconv>
+#include <optional>
 #include <string>
+#include <string_view>
+#include <type_traits>
 
 #include <boost/hana/contains.hpp>
-#include <boost/hana/integral_constant.hpp>
-#include <boost/hana/not_equal.hpp>
-#include <boost/hana/size.hpp>
-#include <boost/hana/take_while.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "all_type_variant.hpp"
+#include "typed_value.hpp"
 
 namespace opossum {
 
 namespace hana = boost::hana;
 
-namespace detail {
-
-// Returns the index of type T in an Iterable
-template <typename Sequence, typename T>
-constexpr auto index_of(Sequence const& sequence, T const& element) {
-  constexpr auto size = decltype(hana::size(hana::take_while(sequence, hana::not_equal.to(element)))){};
-  return static_cast<size_t>(decltype(size)::value);
-}
-
-}  // namespace detail
-
 // Retrieves the value stored in an AllTypeVariant without conversion
 template <typename T>
 const T& get(const AllTypeVariant& value) {
@@ -33,26 +23,84 @@ const T& get(const AllTypeVariant& value) {
   return boost::get<T>(value);
 }
 
+namespace detail {
+
+// Parses a number from a string without allocating. Returns std::nullopt if the string is not exactly a number of
+// type T, in which case callers fall back to boost::lexical_cast and its conversion rules.
+template <typename T>
+std::optional<T> parse_number(const std::string_view string) {
+  auto number = T{};
+  const auto end = string.data() + string.size();
+  const auto [pointer, error] = std::from_chars(string.data(), end, number);
+  if (error != std::errc{} || pointer != end) return std::nullopt;
+  return number;
+}
+
+// Converts a value to the arithmetic type T. Numbers are converted directly instead of being formatted and parsed by
+// boost::lexical_cast: integers are range-checked and floating-point numbers are truncated when converted to integers.
+template <typename T, typename Source>
+T arithmetic_cast(const Source& value) {
+  if constexpr (std::is_arithmetic_v<Source>) {
+    if constexpr (std::is_integral_v<T>) {
+      return boost::numeric_cast<T>(value);
+    } else {
+      return static_cast<T>(value);
+    }
+  } else {
+    if (const auto number = parse_number<T>(value)) return *number;
+
+    const auto string = std::string{value};
+    if constexpr (std::is_integral_v<T>) {
+      try {
+        return boost::lexical_cast<T>(string);
+      } catch (...) {
+        return boost::numeric_cast<T>(boost::lexical_cast<double>(string));
+      }
+    } else {
+      return boost::lexical_cast<T>(string);
+    }
+  }
+}
+
+}  // namespace detail
+
 // cast methods - from variant to specific type
 
-// Template specialization for everything but integral types
+// Template specialization for arithmetic types
 template <typename T>
-std::enable_if_t<!std::is_integral<T>::value, T> type_cast(const AllTypeVariant& value) {
+std::enable_if_t<std::is_arithmetic_v<T>, T> type_cast(const AllTypeVariant& value) {
   if (static_cast<size_t>(value.which()) == detail::index_of(types, hana::type_c<T>)) return get<T>(value);
 
-  return boost::lexical_cast<T>(value);
+  return boost::apply_visitor([](const auto& source) { return detail::arithmetic_cast<T>(source); }, value);
 }
 
-// Template specialization for integral types
+// Template specialization for strings
 template <typename T>
-std::enable_if_t<std::is_integral<T>::value, T> type_cast(const AllTypeVariant& value) {
+std::enable_if_t<!std::is_arithmetic_v<T>, T> type_cast(const AllTypeVariant& value) {
   if (static_cast<size_t>(value.which()) == detail::index_of(types, hana::type_c<T>)) return get<T>(value);
 
-  try {
-    return boost::lexical_cast<T>(value);
-  } catch (...) {
-    return boost::numeric_cast<T>(boost::lexical_cast<double>(value));
-  }
+  return boost::lexical_cast<T>(value);
+}
+
+// cast methods - from TypedValue to specific type, which never allocate unless a string is returned
+
+template <typename T>
+std::enable_if_t<std::is_arithmetic_v<T>, T> type_cast(const TypedValue& value) {
+  return value.visit([](const auto source) { return detail::arithmetic_cast<T>(source); });
+}
+
+template <typename T>
+std::enable_if_t<!std::is_arithmetic_v<T>, T> type_cast(const TypedValue& value) {
+  if (value.is_string()) return T{value.get<std::string>()};
+
+  // Numbers are formatted as for AllTypeVariant
+  return value.visit([](const auto source) {
+    if constexpr (std::is_arithmetic_v<decltype(source)>) {
+      return boost::lexical_cast<T>(source);
+    } else {
+      return T{source};
+    }
+  });
 }
 
 }  // namespace opossum
@@ -0,0 +1,42 @@
+#include "typed_value.hpp"
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace opossum {
+
+TypedValue::TypedValue(const AllTypeVariant& value) : TypedValue() {
+  boost::apply_visitor([&](const auto& typed_value) { *this = TypedValue{typed_value}; }, value);
+}
+
+AllTypeVariant TypedValue::to_variant() const {
+  return visit([](const auto value) {
+    if constexpr (std::is_same_v<std::remove_cv_t<decltype(value)>, std::string_view>) {
+      return AllTypeVariant{std::string{value}};
+    } else {
+      return AllTypeVariant{value};
+    }
+  });
+}
+
+bool operator==(const TypedValue& lhs, const TypedValue& rhs) {
+  if (lhs.which() != rhs.which()) return false;
+  return lhs.visit([&](const auto value) {
+    using Type = std::remove_cv_t<decltype(value)>;
+    if constexpr (std::is_same_v<Type, std::string_view>) {
+      return value == rhs.get<std::string>();
+    } else {
+      return value == rhs.get<Type>();
+    }
+  });
+}
+
+bool operator!=(const TypedValue& lhs, const TypedValue& rhs) { return !(lhs == rhs); }
+
+std::ostream& operator<<(std::ostream& stream, const TypedValue& value) {
+  value.visit([&](const auto typed_value) { stream << typed_value; });
+  return stream;
+}
+
+}  // namespace opossum
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "all_type_variant.hpp"
+
+namespace opossum {
+
+/**
+ * A value of one of the data types of AllTypeVariant in 16 bytes. Unlike AllTypeVariant, which holds a std::string,
+ * TypedValue only points to the characters of a string that is owned elsewhere (e.g., by a segment or a variant), so
+ * that creating and copying it never allocates. It is meant for hot paths that handle single values, such as
+ * appending rows and reading values from segments. The referenced string has to outlive the TypedValue.
+ *
+ * The constructors are explicit so that calls with plain numbers or strings keep resolving to the AllTypeVariant
+ * overloads of functions that accept both.
+ */
+class TypedValue {
+ public:
+  TypedValue() : TypedValue(int32_t{0}) {}
+
+  explicit TypedValue(const int32_t value) : _int32(value), _which(_index_of<int32_t>()) {}
+  explicit TypedValue(const int64_t value) : _int64(value), _which(_index_of<int64_t>()) {}
+  explicit TypedValue(const float value) : _float(value), _which(_index_of<float>()) {}
+  explicit TypedValue(const double value) : _double(value), _which(_index_of<double>()) {}
+  explicit TypedValue(const std::string_view value)
+      : _string_data(value.data()), _string_length(static_cast<uint32_t>(value.size())),
+        _which(_index_of<std::string>()) {}
+  explicit TypedValue(const std::string& value) : TypedValue(std::string_view{value}) {}
+  explicit TypedValue(const char* value) : TypedValue(std::string_view{value}) {}
+
+  // References the string of the variant instead of copying it
+  explicit TypedValue(const AllTypeVariant& value);
+
+  // Copies the value (including the characters of a string) into an AllTypeVariant
+  AllTypeVariant to_variant() const;
+
+  // The index of the data type in data_types, which is the same as AllTypeVariant::which()
+  size_t which() const { return _which; }
+
+  bool is_string() const { return _which == _index_of<std::string>(); }
+
+  // Returns the value of type T, which has to be the stored data type. Strings are returned as std::string_view.
+  template <typename T>
+  auto get() const {
+    if constexpr (std::is_same_v<T, int32_t>) {
+      return _int32;
+    } else if constexpr (std::is_same_v<T, int64_t>) {
+      return _int64;
+    } else if constexpr (std::is_same_v<T, float>) {
+      return _float;
+    } else if constexpr (std::is_same_v<T, double>) {
+      return _double;
+    } else {
+      static_assert(std::is_same_v<T, std::string>, "Type not in AllTypeVariant");
+      return std::string_view{_string_data, _string_length};
+    }
+  }
+
+  // Calls func with the stored value, passing strings as std::string_view
+  template <typename Functor>
+  decltype(auto) visit(const Functor& func) const {
+    switch (_which) {
+      case _index_of<int32_t>():
+        return func(_int32);
+      case _index_of<int64_t>():
+        return func(_int64);
+      case _index_of<float>():
+        return func(_float);
+      case _index_of<double>():
+        return func(_double);
+      default:
+        return func(std::string_view{_string_data, _string_length});
+    }
+  }
+
+ protected:
+  template <typename T>
+  static constexpr uint8_t _index_of() {
+    return static_cast<uint8_t>(detail::index_of(types, hana::type_c<T>));
+  }
+
+  union {
+    int32_t _int32;
+    int64_t _int64;
+    float _float;
+    double _double;
+    const char* _string_data;
+  };
+  uint32_t _string_length = 0;
+  uint8_t _which;
+};
+
+static_assert(sizeof(TypedValue) == 16, "TypedValue should fit into two registers");
+
+// Values of different data types are never equal, as for AllTypeVariant
+bool operator==(const TypedValue& lhs, const TypedValue& rhs);
+bool operator!=(const TypedValue& lhs, const TypedValue& rhs);
+
+std::ostream& operator<<(std::ostream& stream, const TypedValue& value);
+
+}  // namespace opossum
@@ -1,13 +1,17 @@
 #pragma once
 
 #include <cstdint>
+#include <initializer_list>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <memory_resource>
 #include <string>
 #include <tuple>
 #include <vector>
 
 #include "strong_typedef.hpp"
+#include "utils/query_arena.hpp"
 
 /**
  * We use STRONG_TYPEDEF to avoid things like adding chunk ids and value ids.
@@ -36,6 +40,20 @@ STRONG_TYPEDEF(uint32_t, ValueID);  // Cannot be larger than ChunkOffset
 namespace opossum {
 
 using ChunkOffset = uint32_t;
+
+// Commit IDs order the committed transactions, transaction IDs identify the running ones (see TransactionManager)
+using CommitID = uint32_t;
+using TransactionID = uint32_t;
+
+// The begin commit ID of rows whose insert is not committed yet, and the end commit ID of rows that are not deleted
+constexpr CommitID MAX_COMMIT_ID{std::numeric_limits<CommitID>::max()};
+// The transaction ID of rows that no transaction inserts or deletes at the moment
+constexpr TransactionID INVALID_TRANSACTION_ID{0};
+// The transaction ID that locks rows which were moved to another chunk by compaction (see ChunkCompactor), so that
+// transactions that try to delete them through the old chunk get a write-write conflict
+constexpr TransactionID MOVED_ROW_TRANSACTION_ID{std::numeric_limits<TransactionID>::max()};
+
+constexpr ChunkID INVALID_CHUNK_ID{std::numeric_limits<ChunkID::base_type>::max()};
 using AttributeVectorWidth = uint8_t;
 
 struct RowID {
@@ -52,9 +70,45 @@ struct RowID {
   }
 };
 
-enum class ScanType { OpEquals, OpNotEquals, OpLessThan, OpLessThanEquals, OpGreaterThan, OpGreaterThanEquals };
+// OpBetween matches values within an inclusive range [search_value, upper_value], OpIn values that are part of a list,
+// OpLike strings that match an SQL LIKE pattern with the wildcards % and _, and OpJoinFilter values that may occur on
+// the build side of a join (see JoinFilter)
+enum class ScanType {
+  OpEquals,
+  OpNotEquals,
+  OpLessThan,
+  OpLessThanEquals,
+  OpGreaterThan,
+  OpGreaterThanEquals,
+  OpBetween,
+  OpIn,
+  OpLike,
+  OpJoinFilter
+};
+
+enum class OrderByMode { Ascending, Descending };
 
-using PosList = std::vector<RowID>;
+// Whether the chunks of a table keep the MVCC columns that are needed to run transactions on it (see MvccData)
+enum class UseMvcc : bool { No, Yes };
+
+// A list of row ids, e.g., the rows that a ReferenceSegment refers to. Its buffer is allocated from the memory resource
+// that is current when the list is created (see current_memory_resource), i.e., from the QueryArena of the query that
+// creates it or from the pool that recycles PosList buffers. Copies use the current resource as well.
+class PosList : public std::pmr::vector<RowID> {
+ public:
+  PosList() : std::pmr::vector<RowID>(current_memory_resource()) {}
+  explicit PosList(const size_t size) : std::pmr::vector<RowID>(size, current_memory_resource()) {}
+  PosList(const std::initializer_list<RowID> row_ids) : std::pmr::vector<RowID>(row_ids, current_memory_resource()) {}
+
+  template <std::input_iterator Iterator>
+  PosList(const Iterator begin, const Iterator end) : std::pmr::vector<RowID>(begin, end, current_memory_resource()) {}
+
+  PosList(const PosList& other) : std::pmr::vector<RowID>(other, current_memory_resource()) {}
+  PosList(PosList&& other) noexcept = default;
+  PosList& operator=(const PosList& other) = default;
+  PosList& operator=(PosList&& other) = default;
+  ~PosList() = default;
+};
 
 // Prevents unnecessary, potentially expensive, copies by deleting copy constructor and copy assignment operator.
 class Noncopyable {
@@ -0,0 +1,316 @@
+#include "binary_table.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/fixed_size_attribute_vector.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/parallel_for.hpp"
+
+namespace opossum {
+
+namespace {
+
+constexpr auto MAGIC = std::string_view{"OPOSSUMB"};
+constexpr auto VERSION = uint32_t{1};
+constexpr auto ALIGNMENT = size_t{8};
+
+enum class SegmentEncoding : uint32_t { Value = 0, Dictionary = 1 };
+
+class BinaryWriter {
+ public:
+  explicit BinaryWriter(const std::string& file_name) : _stream(file_name, std::ios::binary | std::ios::trunc) {
+    Assert(_stream.is_open(), "Could not open file " + file_name);
+  }
+
+  template <typename T>
+  void write(const T& value) {
+    write_bytes(&value, sizeof(T));
+  }
+
+  void write_bytes(const void* data, const size_t size) {
+    _stream.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    _position += size;
+  }
+
+  void write_string(const std::string& string) {
+    write(static_cast<uint32_t>(string.size()));
+    write_bytes(string.data(), string.size());
+  }
+
+  template <typename T>
+  void write_values(const std::span<const T> values) {
+    if constexpr (std::is_same_v<T, std::string>) {
+      auto offset = uint64_t{0};
+      write(offset);
+      for (const auto& value : values) {
+        offset += value.size();
+        write(offset);
+      }
+      for (const auto& value : values) write_bytes(value.data(), value.size());
+    } else {
+      write_bytes(values.data(), values.size() * sizeof(T));
+    }
+  }
+
+  void align() {
+    constexpr char zeros[ALIGNMENT] = {};
+    write_bytes(zeros, (ALIGNMENT - _position % ALIGNMENT) % ALIGNMENT);
+  }
+
+  // Reserves space for offsets that are only known later, see write_offsets
+  uint64_t reserve_offsets(const size_t count) {
+    const auto position = _position;
+    for (auto index = size_t{0}; index < count; ++index) write(uint64_t{0});
+    return position;
+  }
+
+  void write_offsets(const uint64_t position, const std::vector<uint64_t>& offsets) {
+    _stream.seekp(static_cast<std::streamoff>(position));
+    _stream.write(reinterpret_cast<const char*>(offsets.data()),
+                  static_cast<std::streamsize>(offsets.size() * sizeof(uint64_t)));
+    _stream.seekp(static_cast<std::streamoff>(_position));
+  }
+
+  uint64_t position() const { return _position; }
+
+  void close() {
+    _stream.close();
+    Assert(!_stream.fail(), "Could not write binary table");
+  }
+
+ protected:
+  std::ofstream _stream;
+  uint64_t _position = 0;
+};
+
+// Reads from the mapping, checking all reads against its bounds, so that corrupted files fail with an exception
+class BinaryReader {
+ public:
+  BinaryReader(const std::string_view contents, const size_t position) : _contents(contents), _position(position) {}
+
+  template <typename T>
+  T read() {
+    auto value = T{};
+    std::memcpy(&value, read_bytes(sizeof(T)), sizeof(T));
+    return value;
+  }
+
+  const char* read_bytes(const size_t size) {
+    Assert(_position <= _contents.size() && size <= _contents.size() - _position, "Binary table is truncated");
+    const auto bytes = _contents.data() + _position;
+    _position += size;
+    return bytes;
+  }
+
+  std::string read_string() {
+    const auto size = read<uint32_t>();
+    return std::string{read_bytes(size), size};
+  }
+
+  template <typename T>
+  std::vector<T> read_values(const size_t count) {
+    if constexpr (std::is_same_v<T, std::string>) {
+      Assert(count < _contents.size() / sizeof(uint64_t), "Binary table is corrupted");
+      const auto offsets = read_bytes((count + 1) * sizeof(uint64_t));
+      const auto offset_at = [&](const size_t index) {
+        auto offset = uint64_t{0};
+        std::memcpy(&offset, offsets + index * sizeof(uint64_t), sizeof(offset));
+        return offset;
+      };
+      const auto characters = read_bytes(offset_at(count));
+
+      auto values = std::vector<T>{};
+      values.reserve(count);
+      for (auto index = size_t{0}; index < count; ++index) {
+        const auto begin = offset_at(index);
+        const auto end = offset_at(index + 1);
+        Assert(begin <= end && end <= offset_at(count), "Binary table is corrupted");
+        values.emplace_back(characters + begin, end - begin);
+      }
+      return values;
+    } else {
+      Assert(count <= _contents.size() / sizeof(T), "Binary table is corrupted");
+      auto values = std::vector<T>(count);
+      std::memcpy(values.data(), read_bytes(count * sizeof(T)), count * sizeof(T));
+      return values;
+    }
+  }
+
+  void align() { _position += (ALIGNMENT - _position % ALIGNMENT) % ALIGNMENT; }
+
+ protected:
+  const std::string_view _contents;
+  size_t _position;
+};
+
+// Writes the first chunk_size values of a segment. The ValueSegments of a mutable chunk can already hold rows that
+// were appended after the chunk size was read.
+template <typename T>
+void write_segment(BinaryWriter& writer, const BaseSegment& segment, const ChunkOffset chunk_size) {
+  if (const auto value_segment = dynamic_cast<const ValueSegment<T>*>(&segment)) {
+    const auto values = value_segment->values().first(chunk_size);
+    writer.write(SegmentEncoding::Value);
+    writer.write(uint32_t{0});
+    writer.write(static_cast<uint64_t>(values.size()));
+    writer.write_values(values);
+    return;
+  }
+
+  const auto dictionary_segment = dynamic_cast<const DictionarySegment<T>*>(&segment);
+  Assert(dictionary_segment, "Only ValueSegments and DictionarySegments can be written, materialize the table first");
+  const auto& dictionary = *dictionary_segment->dictionary();
+  const auto& attribute_vector = *dictionary_segment->attribute_vector();
+  writer.write(SegmentEncoding::Dictionary);
+  writer.write(static_cast<uint32_t>(attribute_vector.width()));
+  writer.write(static_cast<uint64_t>(dictionary.size()));
+  writer.write_values(std::span<const T>{dictionary});
+  writer.align();
+  resolve_attribute_vector(attribute_vector, [&](const auto value_ids) {
+    writer.write_bytes(value_ids.data(), value_ids.size_bytes());
+  });
+}
+
+template <typename uintX_t>
+std::shared_ptr<BaseAttributeVector> map_attribute_vector(BinaryReader& reader, const ChunkOffset row_count,
+                                                          const std::shared_ptr<const MappedFile>& file) {
+  const auto value_ids = reinterpret_cast<const uintX_t*>(reader.read_bytes(size_t{row_count} * sizeof(uintX_t)));
+  return std::make_shared<FixedSizeAttributeVector<uintX_t>>(std::span<const uintX_t>{value_ids, row_count}, file);
+}
+
+template <typename T>
+std::shared_ptr<BaseSegment> read_segment(BinaryReader& reader, const ChunkOffset row_count,
+                                          const std::shared_ptr<const MappedFile>& file) {
+  const auto encoding = reader.read<SegmentEncoding>();
+  const auto width = reader.read<uint32_t>();
+  const auto value_count = reader.read<uint64_t>();
+  auto values = reader.read_values<T>(value_count);
+
+  if (encoding == SegmentEncoding::Value) {
+    Assert(value_count == row_count, "Binary table is corrupted");
+    return std::make_shared<ValueSegment<T>>(std::move(values));
+  }
+
+  Assert(encoding == SegmentEncoding::Dictionary, "Unknown segment encoding");
+  reader.align();
+  auto attribute_vector = std::shared_ptr<BaseAttributeVector>{};
+  switch (width) {
+    case 1:
+      attribute_vector = map_attribute_vector<uint8_t>(reader, row_count, file);
+      break;
+    case 2:
+      attribute_vector = map_attribute_vector<uint16_t>(reader, row_count, file);
+      break;
+    case 4:
+      attribute_vector = map_attribute_vector<uint32_t>(reader, row_count, file);
+      break;
+    default:
+      Fail("Unsupported attribute vector width");
+  }
+  return std::make_shared<DictionarySegment<T>>(std::make_shared<std::vector<T>>(std::move(values)), attribute_vector);
+}
+
+}  // namespace
+
+void write_binary_table(const Table& table, const std::string& file_name) {
+  auto writer = BinaryWriter{file_name};
+  writer.write_bytes(MAGIC.data(), MAGIC.size());
+  writer.write(VERSION);
+  writer.write(static_cast<uint32_t>(table.column_count()));
+  writer.write(static_cast<uint32_t>(table.target_chunk_size()));
+  // Rows and chunks can still be added while the table is written, so the chunk count and the chunk sizes are read once
+  const auto chunk_count = table.chunk_count();
+  writer.write(static_cast<uint32_t>(chunk_count));
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    writer.write_string(table.column_name(column_id));
+    writer.write_string(table.column_type(column_id));
+  }
+  writer.align();
+
+  const auto chunk_offsets_position = writer.reserve_offsets(chunk_count);
+  auto chunk_offsets = std::vector<uint64_t>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.pin_chunk(chunk_id);
+    const auto chunk_size = chunk->size();
+    chunk_offsets.push_back(writer.position());
+    writer.write(static_cast<uint32_t>(chunk_size));
+    writer.write(uint32_t{0});
+
+    const auto segment_offsets_position = writer.reserve_offsets(chunk->column_count());
+    auto segment_offsets = std::vector<uint64_t>{};
+    for (auto column_id = ColumnID{0}; column_id < chunk->column_count(); ++column_id) {
+      writer.align();
+      segment_offsets.push_back(writer.position());
+      resolve_data_type(table.column_type(column_id), [&](auto type) {
+        using Type = typename decltype(type)::type;
+        write_segment<Type>(writer, *chunk->get_segment(column_id), chunk_size);
+      });
+    }
+    writer.write_offsets(segment_offsets_position, segment_offsets);
+    writer.align();
+  }
+  writer.write_offsets(chunk_offsets_position, chunk_offsets);
+  writer.close();
+}
+
+std::shared_ptr<Table> open_binary_table(const std::string& file_name) {
+  const auto file = std::make_shared<const MappedFile>(file_name);
+  const auto contents = file->contents();
+
+  auto reader = BinaryReader{contents, 0};
+  Assert(std::string_view(reader.read_bytes(MAGIC.size()), MAGIC.size()) == MAGIC, file_name + " is no binary table");
+  Assert(reader.read<uint32_t>() == VERSION, "Unsupported version of the binary table format");
+  const auto column_count = reader.read<uint32_t>();
+  const auto target_chunk_size = reader.read<uint32_t>();
+  const auto chunk_count = reader.read<uint32_t>();
+
+  auto table = std::make_shared<Table>(target_chunk_size);
+  auto column_types = std::vector<std::string>{};
+  for (auto column_id = uint32_t{0}; column_id < column_count; ++column_id) {
+    auto column_name = reader.read_string();
+    column_types.push_back(reader.read_string());
+    table->add_column(column_name, column_types.back());
+  }
+  reader.align();
+
+  auto chunk_offsets = std::vector<uint64_t>(chunk_count);
+  for (auto& chunk_offset : chunk_offsets) chunk_offset = reader.read<uint64_t>();
+
+  auto chunks = std::vector<Chunk>(chunk_count);
+  parallel_for(chunks.size(), [&](const size_t chunk_index) {
+    auto chunk_reader = BinaryReader{contents, chunk_offsets[chunk_index]};
+    const auto row_count = chunk_reader.read<uint32_t>();
+    chunk_reader.read<uint32_t>();
+
+    for (auto column_id = size_t{0}; column_id < column_count; ++column_id) {
+      auto segment_reader = BinaryReader{contents, chunk_reader.read<uint64_t>()};
+      resolve_data_type(column_types[column_id], [&](auto type) {
+        using Type = typename decltype(type)::type;
+        chunks[chunk_index].add_segment(read_segment<Type>(segment_reader, row_count, file));
+      });
+    }
+  });
+  for (auto& chunk : chunks) table->emplace_chunk(std::move(chunk));
+
+  return table;
+}
+
+std::shared_ptr<Table> open_binary_table(const std::string& file_name, const std::string& table_name) {
+  const auto table = open_binary_table(file_name);
+  StorageManager::get().add_table(table_name, table);
+  return table;
+}
+
+}  // namespace opossum
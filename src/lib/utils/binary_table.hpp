@@ -0,0 +1,36 @@
+#pragma once
+
+#include <memory>
+#include <string>
+
+namespace opossum {
+
+class Table;
+
+/**
+ * A binary file format for tables that can be opened without parsing or encoding the data again. All numbers are
+ * stored in the byte order of the machine, and all sections start at offsets that are multiples of 8.
+ *
+ *   header:   "OPOSSUMB", uint32 version, uint32 column count, uint32 target chunk size, uint32 chunk count,
+ *             per column: uint32 length + characters of the name, uint32 length + characters of the type
+ *             uint64 offset of each chunk
+ *   chunk:    uint32 row count, uint32 padding, uint64 offset of each segment
+ *   segment:  uint32 encoding (0: ValueSegment, 1: DictionarySegment), uint32 attribute vector width,
+ *             uint64 number of values (of the dictionary for DictionarySegments), the values,
+ *             and for DictionarySegments the attribute vector with one value id of the given width per row
+ *   values:   numbers as an array, strings as uint64 offsets (number of values + 1) into the following characters
+ *
+ * ReferenceSegments cannot be written, they have to be materialized first.
+ */
+void write_binary_table(const Table& table, const std::string& file_name);
+
+// Opens a file written by write_binary_table by mapping it into memory. The attribute vectors of DictionarySegments,
+// i.e., the bulk of an encoded table, point directly into the mapping, which stays mapped as long as they exist.
+// Dictionaries and the values of ValueSegments are copied from the mapping, with a single memcpy for numbers, since
+// segments own them as std::vectors. Chunks are read in parallel.
+std::shared_ptr<Table> open_binary_table(const std::string& file_name);
+
+// Same as above, and adds the table to the StorageManager
+std::shared_ptr<Table> open_binary_table(const std::string& file_name, const std::string& table_name);
+
+}  // namespace opossum
@@ -1,34 +1,182 @@
 #include "load_table.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+#include "resolve_type.hpp"
+#include "storage/dictionary_segment.hpp"
 #include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "type_cast.hpp"
+#include "typed_value.hpp"
+#include "utils/assert.hpp"
+#include "utils/mapped_file.hpp"
+#include "utils/parallel_for.hpp"
 
 namespace opossum {
 
-std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size) {
-  std::ifstream infile(file_name);
-  Assert(infile.is_open(), "load_table: Could not find file " + file_name);
+namespace {
 
-  std::string line;
-  std::getline(infile, line);
-  std::vector<std::string> column_names = _split<std::string>(line, '|');
-  std::getline(infile, line);
-  std::vector<std::string> column_types = _split<std::string>(line, '|');
+// Ranges smaller than this are not worth a task of their own
+constexpr auto MIN_BYTES_PER_RANGE = size_t{1} << 16;
 
-  std::shared_ptr<Table> test_table = std::make_shared<Table>(chunk_size);
-  for (auto column_id = ColumnID{0}; column_id < column_names.size(); column_id++) {
-    test_table->add_column(column_names[column_id], column_types[column_id]);
+// Returns the line that starts at position and moves position to the beginning of the next line
+std::string_view next_line(const std::string_view text, size_t& position) {
+  const auto line_end = std::min(text.find('\n', position), text.size());
+  auto line = text.substr(position, line_end - position);
+  position = std::min(line_end + 1, text.size());
+  if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+  return line;
+}
+
+std::vector<std::string_view> split_line(const std::string_view line, const char delimiter) {
+  auto fields = std::vector<std::string_view>{};
+  auto field_begin = size_t{0};
+  while (true) {
+    const auto field_end = std::min(line.find(delimiter, field_begin), line.size());
+    fields.push_back(line.substr(field_begin, field_end - field_begin));
+    if (field_end == line.size()) break;
+    field_begin = field_end + 1;
+  }
+  return fields;
+}
+
+// Parses the rows in text into a chunk. The fields are first split column-wise, so that each column is then parsed in
+// a tight loop with its data type resolved once.
+Chunk parse_chunk(const std::string_view text, const std::vector<std::string>& column_types, const char delimiter,
+                  const bool compress_chunk) {
+  const auto column_count = column_types.size();
+  auto fields = std::vector<std::vector<std::string_view>>(column_count);
+
+  auto position = size_t{0};
+  while (position < text.size()) {
+    const auto line = next_line(text, position);
+    if (line.empty()) continue;
+
+    auto field_begin = size_t{0};
+    for (auto column_id = size_t{0}; column_id < column_count; ++column_id) {
+      Assert(field_begin <= line.size(), "load_table: Row has fewer fields than there are columns");
+      const auto field_end = std::min(line.find(delimiter, field_begin), line.size());
+      fields[column_id].push_back(line.substr(field_begin, field_end - field_begin));
+      field_begin = field_end + 1;
+    }
+    Assert(field_begin > line.size(), "load_table: Row has more fields than there are columns");
+  }
+
+  auto chunk = Chunk{};
+  for (auto column_id = size_t{0}; column_id < column_count; ++column_id) {
+    resolve_data_type(column_types[column_id], [&](auto type) {
+      using Type = typename decltype(type)::type;
+      auto values = std::vector<Type>{};
+      values.reserve(fields[column_id].size());
+      for (const auto field : fields[column_id]) {
+        if constexpr (std::is_same_v<Type, std::string>) {
+          values.emplace_back(field);
+        } else {
+          // Numbers are parsed with std::from_chars, falling back to the rules of type_cast for other notations
+          values.push_back(type_cast<Type>(TypedValue{field}));
+        }
+      }
+
+      const auto value_segment = std::make_shared<ValueSegment<Type>>(std::move(values));
+      if (compress_chunk) {
+        chunk.add_segment(std::make_shared<DictionarySegment<Type>>(value_segment));
+      } else {
+        chunk.add_segment(value_segment);
+      }
+    });
+    fields[column_id] = {};
+  }
+  return chunk;
+}
+
+}  // namespace
+
+std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size, const bool compress_chunks,
+                                  const char delimiter) {
+  Assert(chunk_size > 0, "load_table: Chunk size must be positive");
+  const auto file = MappedFile{file_name};
+  const auto contents = file.contents();
+
+  Assert(!contents.empty(), "load_table: File " + file_name + " has no header");
+
+  auto position = size_t{0};
+  const auto column_names = split_line(next_line(contents, position), delimiter);
+  const auto column_type_views = split_line(next_line(contents, position), delimiter);
+  Assert(column_type_views.size() == column_names.size(), "load_table: Expected one type per column");
+
+  auto table = std::make_shared<Table>(chunk_size);
+  auto column_types = std::vector<std::string>{};
+  for (auto column_id = size_t{0}; column_id < column_names.size(); ++column_id) {
+    column_types.emplace_back(column_type_views[column_id]);
+    table->add_column(std::string{column_names[column_id]}, column_types.back());
   }
 
-  while (std::getline(infile, line)) {
-    std::vector<AllTypeVariant> values = _split<AllTypeVariant>(line, '|');
-    test_table->append(values);
+  // Splits the rows into byte ranges that begin at line starts
+  const auto rows = contents.substr(position);
+  const auto range_count = std::max(size_t{1}, std::min(worker_count() * 4, rows.size() / MIN_BYTES_PER_RANGE));
+  auto range_begins = std::vector<size_t>{0};
+  for (auto range_index = size_t{1}; range_index < range_count; ++range_index) {
+    const auto line_end = rows.find('\n', std::max(range_begins.back(), rows.size() * range_index / range_count));
+    if (line_end == std::string_view::npos) break;
+    if (line_end + 1 > range_begins.back()) range_begins.push_back(line_end + 1);
   }
-  return test_table;
+  range_begins.push_back(rows.size());
+
+  const auto is_row = [&](const size_t line_begin, const size_t line_end) {
+    return line_end > line_begin && !(line_end == line_begin + 1 && rows[line_begin] == '\r');
+  };
+
+  // First pass: counts the rows of each range, so that the first row of each range is known
+  auto range_row_counts = std::vector<size_t>(range_begins.size() - 1);
+  parallel_for(range_row_counts.size(), [&](const size_t range_index) {
+    auto line_begin = range_begins[range_index];
+    while (line_begin < range_begins[range_index + 1]) {
+      const auto line_end = std::min(rows.find('\n', line_begin), rows.size());
+      range_row_counts[range_index] += is_row(line_begin, line_end);
+      line_begin = line_end + 1;
+    }
+  });
+
+  // Second pass: finds the byte offsets at which chunks begin, i.e., of every chunk_size-th row
+  auto range_chunk_begins = std::vector<std::vector<size_t>>(range_row_counts.size());
+  parallel_for(range_row_counts.size(), [&](const size_t range_index) {
+    auto row_index = size_t{0};
+    for (auto previous_range_index = size_t{0}; previous_range_index < range_index; ++previous_range_index) {
+      row_index += range_row_counts[previous_range_index];
+    }
+
+    auto line_begin = range_begins[range_index];
+    while (line_begin < range_begins[range_index + 1]) {
+      const auto line_end = std::min(rows.find('\n', line_begin), rows.size());
+      if (is_row(line_begin, line_end)) {
+        if (row_index % chunk_size == 0) range_chunk_begins[range_index].push_back(line_begin);
+        ++row_index;
+      }
+      line_begin = line_end + 1;
+    }
+  });
+
+  auto chunk_begins = std::vector<size_t>{};
+  for (const auto& begins : range_chunk_begins) chunk_begins.insert(chunk_begins.end(), begins.begin(), begins.end());
+  if (chunk_begins.empty()) return table;
+  chunk_begins.push_back(rows.size());
+
+  // Third pass: parses the chunks
+  auto chunks = std::vector<Chunk>(chunk_begins.size() - 1);
+  parallel_for(chunks.size(), [&](const size_t chunk_index) {
+    const auto begin = chunk_begins[chunk_index];
+    const auto text = rows.substr(begin, chunk_begins[chunk_index + 1] - begin);
+    chunks[chunk_index] = parse_chunk(text, column_types, delimiter, compress_chunks);
+  });
+  for (auto& chunk : chunks) table->emplace_chunk(std::move(chunk));
+
+  return table;
 }
 
 }  // namespace opossum
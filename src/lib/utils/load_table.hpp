@@ -22,7 +22,16 @@ std::vector<T> _split(const std::string& str, char delimiter) {
   return internal;
 }
 
+// Loads a .tbl file, i.e., a line of column names, a line of column types (e.g., "int") and one line per row, with the
+// fields separated by delimiter. The file is memory-mapped and split into byte ranges at line boundaries, which are
+// parsed by several threads. Each thread parses the rows of whole chunks directly into typed vectors, which become the
+// ValueSegments of the chunk, or DictionarySegments if compress_chunks is set. The rows are cut into chunks of
+// chunk_size rows, except for the last chunk, which holds the remaining rows. The chunks are added as immutable chunks
+// (see Table::emplace_chunk), so unlike the chunks that rows are appended to, they do not start small and are not
+// limited to Table::MAX_MUTABLE_CHUNK_SIZE rows. Each row has to have exactly one field per column.
+//
 // This is a helper method which is heavily used in our test suite
-std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size);
+std::shared_ptr<Table> load_table(const std::string& file_name, size_t chunk_size, const bool compress_chunks = false,
+                                  const char delimiter = '|');
 
 }  // namespace opossum
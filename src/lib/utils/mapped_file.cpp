@@ -0,0 +1,35 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <string>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+MappedFile::MappedFile(const std::string& file_name) {
+  const auto file_descriptor = ::open(file_name.c_str(), O_RDONLY);
+  Assert(file_descriptor >= 0, "Could not find file " + file_name);
+
+  struct stat file_status {};
+  const auto stat_result = ::fstat(file_descriptor, &file_status);
+  _size = static_cast<size_t>(file_status.st_size);
+  if (stat_result == 0 && _size > 0) {
+    _data = ::mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    if (_data != MAP_FAILED) ::madvise(_data, _size, MADV_SEQUENTIAL);
+  }
+  ::close(file_descriptor);
+  Assert(stat_result == 0 && _data != MAP_FAILED, "Could not map file " + file_name);
+}
+
+MappedFile::~MappedFile() {
+  if (_data) ::munmap(_data, _size);
+}
+
+std::string_view MappedFile::contents() const { return {static_cast<const char*>(_data), _data ? _size : 0}; }
+
+}  // namespace opossum
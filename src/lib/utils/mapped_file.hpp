@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "types.hpp"
+
+namespace opossum {
+
+// A read-only memory mapping of a whole file, which is unmapped when the MappedFile is destroyed. Data structures that
+// point into the mapping keep a std::shared_ptr<const MappedFile> to it.
+class MappedFile : private Noncopyable {
+ public:
+  explicit MappedFile(const std::string& file_name);
+
+  ~MappedFile();
+
+  std::string_view contents() const;
+
+ protected:
+  void* _data = nullptr;
+  size_t _size = 0;
+};
+
+}  // namespace opossum
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "query_arena.hpp"
+
+namespace opossum {
+
+// Returns the number of threads that operators should use for parallel work
+inline size_t worker_count() { return std::max(size_t{1}, static_cast<size_t>(std::thread::hardware_concurrency())); }
+
+// Calls func(task_index) for every task index in [0, task_count). The tasks are distributed dynamically over up to
+// worker_count() threads, so that tasks of varying cost (e.g., chunks of different sizes) are balanced. The first
+// exception thrown by a task is rethrown in the calling thread once all threads have finished. The tasks allocate
+// from the memory resource of the calling thread (see MemoryResourceScope).
+template <typename Functor>
+void parallel_for(const size_t task_count, const Functor& func) {
+  const auto thread_count = std::min(task_count, worker_count());
+  if (thread_count <= 1) {
+    for (auto task_index = size_t{0}; task_index < task_count; ++task_index) func(task_index);
+    return;
+  }
+
+  auto next_task_index = std::atomic<size_t>{0};
+  auto exceptions = std::vector<std::exception_ptr>(thread_count);
+
+  const auto memory_resource = current_memory_resource();
+  auto threads = std::vector<std::thread>{};
+  threads.reserve(thread_count);
+  for (auto thread_index = size_t{0}; thread_index < thread_count; ++thread_index) {
+    threads.emplace_back([&, thread_index]() {
+      const auto memory_resource_scope = MemoryResourceScope{memory_resource};
+      try {
+        for (auto task_index = next_task_index++; task_index < task_count; task_index = next_task_index++) {
+          func(task_index);
+        }
+      } catch (...) {
+        exceptions[thread_index] = std::current_exception();
+        next_task_index = task_count;
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  for (const auto& exception : exceptions) {
+    if (exception) std::rethrow_exception(exception);
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,122 @@
+#include "query_arena.hpp"
+
+#include <atomic>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+
+namespace opossum {
+
+namespace {
+
+thread_local std::pmr::memory_resource* current_resource = nullptr;
+
+std::atomic<uint64_t> next_arena_id{1};
+
+}  // namespace
+
+std::pmr::memory_resource* current_memory_resource() { return current_resource ? current_resource : pos_list_pool(); }
+
+std::pmr::memory_resource* pos_list_pool() {
+  // Never destroyed, so that PosLists in static objects can still be freed at exit
+  static auto* const pool = new std::pmr::synchronized_pool_resource{std::pmr::pool_options{0, MAX_POOLED_BLOCK_SIZE}};
+  return pool;
+}
+
+MemoryResourceScope::MemoryResourceScope(std::pmr::memory_resource* memory_resource)
+    : _previous_memory_resource(current_resource) {
+  current_resource = memory_resource;
+}
+
+MemoryResourceScope::~MemoryResourceScope() { current_resource = _previous_memory_resource; }
+
+// The memory of a QueryArena. The arena and every allocation hold a reference to it, so that it is only freed once
+// the arena was destroyed and all results allocated from it were.
+class QueryArena::Resource : public std::pmr::memory_resource {
+ public:
+  explicit Resource(const size_t initial_size) : _initial_size(initial_size) {}
+
+  void release_reference() {
+    if (_references.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+  }
+
+  size_t allocated_bytes() const {
+    const auto lock = std::lock_guard{_mutex};
+    auto bytes = size_t{0};
+    for (const auto& [thread_id, thread_buffer] : _thread_buffers) bytes += thread_buffer->allocated_bytes;
+    return bytes;
+  }
+
+  size_t used_bytes() const {
+    const auto lock = std::lock_guard{_mutex};
+    auto bytes = size_t{0};
+    for (const auto& [thread_id, thread_buffer] : _thread_buffers) {
+      bytes += thread_buffer->allocated_bytes - thread_buffer->deallocated_bytes;
+    }
+    return bytes;
+  }
+
+ protected:
+  // The blocks and byte counts of one thread. Only that thread allocates from the blocks and updates the counts, so
+  // neither needs a lock. Deallocations are counted by the thread that deallocates.
+  struct alignas(64) ThreadBuffer {
+    explicit ThreadBuffer(const size_t initial_size) : blocks(initial_size) {}
+
+    std::pmr::monotonic_buffer_resource blocks;
+    std::atomic<size_t> allocated_bytes{0};
+    std::atomic<size_t> deallocated_bytes{0};
+  };
+
+  ThreadBuffer& _thread_buffer() {
+    // Caches the buffer of the arena that the thread used last, which is usually the only one
+    thread_local auto cached_arena_id = uint64_t{0};
+    thread_local auto* cached_thread_buffer = static_cast<ThreadBuffer*>(nullptr);
+    if (cached_arena_id == _id) return *cached_thread_buffer;
+
+    const auto lock = std::lock_guard{_mutex};
+    auto& thread_buffer = _thread_buffers[std::this_thread::get_id()];
+    if (!thread_buffer) thread_buffer = std::make_unique<ThreadBuffer>(_initial_size);
+    cached_arena_id = _id;
+    cached_thread_buffer = thread_buffer.get();
+    return *thread_buffer;
+  }
+
+  void* do_allocate(const size_t bytes, const size_t alignment) override {
+    _references.fetch_add(1, std::memory_order_relaxed);
+    auto& thread_buffer = _thread_buffer();
+    thread_buffer.allocated_bytes.store(thread_buffer.allocated_bytes.load(std::memory_order_relaxed) + bytes,
+                                        std::memory_order_relaxed);
+    return thread_buffer.blocks.allocate(bytes, alignment);
+  }
+
+  void do_deallocate(void* /*pointer*/, const size_t bytes, const size_t /*alignment*/) override {
+    auto& thread_buffer = _thread_buffer();
+    thread_buffer.deallocated_bytes.store(thread_buffer.deallocated_bytes.load(std::memory_order_relaxed) + bytes,
+                                          std::memory_order_relaxed);
+    release_reference();
+  }
+
+  bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override { return this == &other; }
+
+  const size_t _initial_size;
+  // Arenas are identified by an id in the caches of the threads, since one can be allocated where another was freed
+  const uint64_t _id = next_arena_id++;
+  std::atomic<size_t> _references{1};
+  // Protects _thread_buffers
+  mutable std::mutex _mutex;
+  std::map<std::thread::id, std::unique_ptr<ThreadBuffer>> _thread_buffers;
+};
+
+QueryArena::QueryArena(const size_t initial_size) : _resource(new Resource{initial_size}) {}
+
+QueryArena::~QueryArena() { _resource->release_reference(); }
+
+std::pmr::memory_resource* QueryArena::resource() const { return _resource; }
+
+size_t QueryArena::allocated_bytes() const { return _resource->allocated_bytes(); }
+
+size_t QueryArena::used_bytes() const { return _resource->used_bytes(); }
+
+}  // namespace opossum
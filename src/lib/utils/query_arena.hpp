@@ -0,0 +1,79 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace opossum {
+
+// Returns the memory resource that intermediate results such as PosLists are allocated from on the calling thread: the
+// resource of the innermost MemoryResourceScope (e.g., a QueryArena), or the PosList pool otherwise
+std::pmr::memory_resource* current_memory_resource();
+
+// A process-wide pool that keeps freed buffers of up to MAX_POOLED_BLOCK_SIZE bytes per size class and hands them out
+// again, so that the PosLists that operators create and drop for every chunk do not go through malloc and, for
+// chunk-sized lists, mmap and page faults each time. Thread-safe. The pool never returns memory to the system and is
+// never destroyed, so it holds as much memory as the pooled PosLists that were alive at the same time took at peak.
+// Larger buffers are allocated and freed directly.
+std::pmr::memory_resource* pos_list_pool();
+
+// Large enough for a PosList of Table::MAX_MUTABLE_CHUNK_SIZE rows
+constexpr auto MAX_POOLED_BLOCK_SIZE = size_t{1} << 20;
+
+// Makes a memory resource the current one of this thread (see current_memory_resource) while the scope exists.
+// parallel_for passes the current resource on to its worker threads.
+class MemoryResourceScope {
+ public:
+  explicit MemoryResourceScope(std::pmr::memory_resource* memory_resource);
+  ~MemoryResourceScope();
+
+  MemoryResourceScope(const MemoryResourceScope&) = delete;
+  MemoryResourceScope& operator=(const MemoryResourceScope&) = delete;
+
+ protected:
+  std::pmr::memory_resource* const _previous_memory_resource;
+};
+
+/**
+ * A monotonic arena for the intermediate results of one query. Allocations only bump a pointer into the current
+ * block, deallocations are only counted, and all memory is released at once. Each thread allocates from its own
+ * blocks, so the threads of a query (e.g., the workers of parallel_for) do not contend for the arena. As the buffer of
+ * a growing PosList is only released with the arena, PosLists should be reserved up front. The operators of a query
+ * are executed in a MemoryResourceScope of the arena, e.g.:
+ *
+ *   auto arena = QueryArena{};
+ *   {
+ *     const auto scope = MemoryResourceScope{arena.resource()};
+ *     scan->execute();
+ *     ...
+ *   }
+ *
+ * The memory is released once the arena is destroyed and all results that were allocated from it (i.e., the outputs
+ * of the operators executed in its scope) are, so results can safely outlive the arena. Results that outlive the
+ * query, e.g., a table that is added to the StorageManager, would keep all memory of the arena alive, so their
+ * ReferenceSegments are materialized first (see Materialize).
+ */
+class QueryArena {
+ public:
+  explicit QueryArena(const size_t initial_size = size_t{1} << 16);
+
+  QueryArena(const QueryArena&) = delete;
+  QueryArena& operator=(const QueryArena&) = delete;
+
+  ~QueryArena();
+
+  // The memory resource that results are allocated from. It stays valid for as long as memory allocated from it is.
+  std::pmr::memory_resource* resource() const;
+
+  // The number of bytes handed out so far
+  size_t allocated_bytes() const;
+
+  // The number of bytes that were handed out and not deallocated yet, i.e., that results still use
+  size_t used_bytes() const;
+
+ protected:
+  class Resource;
+
+  Resource* const _resource;
+};
+
+}  // namespace opossum
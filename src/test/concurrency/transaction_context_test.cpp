@@ -0,0 +1,125 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class TransactionContextTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(100, UseMvcc::Yes);
+    _table->add_column("a", "int");
+    _table->append({1});
+    _table->append({2});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<const Table> visible_rows(const std::shared_ptr<const TransactionContext>& transaction_context,
+                                            const int32_t value) {
+    auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpEquals, value);
+    scan->execute();
+    auto validate = std::make_shared<Validate>(scan, transaction_context);
+    validate->execute();
+    return validate->get_output();
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(TransactionContextTest, DetectsWriteWriteConflicts) {
+  const auto first = TransactionManager::get().new_transaction_context();
+  const auto second = TransactionManager::get().new_transaction_context();
+  EXPECT_TRUE(first->delete_rows(visible_rows(first, 1)));
+  EXPECT_FALSE(second->delete_rows(visible_rows(second, 1)));
+  EXPECT_EQ(second->phase(), TransactionPhase::Conflicted);
+  EXPECT_THROW(second->commit(), std::logic_error);
+  second->rollback();
+
+  // Rolling back unlocks the rows
+  first->rollback();
+  const auto third = TransactionManager::get().new_transaction_context();
+  EXPECT_TRUE(third->delete_rows(visible_rows(third, 1)));
+  third->commit();
+  EXPECT_EQ(third->phase(), TransactionPhase::Committed);
+  EXPECT_EQ(visible_rows(TransactionManager::get().new_transaction_context(), 1)->row_count(), 0u);
+}
+
+TEST_F(TransactionContextTest, ConflictsWithDeletesAfterSnapshot) {
+  const auto reader = TransactionManager::get().new_transaction_context();
+  const auto rows = visible_rows(reader, 2);
+
+  const auto deleter = TransactionManager::get().new_transaction_context();
+  EXPECT_TRUE(deleter->delete_rows(visible_rows(deleter, 2)));
+  deleter->commit();
+
+  EXPECT_FALSE(reader->delete_rows(rows));
+}
+
+TEST_F(TransactionContextTest, RollbackHidesInserts) {
+  {
+    const auto writer = TransactionManager::get().new_transaction_context();
+    writer->insert(_table, {std::vector<int32_t>{3, 3}});
+    EXPECT_EQ(visible_rows(writer, 3)->row_count(), 2u);
+    // Destroying an active transaction rolls it back
+  }
+  const auto reader = TransactionManager::get().new_transaction_context();
+  EXPECT_EQ(visible_rows(reader, 3)->row_count(), 0u);
+  EXPECT_EQ(_table->row_count(), 4u);
+  EXPECT_EQ(_table->approx_valid_row_count(), 2u);
+}
+
+TEST_F(TransactionContextTest, ScansDoNotSeePartialBatches) {
+  // Writers commit batches of BATCH_SIZE rows while readers scan, which must see whole batches only
+  constexpr auto WRITER_COUNT = 4;
+  constexpr auto BATCH_COUNT = 50;
+  constexpr auto BATCH_SIZE = 64;
+  auto done = std::atomic<bool>{false};
+
+  auto writers = std::vector<std::thread>{};
+  for (auto writer_index = 0; writer_index < WRITER_COUNT; ++writer_index) {
+    writers.emplace_back([&]() {
+      const auto values = std::vector<int32_t>(BATCH_SIZE, 5);
+      for (auto batch_index = 0; batch_index < BATCH_COUNT; ++batch_index) {
+        const auto transaction_context = TransactionManager::get().new_transaction_context();
+        for (auto row = 0; row < BATCH_SIZE; row += 8) {
+          transaction_context->insert(_table, {std::span<const int32_t>{values}.subspan(row, 8)});
+        }
+        transaction_context->commit();
+      }
+    });
+  }
+
+  auto scan_count = 0;
+  auto reader = std::thread{[&]() {
+    while (!done) {
+      const auto row_count = visible_rows(TransactionManager::get().new_transaction_context(), 5)->row_count();
+      ASSERT_EQ(row_count % BATCH_SIZE, 0u);
+      ++scan_count;
+    }
+  }};
+
+  for (auto& writer : writers) writer.join();
+  done = true;
+  reader.join();
+
+  EXPECT_GT(scan_count, 0);
+  EXPECT_EQ(visible_rows(TransactionManager::get().new_transaction_context(), 5)->row_count(),
+            WRITER_COUNT * BATCH_COUNT * BATCH_SIZE);
+}
+
+}  // namespace opossum
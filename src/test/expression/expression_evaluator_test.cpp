@@ -0,0 +1,156 @@
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "expression/expression_evaluator.hpp"
+#include "expression/expressions.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class ExpressionEvaluatorTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(3);
+    _table->add_column("a", "int");
+    _table->add_column("b", "long");
+    _table->add_column("price", "double");
+    _table->add_column("discount", "float");
+    _table->add_column("s", "string");
+    _table->append({1, int64_t{10}, 100.0, 0.5f, "x"});
+    _table->append({2, int64_t{20}, 200.0, 0.25f, "y"});
+    _table->append({3, int64_t{30}, 300.0, 0.0f, "z"});
+    _table->append({4, int64_t{40}, 400.0, 0.5f, "x"});
+    _table->compress_chunk(ChunkID{0});
+  }
+
+  template <typename T>
+  std::vector<T> evaluate(const std::shared_ptr<const Table>& table, const AbstractExpression& expression) {
+    auto values = std::vector<T>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+      auto evaluator = ExpressionEvaluator{table, chunk_id};
+      const auto segment = std::dynamic_pointer_cast<ValueSegment<T>>(evaluator.evaluate_to_segment(expression));
+      EXPECT_TRUE(segment);
+      if (!segment) return values;
+      values.insert(values.end(), segment->values().begin(), segment->values().end());
+    }
+    return values;
+  }
+
+  static std::shared_ptr<AbstractExpression> column(const ColumnID column_id) {
+    return std::make_shared<ColumnExpression>(column_id);
+  }
+
+  static std::shared_ptr<AbstractExpression> value(const AllTypeVariant& value) {
+    return std::make_shared<ValueExpression>(value);
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(ExpressionEvaluatorTest, Arithmetic) {
+  // price * (1 - discount)
+  const auto expression = ArithmeticExpression{
+      ArithmeticOperator::Multiplication, column(ColumnID{2}),
+      std::make_shared<ArithmeticExpression>(ArithmeticOperator::Subtraction, value(1), column(ColumnID{3}))};
+  EXPECT_EQ(expression.data_type(*_table), "double");
+  EXPECT_EQ(expression.description(*_table), "price * (1 - discount)");
+  EXPECT_EQ(evaluate<double>(_table, expression), (std::vector<double>{50.0, 150.0, 300.0, 200.0}));
+
+  const auto integer_expression = ArithmeticExpression{ArithmeticOperator::Division, column(ColumnID{1}),
+                                                       column(ColumnID{0})};
+  EXPECT_EQ(integer_expression.data_type(*_table), "long");
+  EXPECT_EQ(evaluate<int64_t>(_table, integer_expression), (std::vector<int64_t>{10, 10, 10, 10}));
+}
+
+TEST_F(ExpressionEvaluatorTest, Comparison) {
+  const auto expression = ComparisonExpression{ScanType::OpGreaterThanEquals, column(ColumnID{2}), value(200)};
+  EXPECT_EQ(expression.data_type(*_table), "int");
+  EXPECT_EQ(evaluate<int32_t>(_table, expression), (std::vector<int32_t>{0, 1, 1, 1}));
+
+  const auto string_expression = ComparisonExpression{ScanType::OpEquals, column(ColumnID{4}), value("x")};
+  EXPECT_EQ(string_expression.description(*_table), "s = 'x'");
+  EXPECT_EQ(evaluate<int32_t>(_table, string_expression), (std::vector<int32_t>{1, 0, 0, 1}));
+}
+
+TEST_F(ExpressionEvaluatorTest, Case) {
+  // CASE WHEN a < 2 THEN 'small' WHEN a < 4 THEN 'medium' ELSE 'large' END
+  const auto expression = CaseExpression{
+      std::make_shared<ComparisonExpression>(ScanType::OpLessThan, column(ColumnID{0}), value(2)), value("small"),
+      std::make_shared<CaseExpression>(
+          std::make_shared<ComparisonExpression>(ScanType::OpLessThan, column(ColumnID{0}), value(4)), value("medium"),
+          value("large"))};
+  EXPECT_EQ(expression.data_type(*_table), "string");
+  EXPECT_EQ(evaluate<std::string>(_table, expression),
+            (std::vector<std::string>{"small", "medium", "medium", "large"}));
+
+  const auto numeric_expression = CaseExpression{column(ColumnID{3}), column(ColumnID{0}), value(2.5)};
+  EXPECT_EQ(numeric_expression.data_type(*_table), "double");
+  EXPECT_EQ(evaluate<double>(_table, numeric_expression), (std::vector<double>{1.0, 2.0, 2.5, 4.0}));
+}
+
+TEST_F(ExpressionEvaluatorTest, CaseGuardsDivision) {
+  auto table = std::make_shared<Table>(10);
+  table->add_column("a", "int");
+  table->add_column("b", "int");
+  table->append({7, 2});
+  table->append({5, 0});
+  table->append({std::numeric_limits<int32_t>::min(), -1});
+  table->append({-9, 3});
+
+  // CASE WHEN b <> 0 THEN a / b ELSE 0 END
+  const auto expression = CaseExpression{
+      std::make_shared<ComparisonExpression>(ScanType::OpNotEquals, column(ColumnID{1}), value(0)),
+      std::make_shared<ArithmeticExpression>(ArithmeticOperator::Division, column(ColumnID{0}), column(ColumnID{1})),
+      value(0)};
+  EXPECT_EQ(evaluate<int32_t>(table, expression),
+            (std::vector<int32_t>{3, 0, std::numeric_limits<int32_t>::min(), -3}));
+
+  // Only the divisors of the rows that the branch is taken for have to be non-zero
+  const auto unguarded_expression = CaseExpression{
+      std::make_shared<ComparisonExpression>(ScanType::OpGreaterThan, column(ColumnID{0}), value(0)),
+      std::make_shared<ArithmeticExpression>(ArithmeticOperator::Division, column(ColumnID{0}), column(ColumnID{1})),
+      value(0)};
+  auto evaluator = ExpressionEvaluator{table, ChunkID{0}};
+  EXPECT_THROW(evaluator.evaluate_to_segment(unguarded_expression), std::logic_error);
+}
+
+TEST_F(ExpressionEvaluatorTest, ManyBatchesAndReferences) {
+  auto table = std::make_shared<Table>(5000);
+  table->add_column("a", "int");
+  for (auto row = 0; row < 12'000; ++row) table->append({row % 100});
+  table->compress_chunk(ChunkID{1});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 50);
+  scan->execute();
+
+  const auto expression =
+      ArithmeticExpression{ArithmeticOperator::Addition, column(ColumnID{0}), column(ColumnID{0})};
+  const auto values = evaluate<int32_t>(scan->get_output(), expression);
+  ASSERT_EQ(values.size(), 6000u);
+  for (auto row = size_t{0}; row < values.size(); ++row) EXPECT_EQ(values[row], 2 * (50 + static_cast<int>(row % 50)));
+}
+
+TEST_F(ExpressionEvaluatorTest, InvalidExpressions) {
+  const auto string_arithmetic = ArithmeticExpression{ArithmeticOperator::Addition, column(ColumnID{4}), value(1)};
+  EXPECT_THROW(string_arithmetic.data_type(*_table), std::logic_error);
+
+  const auto mixed_comparison = ComparisonExpression{ScanType::OpEquals, column(ColumnID{4}), value(1)};
+  EXPECT_THROW(mixed_comparison.data_type(*_table), std::logic_error);
+
+  const auto division_by_zero = ArithmeticExpression{ArithmeticOperator::Division, column(ColumnID{0}), value(0)};
+  auto evaluator = ExpressionEvaluator{_table, ChunkID{0}};
+  EXPECT_THROW(evaluator.evaluate_to_segment(division_by_zero), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,103 @@
+#include <array>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "type_cast.hpp"
+#include "typed_value.hpp"
+
+namespace opossum {
+
+class TypedValueTest : public BaseTest {};
+
+TEST_F(TypedValueTest, StoresValues) {
+  EXPECT_EQ(TypedValue{17}.get<int32_t>(), 17);
+  EXPECT_EQ(TypedValue{int64_t{1} << 40}.get<int64_t>(), int64_t{1} << 40);
+  EXPECT_EQ(TypedValue{2.5f}.get<float>(), 2.5f);
+  EXPECT_EQ(TypedValue{-0.25}.get<double>(), -0.25);
+
+  const auto string = std::string{"reallyreallylongstringthatcantbestoredusingsso"};
+  const auto value = TypedValue{string};
+  EXPECT_TRUE(value.is_string());
+  EXPECT_EQ(value.get<std::string>(), string);
+  EXPECT_EQ(value.get<std::string>().data(), string.data());
+  EXPECT_EQ(TypedValue{}, TypedValue{0});
+}
+
+TEST_F(TypedValueTest, ConvertsFromAndToVariant) {
+  for (const auto& variant : {AllTypeVariant{3}, AllTypeVariant{int64_t{4}}, AllTypeVariant{1.5f},
+                              AllTypeVariant{2.5}, AllTypeVariant{"text"}}) {
+    const auto value = TypedValue{variant};
+    EXPECT_EQ(value.which(), static_cast<size_t>(variant.which()));
+    EXPECT_EQ(value.to_variant(), variant);
+  }
+
+  // Strings of the variant are referenced rather than copied
+  const auto variant = AllTypeVariant{"text"};
+  EXPECT_EQ(TypedValue{variant}.get<std::string>().data(), boost::get<std::string>(variant).data());
+}
+
+TEST_F(TypedValueTest, Comparison) {
+  EXPECT_EQ(TypedValue{"abc"}, TypedValue{std::string{"abc"}});
+  EXPECT_NE(TypedValue{"abc"}, TypedValue{"abd"});
+  EXPECT_NE(TypedValue{1}, TypedValue{int64_t{1}});
+  EXPECT_NE(TypedValue{1}, TypedValue{2});
+}
+
+TEST_F(TypedValueTest, TypeCast) {
+  EXPECT_EQ(type_cast<int64_t>(TypedValue{7}), 7);
+  EXPECT_EQ(type_cast<int32_t>(TypedValue{7.9}), 7);
+  EXPECT_EQ(type_cast<double>(TypedValue{int64_t{5}}), 5.0);
+  EXPECT_EQ(type_cast<float>(TypedValue{"2.5"}), 2.5f);
+  EXPECT_EQ(type_cast<int32_t>(TypedValue{"42"}), 42);
+  EXPECT_EQ(type_cast<int32_t>(TypedValue{"4.5"}), 4);
+  EXPECT_EQ(type_cast<std::string>(TypedValue{"text"}), "text");
+  EXPECT_EQ(type_cast<std::string>(TypedValue{12}), "12");
+  EXPECT_THROW(type_cast<int32_t>(TypedValue{int64_t{1} << 40}), std::exception);
+  EXPECT_THROW(type_cast<int32_t>(TypedValue{"text"}), std::exception);
+
+  // The same conversions for AllTypeVariant, which no longer go through strings for numbers
+  EXPECT_EQ(type_cast<int32_t>(AllTypeVariant{7.9}), 7);
+  EXPECT_EQ(type_cast<float>(AllTypeVariant{int64_t{3}}), 3.0f);
+  EXPECT_EQ(type_cast<int64_t>(AllTypeVariant{"-12"}), -12);
+  EXPECT_EQ(type_cast<int32_t>(AllTypeVariant{"4.5"}), 4);
+  EXPECT_THROW(type_cast<int32_t>(AllTypeVariant{int64_t{1} << 40}), std::exception);
+  EXPECT_THROW(type_cast<double>(AllTypeVariant{"text"}), std::exception);
+}
+
+TEST_F(TypedValueTest, AppendAndAccessSegments) {
+  auto table = std::make_shared<Table>(2);
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+  const auto strings = std::vector<std::string>{"x", "y", "z"};
+  for (auto index = size_t{0}; index < strings.size(); ++index) {
+    table->append(std::array<TypedValue, 2>{TypedValue{static_cast<int32_t>(index)}, TypedValue{strings[index]}});
+  }
+  table->append({3, "w"});
+  ASSERT_EQ(table->row_count(), 4u);
+  EXPECT_EQ(table->chunk_count(), 2u);
+
+  const auto value_segment = table->get_chunk(ChunkID{0}).get_segment(ColumnID{1});
+  EXPECT_EQ(value_segment->typed_value(1), TypedValue{"y"});
+  table->compress_chunk(ChunkID{1});
+  const auto dictionary_segment = table->get_chunk(ChunkID{1}).get_segment(ColumnID{1});
+  EXPECT_EQ(dictionary_segment->typed_value(1), TypedValue{"w"});
+  EXPECT_THROW(dictionary_segment->append(TypedValue{"v"}), std::logic_error);
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, TypedValue{1});
+  scan->execute();
+  const auto reference_segment = scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{1});
+  EXPECT_EQ(reference_segment->typed_value(0), TypedValue{"z"});
+  EXPECT_EQ(scan->get_output()->row_count(), 2u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,161 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/aggregate.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsAggregateTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(4);
+    _table->add_column("country", "string");
+    _table->add_column("status", "int");
+    _table->add_column("amount", "int");
+    _table->add_column("price", "float");
+    _table->append({"DE", 1, 10, 1.5f});
+    _table->append({"US", 2, 20, 2.5f});
+    _table->append({"DE", 1, 30, 3.5f});
+    _table->append({"FR", 2, 40, 4.5f});
+    _table->append({"US", 2, 50, 5.5f});
+    _table->append({"DE", 2, 60, 6.5f});
+    _table->append({"FR", 2, 70, 7.5f});
+    _table->append({"US", 1, 80, 8.5f});
+    _table->append({"DE", 1, 90, 9.5f});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  void compress_table() {
+    for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) _table->compress_chunk(chunk_id);
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsAggregateTest, SingleGroupByColumn) {
+  auto expected = std::make_shared<Table>();
+  expected->add_column("country", "string");
+  expected->add_column("SUM(amount)", "long");
+  expected->add_column("COUNT(amount)", "long");
+  expected->add_column("MAX(price)", "float");
+  expected->append({"DE", int64_t{190}, int64_t{4}, 9.5f});
+  expected->append({"FR", int64_t{110}, int64_t{2}, 7.5f});
+  expected->append({"US", int64_t{150}, int64_t{3}, 8.5f});
+
+  const auto aggregates =
+      std::vector<AggregateColumnDefinition>{{ColumnID{2}, AggregateFunction::Sum},
+                                             {ColumnID{2}, AggregateFunction::Count},
+                                             {ColumnID{3}, AggregateFunction::Max}};
+
+  auto aggregate = std::make_shared<Aggregate>(_table_wrapper, std::vector<ColumnID>{ColumnID{0}}, aggregates);
+  aggregate->execute();
+  EXPECT_TABLE_EQ(aggregate->get_output(), expected);
+
+  compress_table();
+  auto dictionary_aggregate =
+      std::make_shared<Aggregate>(_table_wrapper, std::vector<ColumnID>{ColumnID{0}}, aggregates);
+  dictionary_aggregate->execute();
+  EXPECT_TABLE_EQ(dictionary_aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateTest, MultipleGroupByColumns) {
+  auto expected = std::make_shared<Table>();
+  expected->add_column("country", "string");
+  expected->add_column("status", "int");
+  expected->add_column("MIN(amount)", "int");
+  expected->add_column("AVG(price)", "double");
+  expected->append({"DE", 1, 10, 14.5 / 3});
+  expected->append({"DE", 2, 60, 6.5});
+  expected->append({"FR", 2, 40, 6.0});
+  expected->append({"US", 1, 80, 8.5});
+  expected->append({"US", 2, 20, 4.0});
+
+  const auto group_by_column_ids = std::vector<ColumnID>{ColumnID{0}, ColumnID{1}};
+  const auto aggregates = std::vector<AggregateColumnDefinition>{{ColumnID{2}, AggregateFunction::Min},
+                                                                 {ColumnID{3}, AggregateFunction::Avg}};
+
+  // Only the first chunk is dictionary-encoded, so both grouping strategies contribute to the same groups
+  _table->compress_chunk(ChunkID{0});
+  auto aggregate = std::make_shared<Aggregate>(_table_wrapper, group_by_column_ids, aggregates);
+  aggregate->execute();
+  EXPECT_TABLE_EQ(aggregate->get_output(), expected);
+
+  compress_table();
+  auto dictionary_aggregate = std::make_shared<Aggregate>(_table_wrapper, group_by_column_ids, aggregates);
+  dictionary_aggregate->execute();
+  EXPECT_TABLE_EQ(dictionary_aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateTest, GlobalDictionaries) {
+  auto expected = std::make_shared<Table>();
+  expected->add_column("country", "string");
+  expected->add_column("status", "int");
+  expected->add_column("MIN(amount)", "int");
+  expected->append({"DE", 1, 10});
+  expected->append({"US", 2, 20});
+  expected->append({"FR", 2, 40});
+  expected->append({"DE", 2, 60});
+  expected->append({"US", 1, 80});
+
+  compress_table();
+  _table->use_global_dictionary(ColumnID{0});
+  _table->use_global_dictionary(ColumnID{1});
+
+  auto aggregate = std::make_shared<Aggregate>(_table_wrapper, std::vector<ColumnID>{ColumnID{0}, ColumnID{1}},
+                                               std::vector<AggregateColumnDefinition>{
+                                                   {ColumnID{2}, AggregateFunction::Min}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ(aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateTest, ReferencedInput) {
+  compress_table();
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{2}, ScanType::OpGreaterThan, 30);
+  scan->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("status", "int");
+  expected->add_column("COUNT(country)", "long");
+  expected->append({1, int64_t{2}});
+  expected->append({2, int64_t{4}});
+
+  auto aggregate = std::make_shared<Aggregate>(scan, std::vector<ColumnID>{ColumnID{1}},
+                                               std::vector<AggregateColumnDefinition>{
+                                                   {ColumnID{0}, AggregateFunction::Count}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ(aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateTest, NoGroupByColumns) {
+  compress_table();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("SUM(price)", "double");
+  expected->append({49.5});
+
+  auto aggregate = std::make_shared<Aggregate>(
+      _table_wrapper, std::vector<ColumnID>{},
+      std::vector<AggregateColumnDefinition>{{ColumnID{3}, AggregateFunction::Sum}});
+  aggregate->execute();
+  EXPECT_TABLE_EQ(aggregate->get_output(), expected);
+}
+
+TEST_F(OperatorsAggregateTest, SumOnStringColumnFails) {
+  auto aggregate = std::make_shared<Aggregate>(
+      _table_wrapper, std::vector<ColumnID>{ColumnID{1}},
+      std::vector<AggregateColumnDefinition>{{ColumnID{0}, AggregateFunction::Sum}});
+  EXPECT_THROW(aggregate->execute(), std::logic_error);
+}
+
+}  // namespace opossum
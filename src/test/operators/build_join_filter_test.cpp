@@ -0,0 +1,157 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/build_join_filter.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsBuildJoinFilterTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // Build side: customers with their region
+    _customers = std::make_shared<Table>(2);
+    _customers->add_column("c_key", "int");
+    _customers->add_column("c_region", "string");
+    _customers->append({1, "EUROPE"});
+    _customers->append({2, "ASIA"});
+    _customers->append({3, "EUROPE"});
+    _customers->append({4, "AMERICA"});
+    _customers->append({7, "EUROPE"});
+
+    // Probe side: orders referencing customers
+    _orders = std::make_shared<Table>(3);
+    _orders->add_column("o_key", "long");
+    _orders->add_column("o_c_key", "long");
+    _orders->add_column("o_c_region", "string");
+    _orders->append({int64_t{10}, int64_t{1}, "EUROPE"});
+    _orders->append({int64_t{11}, int64_t{2}, "ASIA"});
+    _orders->append({int64_t{12}, int64_t{3}, "EUROPE"});
+    _orders->append({int64_t{13}, int64_t{7}, "EUROPE"});
+    _orders->append({int64_t{14}, int64_t{4}, "AMERICA"});
+    _orders->append({int64_t{15}, int64_t{9}, "AFRICA"});
+    _orders->append({int64_t{16}, int64_t{1}, "EUROPE"});
+
+    _customers_wrapper = std::make_shared<TableWrapper>(_customers);
+    _customers_wrapper->execute();
+    _orders_wrapper = std::make_shared<TableWrapper>(_orders);
+    _orders_wrapper->execute();
+  }
+
+  std::shared_ptr<BuildJoinFilter> build_european_customers_filter(const ColumnID column_id) {
+    auto customers = std::make_shared<TableScan>(_customers_wrapper, ColumnID{1}, ScanType::OpEquals, "EUROPE");
+    customers->execute();
+    auto build_join_filter = std::make_shared<BuildJoinFilter>(customers, column_id);
+    build_join_filter->execute();
+    return build_join_filter;
+  }
+
+  std::shared_ptr<Table> _customers;
+  std::shared_ptr<Table> _orders;
+  std::shared_ptr<TableWrapper> _customers_wrapper;
+  std::shared_ptr<TableWrapper> _orders_wrapper;
+};
+
+TEST_F(OperatorsBuildJoinFilterTest, ForwardsInput) {
+  auto build_join_filter = std::make_shared<BuildJoinFilter>(_customers_wrapper, ColumnID{0});
+  EXPECT_FALSE(build_join_filter->join_filter()->is_built());
+  build_join_filter->execute();
+
+  EXPECT_EQ(build_join_filter->get_output(), _customers);
+  EXPECT_TRUE(build_join_filter->join_filter()->is_built());
+  EXPECT_EQ(build_join_filter->join_filter()->key_count(), 5u);
+}
+
+TEST_F(OperatorsBuildJoinFilterTest, MayContain) {
+  _customers->compress_chunk(ChunkID{0});
+  const auto join_filter = build_european_customers_filter(ColumnID{0})->join_filter();
+
+  EXPECT_EQ(join_filter->key_count(), 3u);
+  EXPECT_FALSE(join_filter->is_string_filter());
+  for (const auto key : {1, 3, 7}) {
+    EXPECT_TRUE(join_filter->may_contain(key));
+    EXPECT_TRUE(join_filter->may_contain(int64_t{key}));
+    EXPECT_TRUE(join_filter->may_contain(static_cast<double>(key)));
+  }
+  // Outside of the range of the keys
+  EXPECT_FALSE(join_filter->may_contain(0));
+  EXPECT_FALSE(join_filter->may_contain(8));
+  EXPECT_FALSE(join_filter->may_contain(7.5f));
+}
+
+TEST_F(OperatorsBuildJoinFilterTest, ProbeScan) {
+  const auto build_join_filter = build_european_customers_filter(ColumnID{0});
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("o_key", "long");
+  expected->add_column("o_c_key", "long");
+  expected->add_column("o_c_region", "string");
+  expected->append({int64_t{10}, int64_t{1}, "EUROPE"});
+  expected->append({int64_t{12}, int64_t{3}, "EUROPE"});
+  expected->append({int64_t{13}, int64_t{7}, "EUROPE"});
+  expected->append({int64_t{16}, int64_t{1}, "EUROPE"});
+
+  auto predicate = ScanPredicate{ColumnID{1}, ScanType::OpJoinFilter, {}};
+  predicate.join_filter = build_join_filter->join_filter();
+  auto scan = std::make_shared<TableScan>(_orders_wrapper, std::vector<ScanPredicate>{predicate});
+  scan->execute();
+  // A Bloom filter may let rows without a join partner pass, but this small set of keys is separated exactly
+  EXPECT_TABLE_EQ(scan->get_output(), expected);
+
+  _orders->compress_chunk(ChunkID{0});
+  _orders->compress_chunk(ChunkID{1});
+  auto dictionary_scan = std::make_shared<TableScan>(
+      _orders_wrapper,
+      std::vector<ScanPredicate>{predicate, {ColumnID{0}, ScanType::OpLessThan, int64_t{16}}});
+  dictionary_scan->execute();
+  EXPECT_EQ(dictionary_scan->get_output()->row_count(), 3u);
+}
+
+TEST_F(OperatorsBuildJoinFilterTest, StringKeys) {
+  const auto build_join_filter = build_european_customers_filter(ColumnID{1});
+  EXPECT_TRUE(build_join_filter->join_filter()->is_string_filter());
+
+  auto predicate = ScanPredicate{ColumnID{2}, ScanType::OpJoinFilter, {}};
+  predicate.join_filter = build_join_filter->join_filter();
+  auto scan = std::make_shared<TableScan>(_orders_wrapper, std::vector<ScanPredicate>{predicate});
+  scan->execute();
+  EXPECT_EQ(scan->get_output()->row_count(), 4u);
+
+  // Strings cannot be probed with numbers
+  auto number_predicate = ScanPredicate{ColumnID{1}, ScanType::OpJoinFilter, {}};
+  number_predicate.join_filter = build_join_filter->join_filter();
+  auto number_scan = std::make_shared<TableScan>(_orders_wrapper, std::vector<ScanPredicate>{number_predicate});
+  EXPECT_THROW(number_scan->execute(), std::logic_error);
+}
+
+TEST_F(OperatorsBuildJoinFilterTest, UnbuiltFilterFails) {
+  auto build_join_filter = std::make_shared<BuildJoinFilter>(_customers_wrapper, ColumnID{0});
+  auto predicate = ScanPredicate{ColumnID{1}, ScanType::OpJoinFilter, {}};
+  predicate.join_filter = build_join_filter->join_filter();
+  auto scan = std::make_shared<TableScan>(_orders_wrapper, std::vector<ScanPredicate>{predicate});
+  EXPECT_THROW(scan->execute(), std::logic_error);
+}
+
+TEST_F(OperatorsBuildJoinFilterTest, EmptyBuildSide) {
+  auto customers = std::make_shared<TableScan>(_customers_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 100);
+  customers->execute();
+  auto build_join_filter = std::make_shared<BuildJoinFilter>(customers, ColumnID{0});
+  build_join_filter->execute();
+  EXPECT_EQ(build_join_filter->join_filter()->key_count(), 0u);
+  EXPECT_FALSE(build_join_filter->join_filter()->may_contain(1));
+
+  auto predicate = ScanPredicate{ColumnID{1}, ScanType::OpJoinFilter, {}};
+  predicate.join_filter = build_join_filter->join_filter();
+  auto scan = std::make_shared<TableScan>(_orders_wrapper, std::vector<ScanPredicate>{predicate});
+  scan->execute();
+  EXPECT_EQ(scan->get_output()->row_count(), 0u);
+}
+
+}  // namespace opossum
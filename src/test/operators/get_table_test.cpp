@@ -8,27 +8,27 @@
 #include "storage/table.hpp"
 
 namespace opossum {
-// class OperatorsGetTableTest : public BaseTest {
-//  protected:
-//   void SetUp() override {
-//     _test_table = std::make_shared<Table>(2);
-//     StorageManager::get().add_table("aNiceTestTable", _test_table);
-//   }
+class OperatorsGetTableTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _test_table = std::make_shared<Table>(2);
+    StorageManager::get().add_table("aNiceTestTable", _test_table);
+  }
 
-//   std::shared_ptr<Table> _test_table;
-// };
+  std::shared_ptr<Table> _test_table;
+};
 
-// TEST_F(OperatorsGetTableTest, GetOutput) {
-//   auto gt = std::make_shared<GetTable>("aNiceTestTable");
-//   gt->execute();
+TEST_F(OperatorsGetTableTest, GetOutput) {
+  auto gt = std::make_shared<GetTable>("aNiceTestTable");
+  gt->execute();
 
-//   EXPECT_EQ(gt->get_output(), _test_table);
-// }
+  EXPECT_EQ(gt->get_output(), _test_table);
+}
 
-// TEST_F(OperatorsGetTableTest, ThrowsUnknownTableName) {
-//   auto gt = std::make_shared<GetTable>("anUglyTestTable");
+TEST_F(OperatorsGetTableTest, ThrowsUnknownTableName) {
+  auto gt = std::make_shared<GetTable>("anUglyTestTable");
 
-//   EXPECT_THROW(gt->execute(), std::exception) << "Should throw unknown table name exception";
-// }
+  EXPECT_THROW(gt->execute(), std::exception) << "Should throw unknown table name exception";
+}
 
 }  // namespace opossum
@@ -0,0 +1,67 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/intersect_positions.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsIntersectPositionsTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(4);
+    _table->add_column("a", "int");
+    _table->add_column("b", "int");
+    for (auto value = 0; value < 10; ++value) _table->append({value, value % 3});
+    _table->compress_chunk(ChunkID{0});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<TableScan> scan(const ColumnID column_id, const ScanType scan_type, const AllTypeVariant& value) {
+    auto table_scan = std::make_shared<TableScan>(_table_wrapper, column_id, scan_type, value);
+    table_scan->execute();
+    return table_scan;
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsIntersectPositionsTest, Intersection) {
+  auto intersect = std::make_shared<IntersectPositions>(scan(ColumnID{0}, ScanType::OpGreaterThanEquals, 2),
+                                                        scan(ColumnID{1}, ScanType::OpEquals, 1));
+  intersect->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", "int");
+  expected->add_column("b", "int");
+  expected->append({4, 1});
+  expected->append({7, 1});
+  EXPECT_TABLE_EQ(intersect->get_output(), expected, true);
+}
+
+TEST_F(OperatorsIntersectPositionsTest, DisjointInputs) {
+  auto intersect = std::make_shared<IntersectPositions>(scan(ColumnID{0}, ScanType::OpLessThan, 3),
+                                                        scan(ColumnID{0}, ScanType::OpGreaterThan, 6));
+  intersect->execute();
+  EXPECT_EQ(intersect->get_output()->row_count(), 0u);
+  EXPECT_EQ(intersect->get_output()->get_chunk(ChunkID{0}).column_count(), 2u);
+}
+
+TEST_F(OperatorsIntersectPositionsTest, SameInput) {
+  const auto table_scan = scan(ColumnID{1}, ScanType::OpNotEquals, 0);
+  auto intersect = std::make_shared<IntersectPositions>(table_scan, table_scan);
+  intersect->execute();
+  EXPECT_TABLE_EQ(intersect->get_output(), table_scan->get_output(), true);
+}
+
+}  // namespace opossum
@@ -0,0 +1,125 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/limit.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsLimitTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(2);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+    _table->append({1, "one"});
+    _table->append({2, "two"});
+    _table->append({3, "three"});
+    _table->append({4, "four"});
+    _table->append({5, "five"});
+    _table->compress_chunk(ChunkID{0});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsLimitTest, ReferencesWholeChunks) {
+  auto limit = std::make_shared<Limit>(_table_wrapper, 4);
+  limit->execute();
+
+  const auto output = limit->get_output();
+  EXPECT_EQ(output->row_count(), 4u);
+  EXPECT_EQ(output->chunk_count(), 2u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto reference_segment =
+        std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(chunk_id).get_segment(ColumnID{1}));
+    ASSERT_TRUE(reference_segment);
+    EXPECT_EQ(reference_segment->referenced_table(), _table);
+  }
+
+  // Whole chunks of ReferenceSegments are forwarded
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 0);
+  scan->execute();
+  auto referenced_limit = std::make_shared<Limit>(scan, 4);
+  referenced_limit->execute();
+  EXPECT_EQ(referenced_limit->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}),
+            scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+}
+
+TEST_F(OperatorsLimitTest, SkipsEmptyChunks) {
+  auto table = std::make_shared<Table>(3);
+  table->add_column("a", "int");
+  table->create_new_chunk();
+  for (auto value = 10; value < 16; ++value) table->append({value});
+  ASSERT_EQ(table->pin_chunk(ChunkID{0})->size(), 0u);
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  auto limit = std::make_shared<Limit>(table_wrapper, 4);
+  limit->execute();
+  auto sort = std::make_shared<Sort>(limit, std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::Descending}});
+  sort->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", "int");
+  for (const auto value : {13, 12, 11, 10}) expected->append({value});
+  EXPECT_TABLE_EQ(sort->get_output(), expected, true);
+}
+
+TEST_F(OperatorsLimitTest, CutsLastChunk) {
+  auto limit = std::make_shared<Limit>(_table_wrapper, 3);
+  limit->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", "int");
+  expected->add_column("b", "string");
+  expected->append({1, "one"});
+  expected->append({2, "two"});
+  expected->append({3, "three"});
+  EXPECT_TABLE_EQ(limit->get_output(), expected, true);
+
+  const auto& last_chunk = limit->get_output()->get_chunk(ChunkID{1});
+  EXPECT_TRUE(std::dynamic_pointer_cast<ReferenceSegment>(last_chunk.get_segment(ColumnID{0})));
+}
+
+TEST_F(OperatorsLimitTest, LimitLargerThanInput) {
+  auto limit = std::make_shared<Limit>(_table_wrapper, 100);
+  limit->execute();
+  EXPECT_TABLE_EQ(limit->get_output(), _table, true);
+}
+
+TEST_F(OperatorsLimitTest, ZeroRows) {
+  auto limit = std::make_shared<Limit>(_table_wrapper, 0);
+  limit->execute();
+  EXPECT_EQ(limit->get_output()->row_count(), 0u);
+  EXPECT_EQ(limit->get_output()->get_chunk(ChunkID{0}).column_count(), 2u);
+}
+
+TEST_F(OperatorsLimitTest, ReferencedInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpNotEquals, 2);
+  scan->execute();
+  auto limit = std::make_shared<Limit>(scan, 2);
+  limit->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", "int");
+  expected->add_column("b", "string");
+  expected->append({1, "one"});
+  expected->append({3, "three"});
+  EXPECT_TABLE_EQ(limit->get_output(), expected, true);
+}
+
+}  // namespace opossum
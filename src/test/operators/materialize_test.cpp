@@ -0,0 +1,111 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/materialize.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsMaterializeTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(4);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+    _table->add_column("c", "double");
+    for (auto index = 0; index < 50; ++index) {
+      _table->append({index, "s" + std::to_string(index % 7), index * 0.5});
+    }
+    for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); chunk_id += 2) _table->compress_chunk(chunk_id);
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsMaterializeTest, MaterializesReferences) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 5);
+  scan->execute();
+  auto second_scan = std::make_shared<TableScan>(scan, ColumnID{2}, ScanType::OpLessThan, 20.0);
+  second_scan->execute();
+
+  auto materialize = std::make_shared<Materialize>(second_scan);
+  materialize->execute();
+
+  const auto output = materialize->get_output();
+  EXPECT_TABLE_EQ(output, second_scan->get_output());
+  EXPECT_EQ(output->row_count(), 35u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto& chunk = output->get_chunk(chunk_id);
+    EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<int32_t>>(chunk.get_segment(ColumnID{0})));
+    EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<std::string>>(chunk.get_segment(ColumnID{1})));
+    EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<double>>(chunk.get_segment(ColumnID{2})));
+  }
+}
+
+TEST_F(OperatorsMaterializeTest, SelectedColumns) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{1}, ScanType::OpEquals, "s3");
+  scan->execute();
+
+  auto materialize = std::make_shared<Materialize>(scan, std::vector<ColumnID>{ColumnID{1}});
+  materialize->execute();
+
+  const auto output = materialize->get_output();
+  EXPECT_TABLE_EQ(output, scan->get_output());
+  const auto& chunk = output->get_chunk(ChunkID{0});
+  EXPECT_TRUE(std::dynamic_pointer_cast<ReferenceSegment>(chunk.get_segment(ColumnID{0})));
+  EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<std::string>>(chunk.get_segment(ColumnID{1})));
+}
+
+TEST_F(OperatorsMaterializeTest, ForwardsDataSegments) {
+  auto materialize = std::make_shared<Materialize>(_table_wrapper);
+  materialize->execute();
+
+  const auto output = materialize->get_output();
+  ASSERT_EQ(output->chunk_count(), _table->chunk_count());
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    EXPECT_EQ(output->get_chunk(chunk_id).get_segment(ColumnID{1}),
+              _table->get_chunk(chunk_id).get_segment(ColumnID{1}));
+  }
+}
+
+TEST_F(OperatorsMaterializeTest, EmptyInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 0);
+  scan->execute();
+
+  auto materialize = std::make_shared<Materialize>(scan);
+  materialize->execute();
+  EXPECT_EQ(materialize->get_output()->row_count(), 0u);
+  EXPECT_EQ(materialize->get_output()->column_count(), 3u);
+}
+
+TEST_F(OperatorsMaterializeTest, SingleLevelReferences) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 10);
+  scan->execute();
+  auto second_scan = std::make_shared<TableScan>(scan, ColumnID{0}, ScanType::OpLessThan, 40);
+  second_scan->execute();
+
+  const auto& chunk = second_scan->get_output()->get_chunk(ChunkID{0});
+  const auto segment = std::dynamic_pointer_cast<ReferenceSegment>(chunk.get_segment(ColumnID{0}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), _table);
+
+  if constexpr (HYRISE_DEBUG) {
+    const auto pos_list = std::make_shared<PosList>(PosList{RowID{ChunkID{0}, 0}});
+    EXPECT_THROW(ReferenceSegment(scan->get_output(), ColumnID{0}, pos_list), std::logic_error);
+  }
+}
+
+}  // namespace opossum
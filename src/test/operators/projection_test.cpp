@@ -0,0 +1,106 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "expression/expressions.hpp"
+#include "operators/projection.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsProjectionTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(2);
+    _table->add_column("a", "int");
+    _table->add_column("b", "float");
+    _table->add_column("c", "string");
+    _table->append({1, 1.5f, "one"});
+    _table->append({2, 2.5f, "two"});
+    _table->append({3, 3.5f, "three"});
+    _table->compress_chunk(ChunkID{0});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsProjectionTest, SelectsAndReordersColumns) {
+  auto projection = std::make_shared<Projection>(_table_wrapper, std::vector<ColumnID>{ColumnID{2}, ColumnID{0}});
+  projection->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("c", "string");
+  expected->add_column("a", "int");
+  expected->append({"one", 1});
+  expected->append({"two", 2});
+  expected->append({"three", 3});
+  EXPECT_TABLE_EQ(projection->get_output(), expected);
+}
+
+TEST_F(OperatorsProjectionTest, SharesSegments) {
+  auto projection = std::make_shared<Projection>(_table_wrapper, std::vector<ColumnID>{ColumnID{1}, ColumnID{1}});
+  projection->execute();
+
+  const auto output = projection->get_output();
+  ASSERT_EQ(output->chunk_count(), _table->chunk_count());
+  const auto& input_segment = _table->get_chunk(ChunkID{0}).get_segment(ColumnID{1});
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).get_segment(ColumnID{0}), input_segment);
+  EXPECT_EQ(output->get_chunk(ChunkID{0}).get_segment(ColumnID{1}), input_segment);
+
+  // The last chunk is still mutable, so its values are copied
+  EXPECT_NE(output->get_chunk(ChunkID{1}).get_segment(ColumnID{0}),
+            _table->get_chunk(ChunkID{1}).get_segment(ColumnID{1}));
+}
+
+TEST_F(OperatorsProjectionTest, DoesNotGrowWithMutableChunk) {
+  auto table = std::make_shared<Table>(10);
+  table->add_column("a", "int");
+  table->append({1});
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  const auto column = std::make_shared<ColumnExpression>(ColumnID{0});
+  const auto sum = std::make_shared<ArithmeticExpression>(ArithmeticOperator::Addition, column, column);
+  auto projection = std::make_shared<Projection>(table_wrapper, std::vector<std::shared_ptr<AbstractExpression>>{
+                                                                    column, sum});
+  projection->execute();
+  table->append({2});
+
+  const auto& chunk = projection->get_output()->get_chunk(ChunkID{0});
+  EXPECT_EQ(chunk.size(), 1u);
+  EXPECT_EQ(chunk.get_segment(ColumnID{0})->size(), 1u);
+  EXPECT_EQ(chunk.get_segment(ColumnID{1})->size(), 1u);
+  EXPECT_EQ((*chunk.get_segment(ColumnID{1}))[0], AllTypeVariant{2});
+}
+
+TEST_F(OperatorsProjectionTest, ReferencedInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  scan->execute();
+  auto projection = std::make_shared<Projection>(scan, std::vector<ColumnID>{ColumnID{2}});
+  projection->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("c", "string");
+  expected->append({"two"});
+  expected->append({"three"});
+  EXPECT_TABLE_EQ(projection->get_output(), expected);
+  EXPECT_EQ(projection->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}),
+            scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{2}));
+}
+
+TEST_F(OperatorsProjectionTest, InvalidColumn) {
+  auto projection = std::make_shared<Projection>(_table_wrapper, std::vector<ColumnID>{ColumnID{3}});
+  EXPECT_THROW(projection->execute(), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,257 @@
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/delta_merger.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "type_cast.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsSortTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(3);
+    _table->add_column("name", "string");
+    _table->add_column("age", "int");
+    _table->add_column("score", "double");
+    _table->append({"Bill", 30, 1.5});
+    _table->append({"Steve", 25, -2.0});
+    _table->append({"Alexander", 30, 0.0});
+    _table->append({"Hasso", -5, -7.25});
+    _table->append({"Bill", 25, 3.0});
+    _table->append({"Steve", 30, -0.5});
+    _table->append({"Alexander", 41, 12.0});
+
+    // Mix dictionary-encoded and unencoded chunks
+    _table->compress_chunk(ChunkID{0});
+    _table->compress_chunk(ChunkID{2});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsSortTest, SingleColumnAscending) {
+  auto sort = std::make_shared<Sort>(_table_wrapper, std::vector<SortColumnDefinition>{{ColumnID{2}}});
+  sort->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("name", "string");
+  expected->add_column("age", "int");
+  expected->add_column("score", "double");
+  expected->append({"Hasso", -5, -7.25});
+  expected->append({"Steve", 25, -2.0});
+  expected->append({"Steve", 30, -0.5});
+  expected->append({"Alexander", 30, 0.0});
+  expected->append({"Bill", 30, 1.5});
+  expected->append({"Bill", 25, 3.0});
+  expected->append({"Alexander", 41, 12.0});
+
+  EXPECT_TABLE_EQ(sort->get_output(), expected, true);
+}
+
+TEST_F(OperatorsSortTest, MultipleColumnsMixedOrder) {
+  auto sort = std::make_shared<Sort>(
+      _table_wrapper, std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::Descending},
+                                                        {ColumnID{1}, OrderByMode::Ascending}});
+  sort->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("name", "string");
+  expected->add_column("age", "int");
+  expected->add_column("score", "double");
+  expected->append({"Steve", 25, -2.0});
+  expected->append({"Steve", 30, -0.5});
+  expected->append({"Hasso", -5, -7.25});
+  expected->append({"Bill", 25, 3.0});
+  expected->append({"Bill", 30, 1.5});
+  expected->append({"Alexander", 30, 0.0});
+  expected->append({"Alexander", 41, 12.0});
+
+  EXPECT_TABLE_EQ(sort->get_output(), expected, true);
+}
+
+TEST_F(OperatorsSortTest, IsStable) {
+  auto sort = std::make_shared<Sort>(_table_wrapper,
+                                     std::vector<SortColumnDefinition>{{ColumnID{1}, OrderByMode::Descending}});
+  sort->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("name", "string");
+  expected->add_column("age", "int");
+  expected->add_column("score", "double");
+  expected->append({"Alexander", 41, 12.0});
+  expected->append({"Bill", 30, 1.5});
+  expected->append({"Alexander", 30, 0.0});
+  expected->append({"Steve", 30, -0.5});
+  expected->append({"Steve", 25, -2.0});
+  expected->append({"Bill", 25, 3.0});
+  expected->append({"Hasso", -5, -7.25});
+
+  EXPECT_TABLE_EQ(sort->get_output(), expected, true);
+}
+
+TEST_F(OperatorsSortTest, ReferencesBaseTable) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{1}, ScanType::OpGreaterThanEquals, 25);
+  scan->execute();
+
+  auto sort = std::make_shared<Sort>(scan, std::vector<SortColumnDefinition>{{ColumnID{0}}, {ColumnID{2}}});
+  sort->execute();
+
+  const auto output = sort->get_output();
+  EXPECT_EQ(output->row_count(), 6u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto& chunk = output->get_chunk(chunk_id);
+    for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+      const auto segment = std::dynamic_pointer_cast<ReferenceSegment>(chunk.get_segment(column_id));
+      ASSERT_TRUE(segment);
+      EXPECT_EQ(segment->referenced_table(), _table);
+    }
+  }
+  EXPECT_EQ((*output->get_chunk(ChunkID{0}).get_segment(ColumnID{2}))[0], AllTypeVariant{0.0});
+  EXPECT_EQ((*output->get_chunk(ChunkID{1}).get_segment(ColumnID{0}))[2], AllTypeVariant{"Steve"});
+}
+
+TEST_F(OperatorsSortTest, EmptyInput) {
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{1}, ScanType::OpGreaterThan, 100);
+  scan->execute();
+
+  auto sort = std::make_shared<Sort>(scan, std::vector<SortColumnDefinition>{{ColumnID{0}}});
+  sort->execute();
+
+  EXPECT_EQ(sort->get_output()->row_count(), 0u);
+  EXPECT_EQ(sort->get_output()->get_chunk(ChunkID{0}).column_count(), 3u);
+}
+
+TEST_F(OperatorsSortTest, ManyRuns) {
+  // Enough rows for several sorted runs that have to be merged
+  const auto row_count = 8 * Sort::MIN_ROWS_PER_RUN + 17;
+  auto table = std::make_shared<Table>(10'000);
+  table->add_column("a", "string");
+  table->add_column("b", "long");
+
+  auto random_engine = std::mt19937{42};
+  auto distribution = std::uniform_int_distribution<int64_t>{-1000, 1000};
+  auto rows = std::vector<std::pair<std::string, int64_t>>{};
+  for (auto row = size_t{0}; row < row_count; ++row) {
+    rows.emplace_back("s" + std::to_string(distribution(random_engine) % 100), distribution(random_engine));
+    table->append({rows.back().first, rows.back().second});
+  }
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); chunk_id += 2) table->compress_chunk(chunk_id);
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  auto sort = std::make_shared<Sort>(table_wrapper, std::vector<SortColumnDefinition>{
+                                                        {ColumnID{0}, OrderByMode::Ascending},
+                                                        {ColumnID{1}, OrderByMode::Descending}});
+  sort->execute();
+
+  std::stable_sort(rows.begin(), rows.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first || (lhs.first == rhs.first && lhs.second > rhs.second);
+  });
+
+  const auto output = sort->get_output();
+  ASSERT_EQ(output->row_count(), row_count);
+  auto row = size_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto& chunk = output->get_chunk(chunk_id);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset, ++row) {
+      ASSERT_EQ(type_cast<std::string>((*chunk.get_segment(ColumnID{0}))[chunk_offset]), rows[row].first);
+      ASSERT_EQ(type_cast<int64_t>((*chunk.get_segment(ColumnID{1}))[chunk_offset]), rows[row].second);
+    }
+  }
+}
+
+TEST_F(OperatorsSortTest, SortWhileAppending) {
+  auto table = std::make_shared<Table>(65'535);
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // The segments of the last chunk can hold more rows than the chunk while rows are appended
+  auto done = std::atomic<bool>{false};
+  auto appender = std::thread{[&]() {
+    for (auto row = 0; row < 100'000; ++row) table->append({-row, "s" + std::to_string(row % 100)});
+    done = true;
+  }};
+  auto previous_row_count = uint64_t{0};
+  for (auto iteration = 0; iteration < 3 || !done; ++iteration) {
+    auto sort = std::make_shared<Sort>(table_wrapper, std::vector<SortColumnDefinition>{
+                                                          {ColumnID{1}, OrderByMode::Descending},
+                                                          {ColumnID{0}, OrderByMode::Ascending}});
+    sort->execute();
+
+    const auto output = sort->get_output();
+    EXPECT_GE(output->row_count(), previous_row_count);
+    previous_row_count = output->row_count();
+    for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+      const auto& chunk = output->get_chunk(chunk_id);
+      const auto& segment = *chunk.get_segment(ColumnID{0});
+      for (auto chunk_offset = ChunkOffset{1}; chunk_offset < chunk.size(); ++chunk_offset) {
+        const auto& names = *chunk.get_segment(ColumnID{1});
+        if (names[chunk_offset - 1] != names[chunk_offset]) continue;
+        ASSERT_LT(type_cast<int32_t>(segment[chunk_offset - 1]), type_cast<int32_t>(segment[chunk_offset]));
+      }
+    }
+  }
+  appender.join();
+}
+
+TEST_F(OperatorsSortTest, SortWhileChunksAreReplaced) {
+  auto table = std::make_shared<Table>(1'000);
+  table->add_column("a", "string");
+  auto delta_merger = DeltaMerger{table};
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+
+  // Merged chunks can be replaced by ones that share a dictionary with values of rows that the sort does not read
+  auto done = std::atomic<bool>{false};
+  auto writer = std::thread{[&]() {
+    for (auto row = 0; row < 50'000; ++row) {
+      table->append({"s" + std::to_string(row / 10)});
+      if (row % 5'000 == 0) {
+        delta_merger.merge();
+        table->use_global_dictionary(ColumnID{0});
+      }
+    }
+    done = true;
+  }};
+  for (auto iteration = 0; iteration < 3 || !done; ++iteration) {
+    auto sort = std::make_shared<Sort>(table_wrapper, std::vector<SortColumnDefinition>{{ColumnID{0}}});
+    sort->execute();
+
+    const auto output = sort->get_output();
+    auto previous_value = std::string{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+      const auto& chunk = output->get_chunk(chunk_id);
+      const auto& segment = *chunk.get_segment(ColumnID{0});
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+        const auto value = type_cast<std::string>(segment[chunk_offset]);
+        ASSERT_LE(previous_value, value);
+        previous_value = value;
+      }
+    }
+  }
+  writer.join();
+}
+
+}  // namespace opossum
@@ -0,0 +1,131 @@
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/top_k.hpp"
+#include "storage/table.hpp"
+#include "type_cast.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsTopKTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(3);
+    _table->add_column("name", "string");
+    _table->add_column("age", "int");
+    _table->append({"Bill", 30});
+    _table->append({"Steve", 25});
+    _table->append({"Alexander", 30});
+    _table->append({"Hasso", -5});
+    _table->append({"Bill", 25});
+    _table->append({"Steve", 30});
+    _table->append({"Alexander", 41});
+    _table->compress_chunk(ChunkID{0});
+    _table->compress_chunk(ChunkID{2});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsTopKTest, Ascending) {
+  auto top_k = std::make_shared<TopK>(_table_wrapper, ColumnID{1}, OrderByMode::Ascending, 3);
+  top_k->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("name", "string");
+  expected->add_column("age", "int");
+  expected->append({"Hasso", -5});
+  expected->append({"Steve", 25});
+  expected->append({"Bill", 25});
+  EXPECT_TABLE_EQ(top_k->get_output(), expected, true);
+}
+
+TEST_F(OperatorsTopKTest, DescendingKeepsInputOrderOfTies) {
+  auto top_k = std::make_shared<TopK>(_table_wrapper, ColumnID{0}, OrderByMode::Descending, 4);
+  top_k->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("name", "string");
+  expected->add_column("age", "int");
+  expected->append({"Steve", 25});
+  expected->append({"Steve", 30});
+  expected->append({"Hasso", -5});
+  expected->append({"Bill", 30});
+  EXPECT_TABLE_EQ(top_k->get_output(), expected, true);
+}
+
+TEST_F(OperatorsTopKTest, KLargerThanInput) {
+  auto top_k = std::make_shared<TopK>(_table_wrapper, ColumnID{1}, OrderByMode::Descending, 100);
+  top_k->execute();
+  EXPECT_EQ(top_k->get_output()->row_count(), 7u);
+  EXPECT_EQ((*top_k->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}))[0], AllTypeVariant{"Alexander"});
+}
+
+TEST_F(OperatorsTopKTest, HugeK) {
+  auto top_k = std::make_shared<TopK>(_table_wrapper, ColumnID{1}, OrderByMode::Ascending,
+                                      std::numeric_limits<size_t>::max());
+  top_k->execute();
+  EXPECT_EQ(top_k->get_output()->row_count(), 7u);
+}
+
+TEST_F(OperatorsTopKTest, EmptyResult) {
+  auto top_k = std::make_shared<TopK>(_table_wrapper, ColumnID{1}, OrderByMode::Ascending, 0);
+  top_k->execute();
+  EXPECT_EQ(top_k->get_output()->row_count(), 0u);
+  EXPECT_EQ(top_k->get_output()->get_chunk(ChunkID{0}).column_count(), 2u);
+
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{1}, ScanType::OpGreaterThan, 100);
+  scan->execute();
+  auto top_k_on_empty = std::make_shared<TopK>(scan, ColumnID{1}, OrderByMode::Ascending, 3);
+  top_k_on_empty->execute();
+  EXPECT_EQ(top_k_on_empty->get_output()->row_count(), 0u);
+}
+
+TEST_F(OperatorsTopKTest, MatchesFullSort) {
+  auto table = std::make_shared<Table>(100);
+  table->add_column("a", "long");
+
+  auto random_engine = std::mt19937{42};
+  auto distribution = std::uniform_int_distribution<int64_t>{-1000, 1000};
+  auto values = std::vector<int64_t>{};
+  for (auto row = 0; row < 5000; ++row) {
+    values.push_back(distribution(random_engine));
+    table->append({values.back()});
+  }
+  // Pruning only applies to dictionary-encoded chunks
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); chunk_id += 2) table->compress_chunk(chunk_id);
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  auto top_k = std::make_shared<TopK>(table_wrapper, ColumnID{0}, OrderByMode::Descending, 150);
+  top_k->execute();
+
+  std::sort(values.begin(), values.end(), std::greater<>{});
+  const auto output = top_k->get_output();
+  ASSERT_EQ(output->row_count(), 150u);
+  auto row = size_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto& chunk = output->get_chunk(chunk_id);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset, ++row) {
+      EXPECT_EQ(type_cast<int64_t>((*chunk.get_segment(ColumnID{0}))[chunk_offset]), values[row]);
+    }
+  }
+}
+
+}  // namespace opossum
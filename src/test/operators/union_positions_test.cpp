@@ -0,0 +1,123 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/projection.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/union_positions.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsUnionPositionsTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(3);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+    for (auto value = 0; value < 10; ++value) _table->append({value, std::string(1, static_cast<char>('a' + value))});
+    _table->compress_chunk(ChunkID{1});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  std::shared_ptr<TableScan> scan(const std::shared_ptr<const AbstractOperator>& input, const ScanType scan_type,
+                                  const AllTypeVariant& value) {
+    auto table_scan = std::make_shared<TableScan>(input, ColumnID{0}, scan_type, value);
+    table_scan->execute();
+    return table_scan;
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsUnionPositionsTest, Disjunction) {
+  // a < 3 OR a BETWEEN 2 AND 4 OR a = 8
+  auto between = std::make_shared<TableScan>(
+      _table_wrapper, std::vector<ScanPredicate>{{ColumnID{0}, ScanType::OpBetween, 2, 4}});
+  between->execute();
+  auto union_1 = std::make_shared<UnionPositions>(scan(_table_wrapper, ScanType::OpLessThan, 3), between);
+  union_1->execute();
+  auto union_2 = std::make_shared<UnionPositions>(union_1, scan(_table_wrapper, ScanType::OpEquals, 8));
+  union_2->execute();
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", "int");
+  expected->add_column("b", "string");
+  expected->append({0, "a"});
+  expected->append({1, "b"});
+  expected->append({2, "c"});
+  expected->append({3, "d"});
+  expected->append({4, "e"});
+  expected->append({8, "i"});
+  EXPECT_TABLE_EQ(union_2->get_output(), expected, true);
+
+  const auto& chunk = union_2->get_output()->get_chunk(ChunkID{0});
+  const auto segment = std::dynamic_pointer_cast<ReferenceSegment>(chunk.get_segment(ColumnID{1}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), _table);
+}
+
+TEST_F(OperatorsUnionPositionsTest, UnsortedPositionsAndProjection) {
+  auto sort = std::make_shared<Sort>(scan(_table_wrapper, ScanType::OpGreaterThan, 6),
+                                     std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::Descending}});
+  sort->execute();
+  auto left = std::make_shared<Projection>(sort, std::vector<ColumnID>{ColumnID{1}});
+  left->execute();
+  auto right = std::make_shared<Projection>(scan(_table_wrapper, ScanType::OpLessThan, 8),
+                                            std::vector<ColumnID>{ColumnID{1}});
+  right->execute();
+
+  auto union_positions = std::make_shared<UnionPositions>(left, right);
+  union_positions->execute();
+  EXPECT_EQ(union_positions->get_output()->row_count(), 10u);
+}
+
+TEST_F(OperatorsUnionPositionsTest, EmptyInputs) {
+  auto union_positions = std::make_shared<UnionPositions>(scan(_table_wrapper, ScanType::OpGreaterThan, 100),
+                                                          scan(_table_wrapper, ScanType::OpLessThan, -1));
+  union_positions->execute();
+  EXPECT_EQ(union_positions->get_output()->row_count(), 0u);
+  EXPECT_EQ(union_positions->get_output()->get_chunk(ChunkID{0}).column_count(), 2u);
+
+  auto one_sided = std::make_shared<UnionPositions>(scan(_table_wrapper, ScanType::OpGreaterThan, 100),
+                                                    scan(_table_wrapper, ScanType::OpLessThan, 4));
+  one_sided->execute();
+  EXPECT_EQ(one_sided->get_output()->row_count(), 4u);
+}
+
+TEST_F(OperatorsUnionPositionsTest, TableGrowsBetweenInputs) {
+  const auto left = scan(_table_wrapper, ScanType::OpLessThan, 3);
+  const auto chunk_count = _table->chunk_count();
+  for (auto value = 10; value < 30; ++value) _table->append({value, "x"});
+  ASSERT_GT(_table->chunk_count(), chunk_count);
+
+  // The right input references chunks that the left input did not see
+  const auto right = scan(_table_wrapper, ScanType::OpGreaterThanEquals, 10);
+  auto union_positions = std::make_shared<UnionPositions>(left, right);
+  union_positions->execute();
+  EXPECT_EQ(union_positions->get_output()->row_count(), 23u);
+}
+
+TEST_F(OperatorsUnionPositionsTest, InputsHaveToReferenceTheSameColumns) {
+  auto projection = std::make_shared<Projection>(scan(_table_wrapper, ScanType::OpLessThan, 3),
+                                                 std::vector<ColumnID>{ColumnID{1}, ColumnID{0}});
+  projection->execute();
+  auto union_positions =
+      std::make_shared<UnionPositions>(projection, scan(_table_wrapper, ScanType::OpGreaterThan, 5));
+  EXPECT_THROW(union_positions->execute(), std::logic_error);
+
+  auto data_input = std::make_shared<UnionPositions>(_table_wrapper, scan(_table_wrapper, ScanType::OpLessThan, 3));
+  EXPECT_THROW(data_input->execute(), std::logic_error);
+}
+
+}  // namespace opossum
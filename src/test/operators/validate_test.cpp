@@ -0,0 +1,159 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/sort.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class OperatorsValidateTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(2, UseMvcc::Yes);
+    _table->add_column("a", "int");
+    insert_committed({1, 2, 3});
+    _table->compress_chunk(ChunkID{0});
+
+    _table_wrapper = std::make_shared<TableWrapper>(_table);
+    _table_wrapper->execute();
+  }
+
+  void insert_committed(const std::vector<int32_t>& values) {
+    const auto transaction_context = TransactionManager::get().new_transaction_context();
+    transaction_context->insert(_table, {values});
+    transaction_context->commit();
+  }
+
+  std::shared_ptr<const Table> validate(const std::shared_ptr<const AbstractOperator>& in,
+                                        const std::shared_ptr<const TransactionContext>& transaction_context) {
+    auto validate = std::make_shared<Validate>(in, transaction_context);
+    validate->execute();
+    return validate->get_output();
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsValidateTest, ReferencesInputTable) {
+  const auto transaction_context = TransactionManager::get().new_transaction_context();
+  const auto output = validate(_table_wrapper, transaction_context);
+  EXPECT_EQ(output->row_count(), 3u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+    const auto reference_segment =
+        std::dynamic_pointer_cast<const ReferenceSegment>(output->get_chunk(chunk_id).get_segment(ColumnID{0}));
+    ASSERT_TRUE(reference_segment);
+    EXPECT_EQ(reference_segment->referenced_table(), _table);
+  }
+
+  // Chunks of ReferenceSegments whose rows are all visible are forwarded
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 0);
+  scan->execute();
+  EXPECT_EQ(validate(scan, transaction_context)->get_chunk(ChunkID{0}).get_segment(ColumnID{0}),
+            scan->get_output()->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+}
+
+TEST_F(OperatorsValidateTest, ReadsSnapshot) {
+  const auto reader = TransactionManager::get().new_transaction_context();
+  const auto writer = TransactionManager::get().new_transaction_context();
+  writer->insert(_table, {std::vector<int32_t>{4, 5}});
+
+  EXPECT_EQ(validate(_table_wrapper, reader)->row_count(), 3u);
+  EXPECT_EQ(validate(_table_wrapper, writer)->row_count(), 5u);
+
+  // The rows of the last chunk are referenced, so the output does not grow by later inserts
+  const auto output = validate(_table_wrapper, writer);
+  insert_committed({6});
+  EXPECT_EQ(output->row_count(), 5u);
+
+  writer->commit();
+  EXPECT_EQ(validate(_table_wrapper, reader)->row_count(), 3u);
+  EXPECT_EQ(validate(_table_wrapper, TransactionManager::get().new_transaction_context())->row_count(), 6u);
+}
+
+TEST_F(OperatorsValidateTest, HidesDeletedRows) {
+  const auto reader = TransactionManager::get().new_transaction_context();
+  const auto deleter = TransactionManager::get().new_transaction_context();
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 3);
+  scan->execute();
+  EXPECT_TRUE(deleter->delete_rows(validate(scan, deleter)));
+
+  EXPECT_EQ(validate(_table_wrapper, deleter)->row_count(), 1u);
+  EXPECT_EQ(validate(_table_wrapper, reader)->row_count(), 3u);
+  EXPECT_EQ(_table->approx_valid_row_count(), 3u);
+
+  deleter->commit();
+  EXPECT_EQ(validate(_table_wrapper, reader)->row_count(), 3u);
+  const auto output = validate(_table_wrapper, TransactionManager::get().new_transaction_context());
+  EXPECT_EQ(output->row_count(), 1u);
+  EXPECT_EQ((*output->get_chunk(ChunkID{0}).get_segment(ColumnID{0}))[0], AllTypeVariant{3});
+  EXPECT_EQ(_table->approx_valid_row_count(), 1u);
+}
+
+TEST_F(OperatorsValidateTest, OutputCanBeReferencedAndDeleted) {
+  insert_committed({4, 5});
+  _table->compress_chunk(ChunkID{1});
+
+  // Chunk 0 has no visible rows afterwards, chunk 1 is immutable and fully visible, chunk 2 is still mutable
+  const auto deleter = TransactionManager::get().new_transaction_context();
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpLessThan, 3);
+  scan->execute();
+  ASSERT_TRUE(deleter->delete_rows(validate(scan, deleter)));
+  deleter->commit();
+
+  const auto transaction_context = TransactionManager::get().new_transaction_context();
+  auto validate_operator = std::make_shared<Validate>(_table_wrapper, transaction_context);
+  validate_operator->execute();
+  auto sort = std::make_shared<Sort>(validate_operator,
+                                     std::vector<SortColumnDefinition>{{ColumnID{0}, OrderByMode::Descending}});
+  sort->execute();
+  auto sorted_values = std::vector<AllTypeVariant>{};
+  const auto sorted = sort->get_output();
+  for (auto chunk_id = ChunkID{0}; chunk_id < sorted->chunk_count(); ++chunk_id) {
+    const auto& chunk = sorted->get_chunk(chunk_id);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+      sorted_values.push_back((*chunk.get_segment(ColumnID{0}))[chunk_offset]);
+    }
+  }
+  EXPECT_EQ(sorted_values, (std::vector<AllTypeVariant>{5, 4, 3}));
+
+  // Rows can be deleted through scans on the output, too
+  auto validated_scan = std::make_shared<TableScan>(validate_operator, ColumnID{0}, ScanType::OpGreaterThan, 3);
+  validated_scan->execute();
+  ASSERT_TRUE(transaction_context->delete_rows(validated_scan->get_output()));
+  transaction_context->commit();
+  EXPECT_EQ(_table->approx_valid_row_count(), 1u);
+}
+
+TEST_F(OperatorsValidateTest, ValidatesReferenceTables) {
+  const auto writer = TransactionManager::get().new_transaction_context();
+  writer->insert(_table, {std::vector<int32_t>{4, 5}});
+
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 1);
+  scan->execute();
+  EXPECT_EQ(validate(scan, writer)->row_count(), 4u);
+  EXPECT_EQ(validate(scan, TransactionManager::get().new_transaction_context())->row_count(), 2u);
+}
+
+TEST_F(OperatorsValidateTest, OutputsEmptyTable) {
+  const auto writer = TransactionManager::get().new_transaction_context();
+  auto scan = std::make_shared<TableScan>(_table_wrapper, ColumnID{0}, ScanType::OpGreaterThan, 10);
+  scan->execute();
+
+  const auto output = validate(scan, writer);
+  EXPECT_EQ(output->row_count(), 0u);
+  EXPECT_EQ(output->column_count(), 1u);
+}
+
+}  // namespace opossum
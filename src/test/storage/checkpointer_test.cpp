@@ -0,0 +1,146 @@
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <iterator>
+#include <memory>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/dictionary_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class StorageCheckpointerTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    std::filesystem::remove_all(_directory);
+    StorageManager::get().enable_durability(_directory);
+
+    auto table = std::make_shared<Table>(3);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    StorageManager::get().add_table("t", table);
+    for (auto value = 0; value < 7; ++value) table->append({value, std::to_string(value)});
+    table->compress_chunk(ChunkID{0});
+  }
+
+  void TearDown() override {
+    StorageManager::get().reset();
+    std::filesystem::remove_all(_directory);
+  }
+
+  void restart() {
+    StorageManager::get().reset();
+    StorageManager::get().enable_durability(_directory);
+  }
+
+  std::set<std::string> chunk_files() const {
+    auto files = std::set<std::string>{};
+    for (const auto& entry : std::filesystem::directory_iterator{_directory / "checkpoint"}) {
+      if (entry.path().extension() == ".bin") files.insert(entry.path().filename().string());
+    }
+    return files;
+  }
+
+  const std::filesystem::path _directory = std::filesystem::temp_directory_path() / "checkpointer_test";
+};
+
+TEST_F(StorageCheckpointerTest, RecoversCheckpoint) {
+  StorageManager::get().checkpoint();
+  EXPECT_EQ(chunk_files().size(), 3u);
+  EXPECT_EQ(std::filesystem::file_size(_directory / "wal.log"), 0u);
+
+  restart();
+  const auto table = StorageManager::get().get_table("t");
+  ASSERT_EQ(table->chunk_count(), 3u);
+  EXPECT_EQ(table->row_count(), 7u);
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<std::string>>(
+      table->get_chunk(ChunkID{0}).get_segment(ColumnID{1})));
+  EXPECT_EQ((*table->get_chunk(ChunkID{2}).get_segment(ColumnID{1}))[0], AllTypeVariant{"6"});
+
+  // The last chunk can still be appended to
+  table->append({7, "7"});
+  restart();
+  EXPECT_EQ(StorageManager::get().get_table("t")->row_count(), 8u);
+}
+
+TEST_F(StorageCheckpointerTest, WritesCompressedChunksOnce) {
+  StorageManager::get().checkpoint();
+  const auto first_files = chunk_files();
+
+  StorageManager::get().get_table("t")->append({7, "7"});
+  StorageManager::get().checkpoint();
+  const auto second_files = chunk_files();
+
+  // The file of the compressed chunk is kept, the others are replaced
+  auto kept_files = std::vector<std::string>{};
+  std::set_intersection(first_files.begin(), first_files.end(), second_files.begin(), second_files.end(),
+                        std::back_inserter(kept_files));
+  EXPECT_EQ(kept_files.size(), 1u);
+  EXPECT_EQ(second_files.size(), 3u);
+
+  // After recovery, the compressed chunk is still known to be written
+  restart();
+  StorageManager::get().checkpoint();
+  EXPECT_TRUE(chunk_files().contains(kept_files.front()));
+
+  // A chunk that is compressed after it was written is written once more, and then kept as well
+  StorageManager::get().get_table("t")->compress_chunk(ChunkID{1});
+  StorageManager::get().checkpoint();
+  const auto third_files = chunk_files();
+  StorageManager::get().checkpoint();
+  const auto fourth_files = chunk_files();
+  kept_files.clear();
+  std::set_intersection(third_files.begin(), third_files.end(), fourth_files.begin(), fourth_files.end(),
+                        std::back_inserter(kept_files));
+  EXPECT_EQ(kept_files.size(), 2u);
+  restart();
+  EXPECT_EQ(StorageManager::get().get_table("t")->row_count(), 8u);
+}
+
+TEST_F(StorageCheckpointerTest, RemovesDroppedTables) {
+  StorageManager::get().checkpoint();
+  StorageManager::get().drop_table("t");
+  StorageManager::get().checkpoint();
+  EXPECT_TRUE(chunk_files().empty());
+
+  restart();
+  EXPECT_FALSE(StorageManager::get().has_table("t"));
+}
+
+TEST_F(StorageCheckpointerTest, CheckpointsWhileAppending) {
+  constexpr auto ROW_COUNT = 300;
+  const auto table = StorageManager::get().get_table("t");
+  auto appended_rows = std::atomic<int>{0};
+
+  auto writer = std::thread{[&]() {
+    for (auto value = 7; value < 7 + ROW_COUNT; ++value) {
+      table->append({value, std::to_string(value)});
+      ++appended_rows;
+    }
+  }};
+  while (appended_rows < ROW_COUNT / 3) std::this_thread::yield();
+  StorageManager::get().checkpoint();
+  writer.join();
+
+  // The checkpoint holds a prefix of the rows, the rest is recovered from the log
+  restart();
+  const auto recovered = StorageManager::get().get_table("t");
+  ASSERT_EQ(recovered->row_count(), 7u + ROW_COUNT);
+  auto expected_value = 0;
+  for (auto chunk_id = ChunkID{0}; chunk_id < recovered->chunk_count(); ++chunk_id) {
+    const auto& chunk = recovered->get_chunk(chunk_id);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset, ++expected_value) {
+      ASSERT_EQ((*chunk.get_segment(ColumnID{0}))[chunk_offset], AllTypeVariant{expected_value});
+    }
+  }
+}
+
+}  // namespace opossum
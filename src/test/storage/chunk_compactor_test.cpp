@@ -0,0 +1,194 @@
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "concurrency/transaction_manager.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "storage/chunk_compactor.hpp"
+#include "storage/delta_merger.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageChunkCompactorTest : public BaseTest {
+ protected:
+  void TearDown() override { StorageManager::get().reset(); }
+
+  // Adds a table of 25 chunks with 3 rows each, and values from 0 on
+  std::shared_ptr<Table> add_small_chunks(const UseMvcc use_mvcc) {
+    auto table = std::make_shared<Table>(10, use_mvcc);
+    table->add_column_definition("a", "int");
+    for (auto chunk_index = 0; chunk_index < 25; ++chunk_index) {
+      auto chunk = Chunk{};
+      auto segment = std::make_shared<ValueSegment<int32_t>>();
+      for (auto value = chunk_index * 3; value < chunk_index * 3 + 3; ++value) segment->append(value);
+      chunk.add_segment(segment);
+      table->emplace_chunk(std::move(chunk));
+    }
+    StorageManager::get().add_table("t", table);
+    return table;
+  }
+
+  std::vector<int32_t> values(const Table& table) {
+    auto values = std::vector<int32_t>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+      const auto& segment = *table.get_chunk(chunk_id).get_segment(ColumnID{0});
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment.size(); ++chunk_offset) {
+        values.push_back(type_cast<int32_t>(segment[chunk_offset]));
+      }
+    }
+    return values;
+  }
+
+  std::vector<int32_t> range(const int32_t begin, const int32_t end) {
+    auto values = std::vector<int32_t>{};
+    for (auto value = begin; value < end; ++value) values.push_back(value);
+    return values;
+  }
+};
+
+TEST_F(StorageChunkCompactorTest, MergesSmallChunks) {
+  const auto old_table = add_small_chunks(UseMvcc::No);
+  auto compactor = ChunkCompactor{"t"};
+  EXPECT_EQ(compactor.compact(), 17u);
+
+  const auto table = StorageManager::get().get_table("t");
+  ASSERT_EQ(table->chunk_count(), 8u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto& chunk = table->get_chunk(chunk_id);
+    EXPECT_EQ(chunk.size(), chunk_id < 7 ? 10u : 5u);
+    EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<int32_t>>(chunk.get_segment(ColumnID{0})));
+  }
+  EXPECT_EQ(values(*table), range(0, 75));
+
+  // Queries that hold the old table keep its chunks, appends go to the compacted table
+  EXPECT_EQ(old_table->chunk_count(), 25u);
+  old_table->append({75});
+  EXPECT_EQ(values(*old_table), range(0, 75));
+  EXPECT_EQ(values(*table), range(0, 76));
+
+  // The last chunk is below the threshold, but there is nothing to merge it with
+  EXPECT_EQ(compactor.compact(), 0u);
+  EXPECT_EQ(StorageManager::get().get_table("t"), table);
+}
+
+TEST_F(StorageChunkCompactorTest, KeepsGlobalDictionaries) {
+  const auto old_table = add_small_chunks(UseMvcc::No);
+  for (auto chunk_id = ChunkID{0}; chunk_id < old_table->chunk_count(); ++chunk_id) old_table->compress_chunk(chunk_id);
+  old_table->use_global_dictionary(ColumnID{0});
+  EXPECT_EQ(ChunkCompactor{"t"}.compact(), 17u);
+
+  const auto table = StorageManager::get().get_table("t");
+  EXPECT_TRUE(table->has_global_dictionary(ColumnID{0}));
+  const auto& first_segment = *table->get_chunk(ChunkID{0}).get_segment(ColumnID{0});
+  const auto dictionary = dynamic_cast<const DictionarySegment<int32_t>&>(first_segment).dictionary();
+  EXPECT_EQ(dictionary->size(), 75u);
+  for (auto chunk_id = ChunkID{1}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto& segment = *table->get_chunk(chunk_id).get_segment(ColumnID{0});
+    EXPECT_EQ(dynamic_cast<const DictionarySegment<int32_t>&>(segment).dictionary(), dictionary);
+  }
+  EXPECT_EQ(values(*table), range(0, 75));
+}
+
+TEST_F(StorageChunkCompactorTest, CompactsWhileRowsAreAppended) {
+  const auto old_table = add_small_chunks(UseMvcc::No);
+  auto appender = std::thread{[&]() {
+    for (auto value = 75; value < 5'000; ++value) old_table->append({value});
+  }};
+  auto compactor = ChunkCompactor{"t"};
+  EXPECT_EQ(compactor.compact(), 17u);
+  appender.join();
+
+  EXPECT_EQ(values(*StorageManager::get().get_table("t")), range(0, 5'000));
+}
+
+TEST_F(StorageChunkCompactorTest, ForwardsChunkReplacements) {
+  const auto old_table = add_small_chunks(UseMvcc::No);
+  for (auto value = 75; value < 85; ++value) old_table->append({value});
+  EXPECT_EQ(ChunkCompactor{"t"}.compact(), 17u);
+
+  // The full mutable chunk is shared with the compacted table, which sees it being replaced in the old table
+  const auto table = StorageManager::get().get_table("t");
+  ASSERT_EQ(table->chunk_count(), 9u);
+  EXPECT_TRUE(table->get_chunk(ChunkID{8}).is_mutable());
+  EXPECT_EQ(DeltaMerger{old_table}.merge(), 1u);
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<int32_t>>(
+      table->get_chunk(ChunkID{8}).get_segment(ColumnID{0})));
+  EXPECT_EQ(values(*table), range(0, 85));
+}
+
+TEST_F(StorageChunkCompactorTest, MergesRowsAppendedAfterCompaction) {
+  const auto old_table = add_small_chunks(UseMvcc::No);
+  auto merger = DeltaMerger{old_table};
+  EXPECT_EQ(merger.merge(), 0u);
+  EXPECT_EQ(ChunkCompactor{"t"}.compact(), 17u);
+
+  // The rows are only appended to the compacted table, which the merger follows
+  const auto table = StorageManager::get().get_table("t");
+  for (auto value = 75; value < 95; ++value) table->append({value});
+  EXPECT_EQ(merger.merge(), 2u);
+  ASSERT_EQ(table->chunk_count(), 10u);
+  for (const auto chunk_id : {ChunkID{8}, ChunkID{9}}) {
+    EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<int32_t>>(
+        table->get_chunk(chunk_id).get_segment(ColumnID{0})));
+  }
+  EXPECT_EQ(values(*table), range(0, 95));
+}
+
+TEST_F(StorageChunkCompactorTest, DropsInvalidRows) {
+  const auto old_table = add_small_chunks(UseMvcc::Yes);
+  auto table_wrapper = std::make_shared<TableWrapper>(old_table);
+  table_wrapper->execute();
+  const auto visible_rows = [&](const std::shared_ptr<const TransactionContext>& transaction_context,
+                                const ScanType scan_type, const int32_t value) {
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, scan_type, value);
+    scan->execute();
+    auto validate = std::make_shared<Validate>(scan, transaction_context);
+    validate->execute();
+    return validate->get_output();
+  };
+
+  auto old_reader = TransactionManager::get().new_transaction_context();
+  auto deleter = TransactionManager::get().new_transaction_context();
+  ASSERT_TRUE(deleter->delete_rows(visible_rows(deleter, ScanType::OpLessThan, 30)));
+  deleter->commit();
+  // The chunk of a row that a transaction holds a lock on is not merged
+  auto locker = TransactionManager::get().new_transaction_context();
+  ASSERT_TRUE(locker->delete_rows(visible_rows(locker, ScanType::OpEquals, 30)));
+
+  // The deleted rows are still visible to the old reader, so they are kept
+  auto compactor = ChunkCompactor{"t"};
+  EXPECT_EQ(compactor.compact(), 16u);
+  const auto table = StorageManager::get().get_table("t");
+  ASSERT_EQ(table->chunk_count(), 9u);
+  EXPECT_EQ(table->get_chunk(ChunkID{3}).size(), 3u);
+  EXPECT_EQ(values(*table), range(0, 75));
+
+  // Rows that were moved cannot be deleted through the old table anymore
+  const auto late_deleter = TransactionManager::get().new_transaction_context();
+  EXPECT_FALSE(late_deleter->delete_rows(visible_rows(late_deleter, ScanType::OpGreaterThanEquals, 70)));
+  late_deleter->rollback();
+
+  // Once no transaction can see the deleted rows anymore, they are dropped
+  locker->rollback();
+  old_reader = nullptr;
+  deleter = nullptr;
+  locker = nullptr;
+  EXPECT_EQ(compactor.compact(), 3u);
+  const auto compacted_table = StorageManager::get().get_table("t");
+  EXPECT_EQ(compacted_table->chunk_count(), 6u);
+  EXPECT_EQ(values(*compacted_table), range(30, 75));
+  EXPECT_EQ(compacted_table->approx_valid_row_count(), 45u);
+}
+
+}  // namespace opossum
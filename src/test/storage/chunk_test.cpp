@@ -1,61 +1,153 @@
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include "../base_test.hpp"
 #include "gtest/gtest.h"
 
 #include "../lib/resolve_type.hpp"
 #include "../lib/storage/base_segment.hpp"
+#include "../lib/storage/base_value_segment.hpp"
 #include "../lib/storage/chunk.hpp"
+#include "../lib/storage/dictionary_segment.hpp"
+#include "../lib/storage/mvcc_data.hpp"
 #include "../lib/types.hpp"
 
 namespace opossum {
 
-// class StorageChunkTest : public BaseTest {
-//  protected:
-//   void SetUp() override {
-//     int_value_segment = std::make_shared<ValueSegment<int32_t>>();
-//     int_value_segment->append(4);
-//     int_value_segment->append(6);
-//     int_value_segment->append(3);
-
-//     string_value_segment = std::make_shared<ValueSegment<std::string>>();
-//     string_value_segment->append("Hello,");
-//     string_value_segment->append("world");
-//     string_value_segment->append("!");
-//   }
-
-//   Chunk c;
-//   std::shared_ptr<BaseSegment> int_value_segment = nullptr;
-//   std::shared_ptr<BaseSegment> string_value_segment = nullptr;
-// };
-
-// TEST_F(StorageChunkTest, AddSegmentToChunk) {
-//   EXPECT_EQ(c.size(), 0u);
-//   c.add_segment(int_value_segment);
-//   c.add_segment(string_value_segment);
-//   EXPECT_EQ(c.size(), 3u);
-// }
-
-// TEST_F(StorageChunkTest, AddValuesToChunk) {
-//   c.add_segment(int_value_segment);
-//   c.add_segment(string_value_segment);
-//   c.append({2, "two"});
-//   EXPECT_EQ(c.size(), 4u);
-
-//   if constexpr (HYRISE_DEBUG) {
-//     EXPECT_THROW(c.append({}), std::exception);
-//     EXPECT_THROW(c.append({4, "val", 3}), std::exception);
-//     EXPECT_EQ(c.size(), 4u);
-//   }
-// }
-
-// TEST_F(StorageChunkTest, RetrieveSegment) {
-//   c.add_segment(int_value_segment);
-//   c.add_segment(string_value_segment);
-//   c.append({2, "two"});
-
-//   auto base_segment = c.get_segment(ColumnID{0});
-//   EXPECT_EQ(base_segment->size(), 4u);
-// }
+class StorageChunkTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    int_value_segment = std::make_shared<ValueSegment<int32_t>>();
+    int_value_segment->append(4);
+    int_value_segment->append(6);
+    int_value_segment->append(3);
+
+    string_value_segment = std::make_shared<ValueSegment<std::string>>();
+    string_value_segment->append("Hello,");
+    string_value_segment->append("world");
+    string_value_segment->append("!");
+  }
+
+  Chunk c;
+  std::shared_ptr<BaseSegment> int_value_segment = nullptr;
+  std::shared_ptr<BaseSegment> string_value_segment = nullptr;
+};
+
+TEST_F(StorageChunkTest, AddSegmentToChunk) {
+  EXPECT_EQ(c.size(), 0u);
+  c.add_segment(int_value_segment);
+  c.add_segment(string_value_segment);
+  EXPECT_EQ(c.size(), 3u);
+}
+
+TEST_F(StorageChunkTest, AddValuesToChunk) {
+  c.add_segment(int_value_segment);
+  c.add_segment(string_value_segment);
+  c.append({2, "two"});
+  EXPECT_EQ(c.size(), 4u);
+
+  if constexpr (HYRISE_DEBUG) {
+    EXPECT_THROW(c.append({}), std::exception);
+    EXPECT_THROW(c.append({4, "val", 3}), std::exception);
+    EXPECT_EQ(c.size(), 4u);
+  }
+}
+
+TEST_F(StorageChunkTest, RetrieveSegment) {
+  c.add_segment(int_value_segment);
+  c.add_segment(string_value_segment);
+  c.append({2, "two"});
+
+  auto base_segment = c.get_segment(ColumnID{0});
+  EXPECT_EQ(base_segment->size(), 4u);
+}
+
+TEST_F(StorageChunkTest, TryAppendToMutableChunk) {
+  auto chunk = Chunk{ChunkOffset{3}};
+  chunk.add_segment(std::make_shared<ValueSegment<int32_t>>(ChunkOffset{3}));
+  chunk.add_segment(std::make_shared<ValueSegment<std::string>>(ChunkOffset{3}));
+  EXPECT_THROW(chunk.add_segment(std::make_shared<DictionarySegment<int32_t>>(int_value_segment)), std::logic_error);
+  EXPECT_TRUE(chunk.is_mutable());
+  EXPECT_EQ(chunk.size(), 0u);
+  EXPECT_EQ(chunk.get_segment(ColumnID{0})->size(), 0u);
+
+  EXPECT_TRUE(chunk.try_append(std::vector<AllTypeVariant>{1, "one"}));
+  // Values of other data types are converted
+  EXPECT_TRUE(chunk.try_append(std::vector<AllTypeVariant>{int64_t{2}, 2.5f}));
+  EXPECT_EQ(chunk.size(), 2u);
+  EXPECT_EQ((*chunk.get_segment(ColumnID{0}))[1], AllTypeVariant{2});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{1}))[1], AllTypeVariant{"2.5"});
+
+  const auto ids = std::vector<int32_t>{3, 4};
+  const auto names = std::vector<std::string>{"three", "four"};
+  EXPECT_EQ(chunk.try_append_columns({ids, names}, 0), 1u);
+  EXPECT_EQ(chunk.size(), 3u);
+  EXPECT_FALSE(chunk.try_append(std::vector<AllTypeVariant>{5, "five"}));
+  EXPECT_EQ(chunk.try_append_columns({ids, names}, 1), 0u);
+  EXPECT_EQ(chunk.size(), 3u);
+  EXPECT_EQ((*chunk.get_segment(ColumnID{1}))[2], AllTypeVariant{"three"});
+}
+
+// An int segment that fails to write negative values, i.e., after the row was reserved
+class FailingValueSegment : public BaseValueSegment {
+ public:
+  explicit FailingValueSegment(const ChunkOffset capacity) : _segment(capacity) {}
+
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const override { return _segment[chunk_offset]; }
+  TypedValue typed_value(const ChunkOffset chunk_offset) const override { return _segment.typed_value(chunk_offset); }
+  void append(const AllTypeVariant& value) override { _segment.append(value); }
+  void append(const TypedValue& value) override { _segment.append(value); }
+  ChunkOffset size() const override { return _segment.size(); }
+  size_t estimate_memory_usage() const override { return _segment.estimate_memory_usage(); }
+  size_t which() const override { return _segment.which(); }
+  AllTypeVariant convert(const TypedValue& value) const override { return _segment.convert(value); }
+  void write_values(const ChunkOffset chunk_offset, const ColumnSpan& values) override {
+    _segment.write_values(chunk_offset, values);
+  }
+  void write_defaults(const ChunkOffset first_row, const ChunkOffset end) noexcept override {
+    _segment.write_defaults(first_row, end);
+  }
+  void publish(const ChunkOffset size) override { _segment.publish(size); }
+
+  void write(const ChunkOffset chunk_offset, const TypedValue& value) override {
+    if (value.get<int32_t>() < 0) throw std::runtime_error{"Cannot write negative values"};
+    _segment.write(chunk_offset, value);
+  }
+
+ protected:
+  ValueSegment<int32_t> _segment;
+};
+
+TEST_F(StorageChunkTest, FailedAppendDoesNotBlockLaterAppends) {
+  auto chunk = Chunk{ChunkOffset{3}};
+  chunk.add_segment(std::make_shared<FailingValueSegment>(ChunkOffset{3}));
+  chunk.set_mvcc_data(std::make_shared<MvccData>(ChunkOffset{3}));
+
+  EXPECT_THROW(chunk.try_append(std::vector<AllTypeVariant>{-1}), std::runtime_error);
+  EXPECT_TRUE(chunk.try_append(std::vector<AllTypeVariant>{1}));
+  EXPECT_EQ(chunk.size(), 2u);
+
+  // The failed row is not visible to anybody
+  const auto& mvcc_data = *chunk.mvcc_data();
+  EXPECT_EQ(mvcc_data.invalid_row_count, 1u);
+  EXPECT_FALSE(mvcc_data.is_visible(ChunkOffset{0}, TransactionID{1}, CommitID{1}));
+  EXPECT_TRUE(mvcc_data.is_visible(ChunkOffset{1}, TransactionID{1}, CommitID{1}));
+}
+
+TEST_F(StorageChunkTest, FailedAppendHoldsDefaultValues) {
+  auto chunk = Chunk{ChunkOffset{3}};
+  chunk.add_segment(std::make_shared<ValueSegment<std::string>>(ChunkOffset{3}));
+  chunk.add_segment(std::make_shared<FailingValueSegment>(ChunkOffset{3}));
+
+  // The string is written before the second value fails, but readers do not see it without the rest of the row
+  EXPECT_THROW(chunk.try_append(std::vector<AllTypeVariant>{"written", -1}), std::runtime_error);
+  EXPECT_TRUE(chunk.try_append(std::vector<AllTypeVariant>{"b", 1}));
+  ASSERT_EQ(chunk.size(), 2u);
+  EXPECT_EQ((*chunk.get_segment(ColumnID{0}))[ChunkOffset{0}], AllTypeVariant{""});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{1}))[ChunkOffset{0}], AllTypeVariant{0});
+  EXPECT_EQ((*chunk.get_segment(ColumnID{0}))[ChunkOffset{1}], AllTypeVariant{"b"});
+}
 
 }  // namespace opossum
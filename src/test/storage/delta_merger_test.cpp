@@ -0,0 +1,105 @@
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/delta_merger.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class StorageDeltaMergerTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(4);
+    _table->add_column("a", "int");
+    _table->add_column("b", "string");
+  }
+
+  std::shared_ptr<Table> _table;
+};
+
+TEST_F(StorageDeltaMergerTest, MergesIncrementally) {
+  auto merger = DeltaMerger{_table};
+  EXPECT_EQ(merger.merge(), 0u);
+
+  _table->append({3, "c"});
+  _table->append({1, "a"});
+  EXPECT_EQ(merger.merge(), 0u);
+  _table->append({2, "b"});
+  EXPECT_EQ(merger.merge(), 0u);
+
+  // The chunk stays in the delta until it is full
+  EXPECT_TRUE(_table->get_chunk(ChunkID{0}).is_mutable());
+  _table->append({1, "d"});
+  _table->append({5, "e"});
+  EXPECT_EQ(merger.merge(), 1u);
+
+  ASSERT_EQ(_table->chunk_count(), 2u);
+  const auto& chunk = _table->get_chunk(ChunkID{0});
+  EXPECT_FALSE(chunk.is_mutable());
+  const auto ints = std::dynamic_pointer_cast<DictionarySegment<int32_t>>(chunk.get_segment(ColumnID{0}));
+  const auto strings = std::dynamic_pointer_cast<DictionarySegment<std::string>>(chunk.get_segment(ColumnID{1}));
+  ASSERT_TRUE(ints && strings);
+  EXPECT_EQ(*ints->dictionary(), (std::vector<int32_t>{1, 2, 3}));
+  EXPECT_EQ(*strings->dictionary(), (std::vector<std::string>{"a", "b", "c", "d"}));
+  EXPECT_EQ(ints->get(0), 3);
+  EXPECT_EQ(ints->get(3), 1);
+  EXPECT_EQ(strings->get(2), "b");
+  EXPECT_EQ(strings->get(3), "d");
+
+  EXPECT_TRUE(_table->get_chunk(ChunkID{1}).is_mutable());
+  EXPECT_EQ(_table->get_chunk(ChunkID{1}).size(), 1u);
+  EXPECT_EQ(merger.merge(), 0u);
+}
+
+TEST_F(StorageDeltaMergerTest, MergesWhileRowsAreAppended) {
+  constexpr auto ROW_COUNT = 20'000;
+  auto table = std::make_shared<Table>(1'000);
+  table->add_column("id", "int");
+  auto merger = DeltaMerger{table};
+
+  auto done = std::atomic<bool>{false};
+  auto appender = std::thread{[&]() {
+    for (auto id = 0; id < ROW_COUNT; ++id) table->append({id % 700});
+    done = true;
+  }};
+  // Readers pin the chunks, so they can keep reading chunks that are replaced meanwhile
+  auto reader = std::thread{[&]() {
+    while (!done) {
+      for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+        const auto chunk = table->pin_chunk(chunk_id);
+        const auto chunk_size = chunk->size();
+        segment_iterate<int32_t>(*chunk->get_segment(ColumnID{0}), chunk_size,
+                                 [&](const auto value, const auto chunk_offset) {
+                                   ASSERT_EQ(value, static_cast<int32_t>((chunk_id * 1'000 + chunk_offset) % 700));
+                                 });
+      }
+    }
+  }};
+  auto moved_chunk_count = size_t{0};
+  while (!done) moved_chunk_count += merger.merge();
+  appender.join();
+  reader.join();
+  moved_chunk_count += merger.merge();
+
+  EXPECT_EQ(moved_chunk_count, 20u);
+  for (auto chunk_id = ChunkID{0}; chunk_id < ChunkID{20}; ++chunk_id) {
+    const auto segment =
+        std::dynamic_pointer_cast<DictionarySegment<int32_t>>(table->get_chunk(chunk_id).get_segment(ColumnID{0}));
+    ASSERT_TRUE(segment);
+    ASSERT_EQ(segment->size(), 1'000u);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < segment->size(); ++chunk_offset) {
+      ASSERT_EQ(segment->get(chunk_offset), static_cast<int32_t>((chunk_id * 1'000 + chunk_offset) % 700));
+    }
+  }
+}
+
+}  // namespace opossum
@@ -1,5 +1,6 @@
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "../base_test.hpp"
 #include "gtest/gtest.h"
@@ -11,61 +12,102 @@
 
 namespace opossum {
 
-// class StorageDictionarySegmentTest : public BaseTest {
-//  protected:
-//   std::shared_ptr<ValueSegment<int>> vc_int = std::make_shared<ValueSegment<int>>();
-//   std::shared_ptr<ValueSegment<std::string>> vc_str = std::make_shared<ValueSegment<std::string>>();
-// };
-
-// TEST_F(StorageDictionarySegmentTest, CompressSegmentString) {
-//   vc_str->append("Bill");
-//   vc_str->append("Steve");
-//   vc_str->append("Alexander");
-//   vc_str->append("Steve");
-//   vc_str->append("Hasso");
-//   vc_str->append("Bill");
-
-//   std::shared_ptr<BaseSegment> col;
-//   resolve_data_type("string", [&](auto type) {
-//     using Type = typename decltype(type)::type;
-//     col = std::make_shared<DictionarySegment<Type>>(vc_str);
-//   });
-
-//   auto dict_col = std::dynamic_pointer_cast<DictionarySegment<std::string>>(col);
-
-//   // Test attribute_vector size
-//   EXPECT_EQ(dict_col->size(), 6u);
-
-//   // Test dictionary size (uniqueness)
-//   EXPECT_EQ(dict_col->unique_values_count(), 4u);
-
-//   // Test sorting
-//   auto dict = dict_col->dictionary();
-//   EXPECT_EQ((*dict)[0], "Alexander");
-//   EXPECT_EQ((*dict)[1], "Bill");
-//   EXPECT_EQ((*dict)[2], "Hasso");
-//   EXPECT_EQ((*dict)[3], "Steve");
-// }
-
-// TEST_F(StorageDictionarySegmentTest, LowerUpperBound) {
-//   for (int i = 0; i <= 10; i += 2) vc_int->append(i);
-
-//   std::shared_ptr<BaseSegment> col;
-//   resolve_data_type("int", [&](auto type) {
-//     using Type = typename decltype(type)::type;
-//     col = std::make_shared<DictionarySegment<Type>>(vc_int);
-//   });
-//   auto dict_col = std::dynamic_pointer_cast<DictionarySegment<int>>(col);
-
-//   EXPECT_EQ(dict_col->lower_bound(4), (ValueID)2);
-//   EXPECT_EQ(dict_col->upper_bound(4), (ValueID)3);
-
-//   EXPECT_EQ(dict_col->lower_bound(5), (ValueID)3);
-//   EXPECT_EQ(dict_col->upper_bound(5), (ValueID)3);
-
-//   EXPECT_EQ(dict_col->lower_bound(15), INVALID_VALUE_ID);
-//   EXPECT_EQ(dict_col->upper_bound(15), INVALID_VALUE_ID);
-// }
+class StorageDictionarySegmentTest : public BaseTest {
+ protected:
+  std::shared_ptr<ValueSegment<int>> vc_int = std::make_shared<ValueSegment<int>>();
+  std::shared_ptr<ValueSegment<std::string>> vc_str = std::make_shared<ValueSegment<std::string>>();
+};
+
+TEST_F(StorageDictionarySegmentTest, CompressSegmentString) {
+  vc_str->append("Bill");
+  vc_str->append("Steve");
+  vc_str->append("Alexander");
+  vc_str->append("Steve");
+  vc_str->append("Hasso");
+  vc_str->append("Bill");
+
+  std::shared_ptr<BaseSegment> col;
+  resolve_data_type("string", [&](auto type) {
+    using Type = typename decltype(type)::type;
+    col = std::make_shared<DictionarySegment<Type>>(vc_str);
+  });
+
+  auto dict_col = std::dynamic_pointer_cast<DictionarySegment<std::string>>(col);
+
+  // Test attribute_vector size
+  EXPECT_EQ(dict_col->size(), 6u);
+
+  // Test dictionary size (uniqueness)
+  EXPECT_EQ(dict_col->unique_values_count(), 4u);
+
+  // Test sorting
+  auto dict = dict_col->dictionary();
+  EXPECT_EQ((*dict)[0], "Alexander");
+  EXPECT_EQ((*dict)[1], "Bill");
+  EXPECT_EQ((*dict)[2], "Hasso");
+  EXPECT_EQ((*dict)[3], "Steve");
+}
+
+TEST_F(StorageDictionarySegmentTest, LowerUpperBound) {
+  for (int i = 0; i <= 10; i += 2) vc_int->append(i);
+
+  std::shared_ptr<BaseSegment> col;
+  resolve_data_type("int", [&](auto type) {
+    using Type = typename decltype(type)::type;
+    col = std::make_shared<DictionarySegment<Type>>(vc_int);
+  });
+  auto dict_col = std::dynamic_pointer_cast<DictionarySegment<int>>(col);
+
+  EXPECT_EQ(dict_col->lower_bound(4), (ValueID)2);
+  EXPECT_EQ(dict_col->upper_bound(4), (ValueID)3);
+
+  EXPECT_EQ(dict_col->lower_bound(5), (ValueID)3);
+  EXPECT_EQ(dict_col->upper_bound(5), (ValueID)3);
+
+  EXPECT_EQ(dict_col->lower_bound(15), INVALID_VALUE_ID);
+  EXPECT_EQ(dict_col->upper_bound(15), INVALID_VALUE_ID);
+}
+
+TEST_F(StorageDictionarySegmentTest, MergeDelta) {
+  for (const auto* value : {"Steve", "Bill", "Steve", "Hasso"}) vc_str->append(value);
+  const auto main = DictionarySegment<std::string>{vc_str};
+
+  const auto delta = std::vector<std::string>{"Alexander", "Steve", "Martin", "Alexander"};
+  const auto merged = DictionarySegment<std::string>{main, delta};
+
+  EXPECT_EQ(*merged.dictionary(), (std::vector<std::string>{"Alexander", "Bill", "Hasso", "Martin", "Steve"}));
+  ASSERT_EQ(merged.size(), 8u);
+  const auto expected_values =
+      std::vector<std::string>{"Steve", "Bill", "Steve", "Hasso", "Alexander", "Steve", "Martin", "Alexander"};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < merged.size(); ++chunk_offset) {
+    EXPECT_EQ(merged.get(chunk_offset), expected_values[chunk_offset]);
+  }
+
+  // Merging an empty delta keeps the values, and merging into an empty main encodes the delta
+  const auto unchanged = DictionarySegment<std::string>{merged, std::span<const std::string>{}};
+  EXPECT_EQ(*unchanged.dictionary(), *merged.dictionary());
+  EXPECT_EQ(unchanged.get(6), "Martin");
+  const auto from_empty = DictionarySegment<std::string>{DictionarySegment<std::string>{delta}, delta};
+  EXPECT_EQ(from_empty.unique_values_count(), 3u);
+  EXPECT_EQ(from_empty.get(5), "Steve");
+}
+
+TEST_F(StorageDictionarySegmentTest, ShareDictionary) {
+  for (const auto* value : {"Steve", "Bill", "Steve"}) vc_str->append(value);
+  const auto segment = DictionarySegment<std::string>{vc_str};
+  const auto dictionary_values = std::vector<std::string>{"Alexander", "Bill", "Steve"};
+  const auto dictionary_segment = DictionarySegment<std::string>{dictionary_values};
+
+  const auto shared = DictionarySegment<std::string>{segment, dictionary_segment};
+  EXPECT_EQ(shared.dictionary(), dictionary_segment.dictionary());
+  ASSERT_EQ(shared.size(), 3u);
+  EXPECT_EQ(shared.get(0), "Steve");
+  EXPECT_EQ(shared.get(1), "Bill");
+  EXPECT_EQ(shared.attribute_vector()->get(2), ValueID{2});
+
+  const auto missing_values = DictionarySegment<std::string>{std::vector<std::string>{"Bill", "Hasso"}};
+  EXPECT_THROW((DictionarySegment<std::string>{segment, missing_values}), std::logic_error);
+}
 
 // TODO(student): You should add some more tests here (full coverage would be appreciated) and possibly in other files.
 
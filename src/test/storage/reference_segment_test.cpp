@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <iostream>
 #include <map>
 #include <memory>
@@ -20,77 +21,127 @@
 
 namespace opossum {
 
-// class ReferenceSegmentTest : public BaseTest {
-//   virtual void SetUp() {
-//     _test_table = std::make_shared<opossum::Table>(opossum::Table(3));
-//     _test_table->add_column("a", "int");
-//     _test_table->add_column("b", "float");
-//     _test_table->append({123, 456.7f});
-//     _test_table->append({1234, 457.7f});
-//     _test_table->append({12345, 458.7f});
-//     _test_table->append({54321, 458.7f});
-//     _test_table->append({12345, 458.7f});
-
-//     _test_table_dict = std::make_shared<opossum::Table>(5);
-//     _test_table_dict->add_column("a", "int");
-//     _test_table_dict->add_column("b", "int");
-//     for (int i = 0; i <= 24; i += 2) _test_table_dict->append({i, 100 + i});
-
-//     _test_table_dict->compress_chunk(ChunkID(0));
-//     _test_table_dict->compress_chunk(ChunkID(1));
-
-//     StorageManager::get().add_table("test_table_dict", _test_table_dict);
-//   }
-
-//  public:
-//   std::shared_ptr<opossum::Table> _test_table, _test_table_dict;
-// };
-
-// TEST_F(ReferenceSegmentTest, IsImmutable) {
-//   auto pos_list =
-//       std::make_shared<PosList>(std::initializer_list<RowID>({{ChunkID{0}, 0}, {ChunkID{0}, 1}, {ChunkID{0}, 2}}));
-//   auto reference_segment = ReferenceSegment(_test_table, ColumnID{0}, pos_list);
-
-//   EXPECT_THROW(reference_segment.append(1), std::logic_error);
-// }
-
-// TEST_F(ReferenceSegmentTest, RetrievesValues) {
-//   // PosList with (0, 0), (0, 1), (0, 2)
-//   auto pos_list = std::make_shared<PosList>(
-//       std::initializer_list<RowID>({RowID{ChunkID{0}, 0}, RowID{ChunkID{0}, 1}, RowID{ChunkID{0}, 2}}));
-//   auto reference_segment = ReferenceSegment(_test_table, ColumnID{0}, pos_list);
-
-//   auto& column = *(_test_table->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
-
-//   EXPECT_EQ(reference_segment[0], column[0]);
-//   EXPECT_EQ(reference_segment[1], column[1]);
-//   EXPECT_EQ(reference_segment[2], column[2]);
-// }
-
-// TEST_F(ReferenceSegmentTest, RetrievesValuesOutOfOrder) {
-//   // PosList with (0, 1), (0, 2), (0, 0)
-//   auto pos_list = std::make_shared<PosList>(
-//       std::initializer_list<RowID>({RowID{ChunkID{0}, 1}, RowID{ChunkID{0}, 2}, RowID{ChunkID{0}, 0}}));
-//   auto reference_segment = ReferenceSegment(_test_table, ColumnID{0}, pos_list);
-
-//   auto& column = *(_test_table->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
-
-//   EXPECT_EQ(reference_segment[0], column[1]);
-//   EXPECT_EQ(reference_segment[1], column[2]);
-//   EXPECT_EQ(reference_segment[2], column[0]);
-// }
-
-// TEST_F(ReferenceSegmentTest, RetrievesValuesFromChunks) {
-//   // PosList with (0, 2), (1, 0), (1, 1)
-//   auto pos_list = std::make_shared<PosList>(
-//       std::initializer_list<RowID>({RowID{ChunkID{0}, 2}, RowID{ChunkID{1}, 0}, RowID{ChunkID{1}, 1}}));
-//   auto reference_segment = ReferenceSegment(_test_table, ColumnID{0}, pos_list);
-
-//   auto& column_1 = *(_test_table->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
-//   auto& column_2 = *(_test_table->get_chunk(ChunkID{1}).get_segment(ColumnID{0}));
-
-//   EXPECT_EQ(reference_segment[0], column_1[2]);
-//   EXPECT_EQ(reference_segment[2], column_2[1]);
-// }
+class ReferenceSegmentTest : public BaseTest {
+  virtual void SetUp() {
+    _test_table = std::make_shared<opossum::Table>(opossum::Table(3));
+    _test_table->add_column("a", "int");
+    _test_table->add_column("b", "float");
+    _test_table->append({123, 456.7f});
+    _test_table->append({1234, 457.7f});
+    _test_table->append({12345, 458.7f});
+    _test_table->append({54321, 458.7f});
+    _test_table->append({12345, 458.7f});
+
+    _test_table_dict = std::make_shared<opossum::Table>(5);
+    _test_table_dict->add_column("a", "int");
+    _test_table_dict->add_column("b", "int");
+    for (int i = 0; i <= 24; i += 2) _test_table_dict->append({i, 100 + i});
+
+    _test_table_dict->compress_chunk(ChunkID(0));
+    _test_table_dict->compress_chunk(ChunkID(1));
+
+    StorageManager::get().add_table("test_table_dict", _test_table_dict);
+  }
+
+ public:
+  std::shared_ptr<opossum::Table> _test_table, _test_table_dict;
+};
+
+TEST_F(ReferenceSegmentTest, IsImmutable) {
+  auto pos_list =
+      std::make_shared<PosList>(std::initializer_list<RowID>({{ChunkID{0}, 0}, {ChunkID{0}, 1}, {ChunkID{0}, 2}}));
+  auto reference_segment = ReferenceSegment(_test_table, ColumnID{0}, pos_list);
+
+  EXPECT_THROW(reference_segment.append(1), std::logic_error);
+}
+
+TEST_F(ReferenceSegmentTest, RetrievesValues) {
+  // PosList with (0, 0), (0, 1), (0, 2)
+  auto pos_list = std::make_shared<PosList>(
+      std::initializer_list<RowID>({RowID{ChunkID{0}, 0}, RowID{ChunkID{0}, 1}, RowID{ChunkID{0}, 2}}));
+  auto reference_segment = ReferenceSegment(_test_table, ColumnID{0}, pos_list);
+
+  auto& column = *(_test_table->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+
+  EXPECT_EQ(reference_segment[0], column[0]);
+  EXPECT_EQ(reference_segment[1], column[1]);
+  EXPECT_EQ(reference_segment[2], column[2]);
+}
+
+TEST_F(ReferenceSegmentTest, RetrievesValuesOutOfOrder) {
+  // PosList with (0, 1), (0, 2), (0, 0)
+  auto pos_list = std::make_shared<PosList>(
+      std::initializer_list<RowID>({RowID{ChunkID{0}, 1}, RowID{ChunkID{0}, 2}, RowID{ChunkID{0}, 0}}));
+  auto reference_segment = ReferenceSegment(_test_table, ColumnID{0}, pos_list);
+
+  auto& column = *(_test_table->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+
+  EXPECT_EQ(reference_segment[0], column[1]);
+  EXPECT_EQ(reference_segment[1], column[2]);
+  EXPECT_EQ(reference_segment[2], column[0]);
+}
+
+TEST_F(ReferenceSegmentTest, RetrievesValuesFromChunks) {
+  // PosList with (0, 2), (1, 0), (1, 1)
+  auto pos_list = std::make_shared<PosList>(
+      std::initializer_list<RowID>({RowID{ChunkID{0}, 2}, RowID{ChunkID{1}, 0}, RowID{ChunkID{1}, 1}}));
+  auto reference_segment = ReferenceSegment(_test_table, ColumnID{0}, pos_list);
+
+  auto& column_1 = *(_test_table->get_chunk(ChunkID{0}).get_segment(ColumnID{0}));
+  auto& column_2 = *(_test_table->get_chunk(ChunkID{1}).get_segment(ColumnID{0}));
+
+  EXPECT_EQ(reference_segment[0], column_1[2]);
+  EXPECT_EQ(reference_segment[2], column_2[1]);
+}
+
+TEST_F(ReferenceSegmentTest, GatherRuns) {
+  auto pos_list = std::make_shared<PosList>();
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 5; ++chunk_offset) {
+    pos_list->emplace_back(RowID{ChunkID{0}, chunk_offset});
+    pos_list->emplace_back(RowID{ChunkID{1}, static_cast<ChunkOffset>(4 - chunk_offset)});
+  }
+  std::stable_sort(pos_list->begin(), pos_list->end(),
+                   [](const auto& lhs, const auto& rhs) { return lhs.chunk_id < rhs.chunk_id; });
+  auto reference_segment = ReferenceSegment(_test_table_dict, ColumnID{1}, pos_list);
+
+  for (const auto prefetch_distance : {size_t{0}, size_t{2}, ReferenceSegment::DEFAULT_PREFETCH_DISTANCE}) {
+    auto values = std::vector<int32_t>(reference_segment.size());
+    reference_segment.gather(values.data(), prefetch_distance);
+    EXPECT_EQ(values, std::vector<int32_t>({100, 102, 104, 106, 108, 118, 116, 114, 112, 110}));
+  }
+}
+
+TEST_F(ReferenceSegmentTest, GatherScatteredPositions) {
+  // Every position is in another chunk than the previous one, so the positions are grouped by chunk first
+  _test_table_dict->compress_chunk(ChunkID{2});
+  auto pos_list = std::make_shared<PosList>();
+  auto expected = std::vector<int32_t>{};
+  for (auto row = 0; row < 13; ++row) {
+    const auto chunk_id = ChunkID{static_cast<ChunkID::base_type>(row % 3)};
+    const auto chunk_offset = static_cast<ChunkOffset>((row * 7) % 3);
+    pos_list->emplace_back(RowID{chunk_id, chunk_offset});
+    expected.push_back(2 * static_cast<int32_t>(chunk_id * 5 + chunk_offset));
+  }
+  auto reference_segment = ReferenceSegment(_test_table_dict, ColumnID{0}, pos_list);
+
+  auto values = std::vector<int32_t>(reference_segment.size());
+  reference_segment.gather(values.data(), 3);
+  EXPECT_EQ(values, expected);
+}
+
+TEST_F(ReferenceSegmentTest, GatherStrings) {
+  auto table = std::make_shared<Table>(2);
+  table->add_column("s", "string");
+  for (const auto& value : {"a", "b", "c", "d", "e"}) table->append({value});
+  table->compress_chunk(ChunkID{1});
+
+  auto pos_list = std::make_shared<PosList>(
+      PosList{RowID{ChunkID{2}, 0}, RowID{ChunkID{0}, 1}, RowID{ChunkID{1}, 1}, RowID{ChunkID{0}, 0}});
+  auto reference_segment = ReferenceSegment(table, ColumnID{0}, pos_list);
+
+  auto values = std::vector<std::string>(reference_segment.size());
+  reference_segment.gather(values.data());
+  EXPECT_EQ(values, std::vector<std::string>({"e", "b", "d", "a"}));
+}
 
 }  // namespace opossum
@@ -1,4 +1,8 @@
+#include <atomic>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "../base_test.hpp"
 #include "gtest/gtest.h"
@@ -8,46 +12,86 @@
 
 namespace opossum {
 
-// class StorageStorageManagerTest : public BaseTest {
-//  protected:
-//   void SetUp() override {
-//     auto& sm = StorageManager::get();
-//     auto t1 = std::make_shared<Table>();
-//     auto t2 = std::make_shared<Table>(4);
-
-//     sm.add_table("first_table", t1);
-//     sm.add_table("second_table", t2);
-//   }
-// };
-
-// TEST_F(StorageStorageManagerTest, GetTable) {
-//   auto& sm = StorageManager::get();
-//   auto t3 = sm.get_table("first_table");
-//   auto t4 = sm.get_table("second_table");
-//   EXPECT_THROW(sm.get_table("third_table"), std::exception);
-// }
-
-// TEST_F(StorageStorageManagerTest, DropTable) {
-//   auto& sm = StorageManager::get();
-//   sm.drop_table("first_table");
-//   EXPECT_THROW(sm.get_table("first_table"), std::exception);
-//   EXPECT_THROW(sm.drop_table("first_table"), std::exception);
-// }
-
-// TEST_F(StorageStorageManagerTest, ResetTable) {
-//   StorageManager::get().reset();
-//   auto& sm = StorageManager::get();
-//   EXPECT_THROW(sm.get_table("first_table"), std::exception);
-// }
-
-// TEST_F(StorageStorageManagerTest, DoesNotHaveTable) {
-//   auto& sm = StorageManager::get();
-//   EXPECT_EQ(sm.has_table("third_table"), false);
-// }
-
-// TEST_F(StorageStorageManagerTest, HasTable) {
-//   auto& sm = StorageManager::get();
-//   EXPECT_EQ(sm.has_table("first_table"), true);
-// }
+class StorageStorageManagerTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    auto& sm = StorageManager::get();
+    auto t1 = std::make_shared<Table>();
+    auto t2 = std::make_shared<Table>(4);
+
+    sm.add_table("first_table", t1);
+    sm.add_table("second_table", t2);
+  }
+};
+
+TEST_F(StorageStorageManagerTest, GetTable) {
+  auto& sm = StorageManager::get();
+  auto t3 = sm.get_table("first_table");
+  auto t4 = sm.get_table("second_table");
+  EXPECT_THROW(sm.get_table("third_table"), std::exception);
+}
+
+TEST_F(StorageStorageManagerTest, DropTable) {
+  auto& sm = StorageManager::get();
+  sm.drop_table("first_table");
+  EXPECT_THROW(sm.get_table("first_table"), std::exception);
+  EXPECT_THROW(sm.drop_table("first_table"), std::exception);
+}
+
+TEST_F(StorageStorageManagerTest, ResetTable) {
+  StorageManager::get().reset();
+  auto& sm = StorageManager::get();
+  EXPECT_THROW(sm.get_table("first_table"), std::exception);
+}
+
+TEST_F(StorageStorageManagerTest, DoesNotHaveTable) {
+  auto& sm = StorageManager::get();
+  EXPECT_EQ(sm.has_table("third_table"), false);
+}
+
+TEST_F(StorageStorageManagerTest, HasTable) {
+  auto& sm = StorageManager::get();
+  EXPECT_EQ(sm.has_table("first_table"), true);
+}
+
+TEST_F(StorageStorageManagerTest, DroppedTableStaysAliveWhileHeld) {
+  auto& sm = StorageManager::get();
+  const auto table = sm.get_table("second_table");
+  sm.drop_table("second_table");
+  EXPECT_FALSE(sm.has_table("second_table"));
+  EXPECT_EQ(table->target_chunk_size(), 4u);
+
+  sm.add_table("second_table", std::make_shared<Table>(8));
+  EXPECT_EQ(sm.get_table("second_table")->target_chunk_size(), 8u);
+}
+
+TEST_F(StorageStorageManagerTest, ConcurrentLookupsAndChanges) {
+  auto& sm = StorageManager::get();
+  const auto first_table = sm.get_table("first_table");
+  auto done = std::atomic<bool>{false};
+  auto failed_lookups = std::atomic<size_t>{0};
+
+  auto readers = std::vector<std::thread>{};
+  for (auto reader_index = 0; reader_index < 64; ++reader_index) {
+    readers.emplace_back([&]() {
+      while (!done) {
+        if (sm.get_table("first_table") != first_table) ++failed_lookups;
+        if (sm.has_table("dropped_table")) ++failed_lookups;
+      }
+    });
+  }
+
+  for (auto table_index = 0; table_index < 200; ++table_index) {
+    const auto name = "table_" + std::to_string(table_index);
+    sm.add_table(name, std::make_shared<Table>());
+    EXPECT_TRUE(sm.has_table(name));
+    if (table_index % 2 == 0) sm.drop_table(name);
+  }
+  done = true;
+  for (auto& reader : readers) reader.join();
+
+  EXPECT_EQ(failed_lookups, 0u);
+  EXPECT_EQ(sm.table_names().size(), 102u);
+}
 
 }  // namespace opossum
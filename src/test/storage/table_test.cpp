@@ -1,6 +1,9 @@
+#include <atomic>
 #include <limits>
 #include <memory>
+#include <span>
 #include <string>
+#include <thread>
 #include <utility>
 #include <vector>
 
@@ -8,67 +11,222 @@
 #include "gtest/gtest.h"
 
 #include "../lib/resolve_type.hpp"
+#include "../lib/storage/dictionary_segment.hpp"
 #include "../lib/storage/table.hpp"
+#include "../lib/storage/value_segment.hpp"
 
 namespace opossum {
 
-// class StorageTableTest : public BaseTest {
-//  protected:
-//   void SetUp() override {
-//     t.add_column("col_1", "int");
-//     t.add_column("col_2", "string");
-//   }
-
-//   Table t{2};
-// };
-
-// TEST_F(StorageTableTest, ChunkCount) {
-//   EXPECT_EQ(t.chunk_count(), 1u);
-//   t.append({4, "Hello,"});
-//   t.append({6, "world"});
-//   t.append({3, "!"});
-//   EXPECT_EQ(t.chunk_count(), 2u);
-// }
-
-// TEST_F(StorageTableTest, GetChunk) {
-//   t.get_chunk(ChunkID{0});
-//   // TODO(anyone): Do we want checks here?
-//   // EXPECT_THROW(t.get_chunk(ChunkID{q}), std::exception);
-//   t.append({4, "Hello,"});
-//   t.append({6, "world"});
-//   t.append({3, "!"});
-//   t.get_chunk(ChunkID{1});
-// }
-
-// TEST_F(StorageTableTest, ColumnCount) { EXPECT_EQ(t.column_count(), 2u); }
-
-// TEST_F(StorageTableTest, RowCount) {
-//   EXPECT_EQ(t.row_count(), 0u);
-//   t.append({4, "Hello,"});
-//   t.append({6, "world"});
-//   t.append({3, "!"});
-//   EXPECT_EQ(t.row_count(), 3u);
-// }
-
-// TEST_F(StorageTableTest, GetColumnName) {
-//   EXPECT_EQ(t.column_name(ColumnID{0}), "col_1");
-//   EXPECT_EQ(t.column_name(ColumnID{1}), "col_2");
-//   // TODO(anyone): Do we want checks here?
-//   // EXPECT_THROW(t.column_name(ColumnID{2}), std::exception);
-// }
-
-// TEST_F(StorageTableTest, GetColumnType) {
-//   EXPECT_EQ(t.column_type(ColumnID{0}), "int");
-//   EXPECT_EQ(t.column_type(ColumnID{1}), "string");
-//   // TODO(anyone): Do we want checks here?
-//   // EXPECT_THROW(t.column_type(ColumnID{2}), std::exception);
-// }
-
-// TEST_F(StorageTableTest, GetColumnIdByName) {
-//   EXPECT_EQ(t.column_id_by_name("col_2"), 1u);
-//   EXPECT_THROW(t.column_id_by_name("no_column_name"), std::exception);
-// }
-
-// TEST_F(StorageTableTest, GetChunkSize) { EXPECT_EQ(t.target_chunk_size(), 2u); }
+class StorageTableTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    t.add_column("col_1", "int");
+    t.add_column("col_2", "string");
+  }
+
+  Table t{2};
+};
+
+TEST_F(StorageTableTest, ChunkCount) {
+  EXPECT_EQ(t.chunk_count(), 1u);
+  t.append({4, "Hello,"});
+  t.append({6, "world"});
+  t.append({3, "!"});
+  EXPECT_EQ(t.chunk_count(), 2u);
+}
+
+TEST_F(StorageTableTest, MutableChunksGrow) {
+  auto table = Table{};
+  table.add_column("id", "int");
+  EXPECT_EQ(table.get_chunk(ChunkID{0}).capacity(), Table::INITIAL_MUTABLE_CHUNK_SIZE);
+
+  auto ids = std::vector<int32_t>(Table::INITIAL_MUTABLE_CHUNK_SIZE * 7);
+  table.append_columns({ids});
+  ASSERT_EQ(table.chunk_count(), 3u);
+  EXPECT_EQ(table.get_chunk(ChunkID{1}).capacity(), 2 * Table::INITIAL_MUTABLE_CHUNK_SIZE);
+  EXPECT_EQ(table.get_chunk(ChunkID{2}).capacity(), 4 * Table::INITIAL_MUTABLE_CHUNK_SIZE);
+
+  // The capacity is limited by the target chunk size
+  auto small_table = Table{3};
+  small_table.add_column("id", "int");
+  EXPECT_EQ(small_table.get_chunk(ChunkID{0}).capacity(), 3u);
+}
+
+TEST_F(StorageTableTest, GetChunk) {
+  t.get_chunk(ChunkID{0});
+  // TODO(anyone): Do we want checks here?
+  // EXPECT_THROW(t.get_chunk(ChunkID{q}), std::exception);
+  t.append({4, "Hello,"});
+  t.append({6, "world"});
+  t.append({3, "!"});
+  t.get_chunk(ChunkID{1});
+}
+
+TEST_F(StorageTableTest, ColumnCount) { EXPECT_EQ(t.column_count(), 2u); }
+
+TEST_F(StorageTableTest, RowCount) {
+  EXPECT_EQ(t.row_count(), 0u);
+  t.append({4, "Hello,"});
+  t.append({6, "world"});
+  t.append({3, "!"});
+  EXPECT_EQ(t.row_count(), 3u);
+}
+
+TEST_F(StorageTableTest, GetColumnName) {
+  EXPECT_EQ(t.column_name(ColumnID{0}), "col_1");
+  EXPECT_EQ(t.column_name(ColumnID{1}), "col_2");
+  // TODO(anyone): Do we want checks here?
+  // EXPECT_THROW(t.column_name(ColumnID{2}), std::exception);
+}
+
+TEST_F(StorageTableTest, GetColumnType) {
+  EXPECT_EQ(t.column_type(ColumnID{0}), "int");
+  EXPECT_EQ(t.column_type(ColumnID{1}), "string");
+  // TODO(anyone): Do we want checks here?
+  // EXPECT_THROW(t.column_type(ColumnID{2}), std::exception);
+}
+
+TEST_F(StorageTableTest, GetColumnIdByName) {
+  EXPECT_EQ(t.column_id_by_name("col_2"), 1u);
+  EXPECT_THROW(t.column_id_by_name("no_column_name"), std::exception);
+}
+
+TEST_F(StorageTableTest, GetChunkSize) { EXPECT_EQ(t.target_chunk_size(), 2u); }
+
+TEST_F(StorageTableTest, AppendColumns) {
+  t.append({1, "first"});
+
+  const auto ids = std::vector<int32_t>{2, 3, 4, 5, 6};
+  const auto names = std::vector<std::string>{"b", "c", "d", "e", "f"};
+  t.append_columns({ids, names});
+  EXPECT_EQ(t.row_count(), 6u);
+  EXPECT_EQ(t.chunk_count(), 3u);
+  EXPECT_EQ(t.get_chunk(ChunkID{0}).size(), 2u);
+  EXPECT_EQ((*t.get_chunk(ChunkID{0}).get_segment(ColumnID{0}))[1], AllTypeVariant{2});
+  EXPECT_EQ((*t.get_chunk(ChunkID{2}).get_segment(ColumnID{1}))[1], AllTypeVariant{"f"});
+
+  // Subspans of a larger buffer work as well
+  t.append_columns({std::span<const int32_t>{ids}.subspan(4), std::span<const std::string>{names}.last(1)});
+  EXPECT_EQ(t.row_count(), 7u);
+  EXPECT_EQ((*t.get_chunk(ChunkID{3}).get_segment(ColumnID{0}))[0], AllTypeVariant{6});
+}
+
+TEST_F(StorageTableTest, AppendColumnsChecksColumns) {
+  const auto ids = std::vector<int32_t>{1, 2};
+  const auto long_ids = std::vector<int64_t>{1, 2};
+  const auto names = std::vector<std::string>{"a"};
+  EXPECT_THROW(t.append_columns({ids}), std::logic_error);
+  EXPECT_THROW(t.append_columns({ids, names}), std::logic_error);
+  EXPECT_THROW(t.append_columns({long_ids, std::vector<std::string>{"a", "b"}}), std::logic_error);
+  EXPECT_EQ(t.row_count(), 0u);
+}
+
+TEST_F(StorageTableTest, GlobalDictionary) {
+  for (const auto* name : {"Bill", "Steve", "Hasso", "Bill", "Steve", "Hasso"}) t.append({1, name});
+  t.compress_chunk(ChunkID{0});
+  t.compress_chunk(ChunkID{1});
+  const auto dictionary_of = [&](const ChunkID chunk_id) {
+    return std::dynamic_pointer_cast<DictionarySegment<std::string>>(t.get_chunk(chunk_id).get_segment(ColumnID{1}))
+        ->dictionary();
+  };
+  EXPECT_NE(dictionary_of(ChunkID{0}), dictionary_of(ChunkID{1}));
+
+  // The mutable last chunk keeps its ValueSegment
+  EXPECT_FALSE(t.has_global_dictionary(ColumnID{1}));
+  t.use_global_dictionary(ColumnID{1});
+  EXPECT_TRUE(t.has_global_dictionary(ColumnID{1}));
+  EXPECT_EQ(dictionary_of(ChunkID{0}), dictionary_of(ChunkID{1}));
+  EXPECT_EQ(*dictionary_of(ChunkID{0}), (std::vector<std::string>{"Bill", "Hasso", "Steve"}));
+  EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<std::string>>(t.get_chunk(ChunkID{2}).get_segment(ColumnID{1})));
+  const auto expected_names = std::vector<std::string>{"Bill", "Steve", "Hasso", "Bill", "Steve", "Hasso"};
+  for (auto row = size_t{0}; row < expected_names.size(); ++row) {
+    const auto& chunk = t.get_chunk(ChunkID{static_cast<ChunkID::base_type>(row / 2)});
+    EXPECT_EQ((*chunk.get_segment(ColumnID{1}))[row % 2], AllTypeVariant{expected_names[row]});
+    EXPECT_EQ((*chunk.get_segment(ColumnID{0}))[row % 2], AllTypeVariant{1});
+  }
+
+  // Chunks that are compressed later use the global dictionary if it contains their values
+  t.compress_chunk(ChunkID{2});
+  EXPECT_EQ(dictionary_of(ChunkID{2}), dictionary_of(ChunkID{0}));
+  t.append({2, "Alexander"});
+  t.append({3, "Bill"});
+  t.compress_chunk(ChunkID{3});
+  EXPECT_NE(dictionary_of(ChunkID{3}), dictionary_of(ChunkID{0}));
+  EXPECT_EQ((*t.get_chunk(ChunkID{3}).get_segment(ColumnID{1}))[0], AllTypeVariant{"Alexander"});
+
+  // Using the global dictionary again adds the new values
+  t.use_global_dictionary(ColumnID{1});
+  EXPECT_EQ(*dictionary_of(ChunkID{3}), (std::vector<std::string>{"Alexander", "Bill", "Hasso", "Steve"}));
+  for (auto chunk_id = ChunkID{0}; chunk_id < ChunkID{3}; ++chunk_id) {
+    EXPECT_EQ(dictionary_of(chunk_id), dictionary_of(ChunkID{3}));
+  }
+  EXPECT_EQ((*t.get_chunk(ChunkID{3}).get_segment(ColumnID{1}))[1], AllTypeVariant{"Bill"});
+  EXPECT_EQ((*t.get_chunk(ChunkID{1}).get_segment(ColumnID{1}))[0], AllTypeVariant{"Hasso"});
+}
+
+TEST_F(StorageTableTest, ConcurrentAppends) {
+  auto table = Table{1'000};
+  table.add_column("id", "int");
+  table.add_column("double_id", "long");
+
+  // Half of the threads append single rows, the others append batches of rows
+  constexpr auto THREAD_COUNT = 8;
+  constexpr auto ROWS_PER_THREAD = 5'000;
+  constexpr auto BATCH_SIZE = 100;
+  auto done = std::atomic<bool>{false};
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_index = 0; thread_index < THREAD_COUNT; ++thread_index) {
+    threads.emplace_back([&, thread_index]() {
+      for (auto row = 0; row < ROWS_PER_THREAD; row += BATCH_SIZE) {
+        auto ids = std::vector<int32_t>{};
+        auto double_ids = std::vector<int64_t>{};
+        for (auto id = thread_index * ROWS_PER_THREAD + row; id < thread_index * ROWS_PER_THREAD + row + BATCH_SIZE;
+             ++id) {
+          ids.push_back(id);
+          double_ids.push_back(int64_t{2} * id);
+        }
+        if (thread_index % 2 == 0) {
+          table.append_columns({ids, double_ids});
+        } else {
+          for (auto index = 0; index < BATCH_SIZE; ++index) table.append({ids[index], double_ids[index]});
+        }
+      }
+    });
+  }
+
+  // Readers only see completely written rows
+  auto reader = std::thread{[&]() {
+    while (!done) {
+      const auto chunk_id = ChunkID{table.chunk_count() - 1};
+      const auto& chunk = table.get_chunk(chunk_id);
+      const auto size = chunk.size();
+      const auto ids = std::static_pointer_cast<ValueSegment<int32_t>>(chunk.get_segment(ColumnID{0}))->values();
+      const auto double_ids = std::static_pointer_cast<ValueSegment<int64_t>>(chunk.get_segment(ColumnID{1}))->values();
+      ASSERT_GE(ids.size(), size);
+      ASSERT_GE(double_ids.size(), size);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < size; ++chunk_offset) {
+        ASSERT_EQ(double_ids[chunk_offset], int64_t{2} * ids[chunk_offset]);
+      }
+    }
+  }};
+
+  for (auto& thread : threads) thread.join();
+  done = true;
+  reader.join();
+
+  EXPECT_EQ(table.row_count(), THREAD_COUNT * ROWS_PER_THREAD);
+  EXPECT_EQ(table.chunk_count(), THREAD_COUNT * ROWS_PER_THREAD / 1'000);
+  auto seen = std::vector<bool>(THREAD_COUNT * ROWS_PER_THREAD);
+  for (auto chunk_id = ChunkID{0}; chunk_id < table.chunk_count(); ++chunk_id) {
+    const auto& chunk = table.get_chunk(chunk_id);
+    EXPECT_EQ(chunk.size(), 1'000u);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+      const auto id = type_cast<int32_t>((*chunk.get_segment(ColumnID{0}))[chunk_offset]);
+      EXPECT_FALSE(seen[id]);
+      seen[id] = true;
+      EXPECT_EQ((*chunk.get_segment(ColumnID{1}))[chunk_offset], AllTypeVariant{int64_t{2} * id});
+    }
+  }
+}
 
 }  // namespace opossum
@@ -0,0 +1,281 @@
+#include <algorithm>
+#include <array>
+#include <filesystem>
+#include <fstream>
+#include <latch>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/write_ahead_log.hpp"
+#include "type_cast.hpp"
+
+namespace opossum {
+
+class StorageWriteAheadLogTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    std::filesystem::remove_all(_directory);
+    StorageManager::get().enable_durability(_directory);
+  }
+
+  void TearDown() override {
+    StorageManager::get().reset();
+    std::filesystem::remove_all(_directory);
+  }
+
+  // Simulates a crash and restart: everything in memory is lost, and the tables are recovered from disk
+  void restart() {
+    StorageManager::get().reset();
+    StorageManager::get().enable_durability(_directory);
+  }
+
+  static std::shared_ptr<Table> create_table() {
+    auto table = std::make_shared<Table>(2);
+    table->add_column("a", "int");
+    table->add_column("b", "string");
+    return table;
+  }
+
+  const std::filesystem::path _directory = std::filesystem::temp_directory_path() / "write_ahead_log_test";
+};
+
+TEST_F(StorageWriteAheadLogTest, RecoversAppends) {
+  auto& storage_manager = StorageManager::get();
+  const auto table = create_table();
+  table->append({1, "one"});
+  storage_manager.add_table("t", table);
+  table->append({2, "two"});
+  table->append(std::array<TypedValue, 2>{TypedValue{3}, TypedValue{"three"}});
+  table->append_columns({std::vector<int32_t>{4, 5}, std::vector<std::string>{"four", "five"}});
+
+  restart();
+
+  const auto expected = create_table();
+  expected->append({1, "one"});
+  expected->append({2, "two"});
+  expected->append({3, "three"});
+  expected->append({4, "four"});
+  expected->append({5, "five"});
+  const auto recovered = StorageManager::get().get_table("t");
+  EXPECT_TABLE_EQ(recovered, expected, true);
+  EXPECT_EQ(recovered->chunk_count(), 3u);
+
+  // The recovered table is logged again
+  recovered->append({6, "six"});
+  restart();
+  EXPECT_EQ(StorageManager::get().get_table("t")->row_count(), 6u);
+}
+
+TEST_F(StorageWriteAheadLogTest, ConvertsRowsBeforeLogging) {
+  auto& storage_manager = StorageManager::get();
+  storage_manager.add_table("t", create_table());
+  const auto table = storage_manager.get_table("t");
+  table->append({"1", 1});
+  EXPECT_THROW(table->append({"abc", "x"}), std::exception);
+  EXPECT_THROW(table->append({2}), std::logic_error);
+  EXPECT_EQ(table->row_count(), 1u);
+
+  // Only the converted row was logged
+  restart();
+  const auto recovered = StorageManager::get().get_table("t");
+  ASSERT_EQ(recovered->row_count(), 1u);
+  EXPECT_EQ((*recovered->get_chunk(ChunkID{0}).get_segment(ColumnID{0}))[0], AllTypeVariant{1});
+  EXPECT_EQ((*recovered->get_chunk(ChunkID{0}).get_segment(ColumnID{1}))[0], AllTypeVariant{"1"});
+}
+
+TEST_F(StorageWriteAheadLogTest, RefusesTablesWithMvcc) {
+  auto& storage_manager = StorageManager::get();
+  const auto table = std::make_shared<Table>(2, UseMvcc::Yes);
+  table->add_column("a", "int");
+  EXPECT_THROW(storage_manager.add_table("t", table), std::logic_error);
+  EXPECT_FALSE(storage_manager.has_table("t"));
+
+  // Nothing was logged for the table
+  restart();
+  EXPECT_FALSE(StorageManager::get().has_table("t"));
+}
+
+TEST_F(StorageWriteAheadLogTest, RecoversDroppedTables) {
+  auto& storage_manager = StorageManager::get();
+  storage_manager.add_table("t", create_table());
+  storage_manager.add_table("u", create_table());
+  storage_manager.drop_table("t");
+  storage_manager.get_table("u")->append({1, "one"});
+
+  restart();
+  EXPECT_EQ(StorageManager::get().table_names(), std::vector<std::string>{"u"});
+  EXPECT_EQ(StorageManager::get().get_table("u")->row_count(), 1u);
+}
+
+TEST_F(StorageWriteAheadLogTest, CheckpointTruncatesLog) {
+  auto& storage_manager = StorageManager::get();
+  storage_manager.add_table("t", create_table());
+  for (auto value = 0; value < 5; ++value) storage_manager.get_table("t")->append({value, std::to_string(value)});
+  storage_manager.get_table("t")->compress_chunk(ChunkID{0});
+  storage_manager.checkpoint();
+  EXPECT_EQ(std::filesystem::file_size(_directory / "wal.log"), 0u);
+
+  storage_manager.get_table("t")->append({5, "5"});
+  restart();
+
+  const auto recovered = StorageManager::get().get_table("t");
+  EXPECT_EQ(recovered->row_count(), 6u);
+  EXPECT_EQ(recovered->get_chunk(ChunkID{2}).size(), 2u);
+  EXPECT_EQ((*recovered->get_chunk(ChunkID{2}).get_segment(ColumnID{1}))[1], AllTypeVariant{"5"});
+}
+
+TEST_F(StorageWriteAheadLogTest, SkipsRecordsInCheckpoint) {
+  auto& storage_manager = StorageManager::get();
+  storage_manager.add_table("t", create_table());
+  storage_manager.get_table("t")->append({1, "one"});
+
+  // A crash after the checkpoint was written, but before the log was truncated
+  const auto log_file = _directory / "wal.log";
+  const auto log_copy = _directory / "wal.copy";
+  std::filesystem::copy_file(log_file, log_copy);
+  storage_manager.checkpoint();
+  std::filesystem::remove(log_file);
+  std::filesystem::rename(log_copy, log_file);
+
+  restart();
+  EXPECT_EQ(StorageManager::get().get_table("t")->row_count(), 1u);
+}
+
+TEST_F(StorageWriteAheadLogTest, DropsTornRecord) {
+  auto& storage_manager = StorageManager::get();
+  storage_manager.add_table("t", create_table());
+  storage_manager.get_table("t")->append({1, "one"});
+  storage_manager.get_table("t")->append({2, "two"});
+
+  // The last record was only partially written when the process crashed
+  const auto log_file = _directory / "wal.log";
+  std::filesystem::resize_file(log_file, std::filesystem::file_size(log_file) - 2);
+  restart();
+  EXPECT_EQ(StorageManager::get().get_table("t")->row_count(), 1u);
+
+  StorageManager::get().get_table("t")->append({3, "three"});
+  restart();
+  EXPECT_EQ(StorageManager::get().get_table("t")->row_count(), 2u);
+  EXPECT_EQ((*StorageManager::get().get_table("t")->get_chunk(ChunkID{0}).get_segment(ColumnID{0}))[1],
+            AllTypeVariant{3});
+}
+
+TEST_F(StorageWriteAheadLogTest, ConcurrentWriters) {
+  constexpr auto THREAD_COUNT = 8;
+  constexpr auto ROWS_PER_THREAD = 50;
+  auto& storage_manager = StorageManager::get();
+  for (auto thread_index = 0; thread_index < THREAD_COUNT; ++thread_index) {
+    storage_manager.add_table("t" + std::to_string(thread_index), create_table());
+  }
+
+  // Each thread appends to its own table
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_index = 0; thread_index < THREAD_COUNT; ++thread_index) {
+    threads.emplace_back([&, thread_index]() {
+      const auto table = storage_manager.get_table("t" + std::to_string(thread_index));
+      for (auto row = 0; row < ROWS_PER_THREAD; ++row) table->append({row, "x"});
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  restart();
+  for (auto thread_index = 0; thread_index < THREAD_COUNT; ++thread_index) {
+    const auto table = StorageManager::get().get_table("t" + std::to_string(thread_index));
+    ASSERT_EQ(table->row_count(), ROWS_PER_THREAD);
+    EXPECT_EQ((*table->get_chunk(ChunkID{ROWS_PER_THREAD / 2 - 1}).get_segment(ColumnID{0}))[1],
+              AllTypeVariant{ROWS_PER_THREAD - 1});
+  }
+}
+
+TEST_F(StorageWriteAheadLogTest, ConcurrentWritersOnOneTable) {
+  constexpr auto THREAD_COUNT = 8;
+  constexpr auto ROWS_PER_THREAD = 50;
+  auto& storage_manager = StorageManager::get();
+  storage_manager.add_table("t", create_table());
+
+  auto start = std::latch{THREAD_COUNT};
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_index = 0; thread_index < THREAD_COUNT; ++thread_index) {
+    threads.emplace_back([&, thread_index]() {
+      const auto table = storage_manager.get_table("t");
+      start.arrive_and_wait();
+      for (auto row = 0; row < ROWS_PER_THREAD; ++row) {
+        table->append({thread_index * ROWS_PER_THREAD + row, std::to_string(thread_index)});
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  // The rows of the threads are interleaved, but each row is recovered as a whole
+  restart();
+  const auto table = StorageManager::get().get_table("t");
+  ASSERT_EQ(table->row_count(), THREAD_COUNT * ROWS_PER_THREAD);
+  auto values = std::vector<int32_t>{};
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto& chunk = table->get_chunk(chunk_id);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset) {
+      const auto value = type_cast<int32_t>((*chunk.get_segment(ColumnID{0}))[chunk_offset]);
+      const auto thread_index = value / ROWS_PER_THREAD;
+      EXPECT_EQ((*chunk.get_segment(ColumnID{1}))[chunk_offset], AllTypeVariant{std::to_string(thread_index)});
+      values.push_back(value);
+    }
+  }
+  std::sort(values.begin(), values.end());
+  for (auto index = 0; index < THREAD_COUNT * ROWS_PER_THREAD; ++index) EXPECT_EQ(values[index], index);
+}
+
+TEST_F(StorageWriteAheadLogTest, DropsTableWhileAppending) {
+  auto& storage_manager = StorageManager::get();
+  storage_manager.add_table("t", create_table());
+  const auto table = storage_manager.get_table("t");
+
+  auto appended = std::latch{1};
+  auto appender = std::thread{[&]() {
+    for (auto row = 0; row < 2'000; ++row) {
+      table->append({row, "a"});
+      if (row == 100) appended.count_down();
+    }
+  }};
+  appended.wait();
+  storage_manager.drop_table("t");
+  appender.join();
+  EXPECT_EQ(table->row_count(), 2'000u);
+
+  restart();
+  EXPECT_FALSE(StorageManager::get().has_table("t"));
+}
+
+TEST_F(StorageWriteAheadLogTest, GroupsCommits) {
+  const auto log_file = (_directory / "group_commit.log").string();
+  auto log = WriteAheadLog{log_file};
+  log.recover(StorageManager::get(), 0);
+
+  constexpr auto THREAD_COUNT = 8;
+  constexpr auto RECORDS_PER_THREAD = 100;
+  // The writers start at once, so that they wait for the same fsyncs
+  auto start = std::latch{THREAD_COUNT};
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_index = 0; thread_index < THREAD_COUNT; ++thread_index) {
+    threads.emplace_back([&]() {
+      start.arrive_and_wait();
+      for (auto record = 0; record < RECORDS_PER_THREAD; ++record) {
+        const auto change = log.begin_change();
+        log.log_append(change, "t", std::vector<AllTypeVariant>{record, "x"});
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  EXPECT_EQ(log.next_lsn(), THREAD_COUNT * RECORDS_PER_THREAD);
+  EXPECT_LT(log.sync_count(), THREAD_COUNT * RECORDS_PER_THREAD);
+  EXPECT_GE(log.sync_count(), 1u);
+}
+
+}  // namespace opossum
@@ -0,0 +1,141 @@
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/fixed_size_attribute_vector.hpp"
+#include "storage/storage_manager.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/binary_table.hpp"
+
+namespace opossum {
+
+class BinaryTableTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _table = std::make_shared<Table>(3);
+    _table->add_column("a", "int");
+    _table->add_column("b", "long");
+    _table->add_column("c", "float");
+    _table->add_column("d", "double");
+    _table->add_column("e", "string");
+    for (auto row = 0; row < 8; ++row) {
+      _table->append({row % 3, int64_t{row} << 40, row * 0.5f, -row * 1.25, std::string(row, 'x')});
+    }
+    _table->compress_chunk(ChunkID{0});
+    _table->compress_chunk(ChunkID{2});
+  }
+
+  void TearDown() override {
+    std::filesystem::remove(_file_name);
+    StorageManager::get().reset();
+  }
+
+  std::shared_ptr<Table> _table;
+  const std::string _file_name = (std::filesystem::temp_directory_path() / "binary_table_test.bin").string();
+};
+
+TEST_F(BinaryTableTest, RoundTrip) {
+  write_binary_table(*_table, _file_name);
+  const auto table = open_binary_table(_file_name);
+
+  EXPECT_TABLE_EQ(table, _table, true);
+  EXPECT_EQ(table->target_chunk_size(), 3u);
+  ASSERT_EQ(table->chunk_count(), 3u);
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<std::string>>(
+      table->get_chunk(ChunkID{0}).get_segment(ColumnID{4})));
+  EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<double>>(table->get_chunk(ChunkID{1}).get_segment(ColumnID{3})));
+  EXPECT_EQ(table->get_chunk(ChunkID{2}).size(), 2u);
+}
+
+TEST_F(BinaryTableTest, MapsAttributeVectors) {
+  write_binary_table(*_table, _file_name);
+  const auto table = open_binary_table(_file_name);
+
+  const auto segment =
+      std::dynamic_pointer_cast<DictionarySegment<int64_t>>(table->get_chunk(ChunkID{2}).get_segment(ColumnID{1}));
+  ASSERT_TRUE(segment);
+  const auto attribute_vector =
+      std::dynamic_pointer_cast<const FixedSizeAttributeVector<uint8_t>>(segment->attribute_vector());
+  ASSERT_TRUE(attribute_vector);
+
+  // The value ids point into the mapping, whose sections are aligned to 8 bytes
+  const auto value_ids = attribute_vector->value_ids();
+  EXPECT_EQ(value_ids.size(), 2u);
+  EXPECT_NE(value_ids.data(), nullptr);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(value_ids.data()) % 8, 0u);
+  EXPECT_EQ((*segment)[1], AllTypeVariant{int64_t{7} << 40});
+
+  // Scans work on the mapped segments
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, 1);
+  scan->execute();
+  EXPECT_EQ(scan->get_output()->row_count(), 3u);
+}
+
+TEST_F(BinaryTableTest, AddsTableToStorageManager) {
+  write_binary_table(*_table, _file_name);
+  const auto table = open_binary_table(_file_name, "mapped");
+  EXPECT_EQ(StorageManager::get().get_table("mapped"), table);
+}
+
+TEST_F(BinaryTableTest, EmptyTable) {
+  auto empty_table = std::make_shared<Table>();
+  empty_table->add_column("a", "string");
+  write_binary_table(*empty_table, _file_name);
+
+  const auto table = open_binary_table(_file_name);
+  EXPECT_EQ(table->row_count(), 0u);
+  EXPECT_EQ(table->column_count(), 1u);
+  EXPECT_EQ(table->column_type(ColumnID{0}), "string");
+}
+
+TEST_F(BinaryTableTest, WritesTableWhileAppending) {
+  auto table = std::make_shared<Table>(10'000);
+  table->add_column("a", "int");
+  table->add_column("b", "string");
+
+  auto done = std::atomic<bool>{false};
+  auto appender = std::thread{[&]() {
+    for (auto row = 0; row < 50'000; ++row) table->append({row, "x"});
+    done = true;
+  }};
+  auto previous_row_count = uint64_t{0};
+  for (auto iteration = 0; iteration < 3 || !done; ++iteration) {
+    write_binary_table(*table, _file_name);
+    const auto written_table = open_binary_table(_file_name);
+    EXPECT_GE(written_table->row_count(), previous_row_count);
+    previous_row_count = written_table->row_count();
+  }
+  appender.join();
+}
+
+TEST_F(BinaryTableTest, RejectsReferenceSegmentsAndCorruptFiles) {
+  auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  table_wrapper->execute();
+  auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpEquals, 1);
+  scan->execute();
+  EXPECT_THROW(write_binary_table(*scan->get_output(), _file_name), std::exception);
+
+  write_binary_table(*_table, _file_name);
+  std::filesystem::resize_file(_file_name, std::filesystem::file_size(_file_name) - 10);
+  EXPECT_THROW(open_binary_table(_file_name), std::exception);
+
+  {
+    auto file = std::ofstream{_file_name, std::ios::binary | std::ios::trunc};
+    file << "not a binary table";
+  }
+  EXPECT_THROW(open_binary_table(_file_name), std::exception);
+}
+
+}  // namespace opossum
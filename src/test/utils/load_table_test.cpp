@@ -0,0 +1,116 @@
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "storage/dictionary_segment.hpp"
+#include "storage/table.hpp"
+#include "type_cast.hpp"
+#include "utils/load_table.hpp"
+
+namespace opossum {
+
+class LoadTableTest : public BaseTest {
+ protected:
+  void TearDown() override { std::filesystem::remove(_file_name); }
+
+  void write_file(const std::string& contents) {
+    auto file = std::ofstream{_file_name, std::ios::binary};
+    file << contents;
+  }
+
+  const std::string _file_name = (std::filesystem::temp_directory_path() / "load_table_test.tbl").string();
+};
+
+TEST_F(LoadTableTest, LoadsTable) {
+  const auto table = load_table("src/test/tables/int_float.tbl", 2);
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", "int");
+  expected->add_column("b", "float");
+  expected->append({12345, 458.7f});
+  expected->append({123, 456.7f});
+  expected->append({1234, 457.7f});
+
+  EXPECT_TABLE_EQ(table, expected, true);
+  EXPECT_EQ(table->chunk_count(), 2u);
+  EXPECT_EQ(table->get_chunk(ChunkID{0}).size(), 2u);
+}
+
+TEST_F(LoadTableTest, CompressesChunks) {
+  const auto table = load_table("src/test/tables/int_float.tbl", 2, true);
+  ASSERT_EQ(table->chunk_count(), 2u);
+  const auto segment = table->get_chunk(ChunkID{1}).get_segment(ColumnID{1});
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<float>>(segment));
+  EXPECT_EQ((*table->get_chunk(ChunkID{1}).get_segment(ColumnID{0}))[0], AllTypeVariant{1234});
+}
+
+TEST_F(LoadTableTest, DelimiterAndLineEndings) {
+  write_file("a,b,c\r\nlong,string,double\r\n1,x,+2.5\r\n\r\n-3,,4\r\n");
+  const auto table = load_table(_file_name, 10, false, ',');
+
+  auto expected = std::make_shared<Table>();
+  expected->add_column("a", "long");
+  expected->add_column("b", "string");
+  expected->add_column("c", "double");
+  expected->append({int64_t{1}, "x", 2.5});
+  expected->append({int64_t{-3}, "", 4.0});
+  EXPECT_TABLE_EQ(table, expected, true);
+}
+
+TEST_F(LoadTableTest, EmptyTable) {
+  write_file("a|b\nint|string\n");
+  const auto table = load_table(_file_name, 10);
+  EXPECT_EQ(table->column_count(), 2u);
+  EXPECT_EQ(table->row_count(), 0u);
+  EXPECT_EQ(table->chunk_count(), 1u);
+}
+
+TEST_F(LoadTableTest, ManyRanges) {
+  // Large enough to be split into several ranges, whose boundaries do not coincide with chunk boundaries
+  const auto row_count = 100'000;
+  auto contents = std::string{"id|name|value\nint|string|float\n"};
+  for (auto row = 0; row < row_count; ++row) {
+    contents += std::to_string(row) + "|name" + std::to_string(row % 13) + "|" + std::to_string(row % 100) + ".5\n";
+  }
+  write_file(contents);
+
+  const auto chunk_size = 999;
+  const auto table = load_table(_file_name, chunk_size);
+  ASSERT_EQ(table->row_count(), row_count);
+  ASSERT_EQ(table->chunk_count(), (row_count + chunk_size - 1) / chunk_size);
+
+  auto row = 0;
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto& chunk = table->get_chunk(chunk_id);
+    if (chunk_id + 1 < table->chunk_count()) {
+      ASSERT_EQ(chunk.size(), chunk_size);
+    }
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk.size(); ++chunk_offset, ++row) {
+      ASSERT_EQ(type_cast<int32_t>((*chunk.get_segment(ColumnID{0}))[chunk_offset]), row);
+      ASSERT_EQ(type_cast<std::string>((*chunk.get_segment(ColumnID{1}))[chunk_offset]),
+                "name" + std::to_string(row % 13));
+      ASSERT_EQ(type_cast<float>((*chunk.get_segment(ColumnID{2}))[chunk_offset]),
+                static_cast<float>(row % 100) + 0.5f);
+    }
+  }
+}
+
+TEST_F(LoadTableTest, RejectsRowsWithWrongFieldCount) {
+  write_file("a|b\nint|string\n1|x\n2\n");
+  EXPECT_THROW(load_table(_file_name, 10), std::logic_error);
+
+  write_file("a|b\nint|string\n1|x\n2|y|z\n");
+  EXPECT_THROW(load_table(_file_name, 10), std::logic_error);
+
+  write_file("a|b\nint|string\n1|x|\n");
+  EXPECT_THROW(load_table(_file_name, 10), std::logic_error);
+}
+
+TEST_F(LoadTableTest, MissingFile) { EXPECT_THROW(load_table("src/test/tables/missing.tbl", 2), std::logic_error); }
+
+}  // namespace opossum
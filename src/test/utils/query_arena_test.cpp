@@ -0,0 +1,96 @@
+#include <atomic>
+#include <memory>
+#include <utility>
+
+#include "../base_test.hpp"
+#include "gtest/gtest.h"
+
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "types.hpp"
+#include "utils/parallel_for.hpp"
+#include "utils/query_arena.hpp"
+
+namespace opossum {
+
+class QueryArenaTest : public BaseTest {};
+
+TEST_F(QueryArenaTest, PosListsUseCurrentResource) {
+  const auto pooled = PosList{RowID{ChunkID{0}, 1}};
+  EXPECT_EQ(pooled.get_allocator().resource(), pos_list_pool());
+
+  auto arena = QueryArena{};
+  {
+    const auto scope = MemoryResourceScope{arena.resource()};
+    EXPECT_EQ(current_memory_resource(), arena.resource());
+
+    auto positions = PosList(100);
+    EXPECT_EQ(positions.get_allocator().resource(), arena.resource());
+    EXPECT_GE(arena.allocated_bytes(), 100 * sizeof(RowID));
+
+    // Copies are allocated from the current resource, moves keep the buffer
+    const auto copy = pooled;
+    EXPECT_EQ(copy.get_allocator().resource(), arena.resource());
+    EXPECT_EQ(copy, pooled);
+    auto moved = std::move(positions);
+    EXPECT_EQ(moved.get_allocator().resource(), arena.resource());
+    EXPECT_EQ(moved.size(), 100u);
+
+    // Worker threads of parallel_for allocate from the arena as well
+    auto arena_task_count = std::atomic<size_t>{0};
+    parallel_for(64, [&](const size_t) {
+      arena_task_count += PosList{}.get_allocator().resource() == arena.resource();
+    });
+    EXPECT_EQ(arena_task_count, 64u);
+  }
+  EXPECT_EQ(current_memory_resource(), pos_list_pool());
+}
+
+TEST_F(QueryArenaTest, OperatorsAllocateFromArena) {
+  auto table = std::make_shared<Table>(5);
+  table->add_column("a", "int");
+  for (auto value = 0; value < 20; ++value) table->append({value});
+  table->compress_chunk(ChunkID{0});
+
+  auto arena = QueryArena{};
+  {
+    const auto scope = MemoryResourceScope{arena.resource()};
+    auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+    auto scan = std::make_shared<TableScan>(table_wrapper, ColumnID{0}, ScanType::OpGreaterThanEquals, 7);
+    scan->execute();
+    auto second_scan = std::make_shared<TableScan>(scan, ColumnID{0}, ScanType::OpLessThan, 12);
+    second_scan->execute();
+
+    const auto output = second_scan->get_output();
+    EXPECT_EQ(output->row_count(), 5u);
+    for (auto chunk_id = ChunkID{0}; chunk_id < output->chunk_count(); ++chunk_id) {
+      const auto segment = output->get_chunk(chunk_id).get_segment(ColumnID{0});
+      const auto& pos_list = *std::dynamic_pointer_cast<ReferenceSegment>(segment)->pos_list();
+      EXPECT_EQ(pos_list.get_allocator().resource(), arena.resource());
+    }
+    EXPECT_GT(arena.used_bytes(), 0u);
+  }
+  // All results were freed
+  EXPECT_GT(arena.allocated_bytes(), 0u);
+  EXPECT_EQ(arena.used_bytes(), 0u);
+}
+
+TEST_F(QueryArenaTest, ResultsCanOutliveArena) {
+  auto arena = std::make_unique<QueryArena>();
+  auto pos_list = std::shared_ptr<PosList>{};
+  {
+    const auto scope = MemoryResourceScope{arena->resource()};
+    pos_list = std::make_shared<PosList>(PosList{RowID{ChunkID{0}, ChunkOffset{1}}});
+  }
+
+  // The memory is released once the result is freed as well
+  arena.reset();
+  pos_list->push_back(RowID{ChunkID{0}, ChunkOffset{2}});
+  EXPECT_EQ(*pos_list, (PosList{RowID{ChunkID{0}, ChunkOffset{1}}, RowID{ChunkID{0}, ChunkOffset{2}}}));
+  pos_list = nullptr;
+}
+
+}  // namespace opossum